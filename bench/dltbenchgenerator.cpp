@@ -0,0 +1,250 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file dltbenchgenerator.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QFile>
+#include <QtDebug>
+
+#include "dltbenchgenerator.h"
+#include "dlt_protocol.h"
+
+/* Flush the output buffer to disk every 1MB */
+#define DLT_BENCH_WRITE_SIZE (1024*1024)
+
+static const char *applications[] = { "NAVI", "HMI", "AUD", "DIAG", "TEL", "SYS", "MEDI", "CONN" };
+static const char *contexts[] = { "MAIN", "ROUT", "GPS", "HEAR", "NET", "STAT", "CTRL", "DB" };
+static const char *texts[] = {
+    "route calculation finished in",
+    "state changed to",
+    "connection error on socket",
+    "heartbeat",
+    "request timeout after",
+    "received frame with length",
+    "database query returned rows:",
+    "speed value",
+};
+
+/* weights for log levels fatal, error, warn, info, debug, verbose */
+static const int levelWeights[] = { 1, 3, 8, 50, 30, 8 };
+
+static void appendUint8(QByteArray &buf, quint8 value)
+{
+    buf.append((char) value);
+}
+
+static void appendUint16Le(QByteArray &buf, quint16 value)
+{
+    buf.append((char) (value & 0xff));
+    buf.append((char) (value >> 8));
+}
+
+static void appendUint32Le(QByteArray &buf, quint32 value)
+{
+    for(int num = 0; num < 4; num++)
+        buf.append((char) ((value >> (8 * num)) & 0xff));
+}
+
+static void appendUint32Be(QByteArray &buf, quint32 value)
+{
+    for(int num = 3; num >= 0; num--)
+        buf.append((char) ((value >> (8 * num)) & 0xff));
+}
+
+static void appendId(QByteArray &buf, const QByteArray &id)
+{
+    QByteArray padded = id.left(4);
+    padded.append(QByteArray(4 - padded.size(), '\0'));
+    buf.append(padded);
+}
+
+DltBenchGenerator::DltBenchGenerator()
+{
+    seed = 1;
+    state = 1;
+    targetSize = 64 * 1024 * 1024;
+    ecuCount = 4;
+    nonVerbosePercent = 30;
+    corruptPermille = 1;
+
+    messageCount = 0;
+    corruptCount = 0;
+    seconds = 0;
+    microseconds = 0;
+    timestamp = 0;
+    counter = 0;
+}
+
+quint32 DltBenchGenerator::random()
+{
+    /* xorshift32, identical sequence on all platforms */
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+bool DltBenchGenerator::generateFile(const QString &filename)
+{
+    QFile file(filename);
+
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Cannot create benchmark trace" << filename << file.errorString();
+        return false;
+    }
+
+    state = seed ? seed : 1;
+    messageCount = 0;
+    corruptCount = 0;
+    seconds = 1600000000;
+    microseconds = 0;
+    timestamp = 0;
+    counter = 0;
+
+    qint64 written = 0;
+    QByteArray buf;
+    buf.reserve(DLT_BENCH_WRITE_SIZE + 2 * 65536);
+
+    while(written + buf.size() < targetSize)
+    {
+        if(corruptPermille > 0 && (int) (random() % 1000) < corruptPermille)
+            appendCorruption(buf);
+        else
+            appendMessage(buf);
+
+        if(buf.size() >= DLT_BENCH_WRITE_SIZE)
+        {
+            if(file.write(buf) != buf.size())
+            {
+                qWarning() << "Write error on benchmark trace" << filename << file.errorString();
+                return false;
+            }
+            written += buf.size();
+            buf.clear();
+        }
+    }
+
+    if(!buf.isEmpty() && file.write(buf) != buf.size())
+    {
+        qWarning() << "Write error on benchmark trace" << filename << file.errorString();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+void DltBenchGenerator::appendMessage(QByteArray &buf)
+{
+    QByteArray ecuid = QString("EC%1").arg(random() % ecuCount, 2, 10, QLatin1Char('0')).toLatin1();
+    int app = random() % (sizeof(applications) / sizeof(applications[0]));
+    int con = random() % (sizeof(contexts) / sizeof(contexts[0]));
+    bool verbose = (int) (random() % 100) >= nonVerbosePercent;
+
+    /* log level distribution, mostly info and debug */
+    int level = 0;
+    int weight = random() % 100;
+    while(level < 5 && weight >= levelWeights[level])
+    {
+        weight -= levelWeights[level];
+        level++;
+    }
+    level += 1; /* DLT_LOG_FATAL is 1 */
+
+    /* advance time between 10us and 2ms */
+    quint32 delta = 10 + random() % 2000;
+    microseconds += delta;
+    seconds += microseconds / 1000000;
+    microseconds %= 1000000;
+    timestamp += delta / 100 + 1;
+
+    /* payload */
+    QByteArray payload;
+    quint8 noar = 0;
+    if(verbose)
+    {
+        int text = random() % (sizeof(texts) / sizeof(texts[0]));
+        QByteArray string = QByteArray(texts[text]);
+        if(random() % 4 == 0)
+            string += " " + QByteArray::number(random() % 100000) + " extra detail for a longer log line";
+        string.append('\0');
+
+        appendUint32Le(payload, DLT_TYPE_INFO_STRG | DLT_SCOD_ASCII);
+        appendUint16Le(payload, string.size());
+        payload.append(string);
+        noar++;
+
+        appendUint32Le(payload, DLT_TYPE_INFO_UINT | DLT_TYLE_32BIT);
+        appendUint32Le(payload, random() % 1000);
+        noar++;
+    }
+    else
+    {
+        /* message id followed by static data */
+        appendUint32Le(payload, 1000 + random() % 500);
+        int length = 4 + random() % 28;
+        for(int num = 0; num < length; num++)
+            appendUint8(payload, random() & 0xff);
+    }
+
+    /* storage header */
+    buf.append("DLT\x01", 4);
+    appendUint32Le(buf, seconds);
+    appendUint32Le(buf, microseconds);
+    appendId(buf, ecuid);
+
+    /* standard header, values in big endian */
+    quint16 length = 4 + 4 + 4 + 4 + 10 + payload.size();
+    appendUint8(buf, DLT_HTYP_UEH | DLT_HTYP_WEID | DLT_HTYP_WSID | DLT_HTYP_WTMS | DLT_HTYP_PROTOCOL_VERSION1);
+    appendUint8(buf, counter++);
+    appendUint8(buf, length >> 8);
+    appendUint8(buf, length & 0xff);
+    appendId(buf, ecuid);
+    appendUint32Be(buf, 100 + app);
+    appendUint32Be(buf, timestamp);
+
+    /* extended header */
+    appendUint8(buf, (verbose ? DLT_MSIN_VERB : 0) | (DLT_TYPE_LOG << DLT_MSIN_MSTP_SHIFT) | (level << DLT_MSIN_MTIN_SHIFT));
+    appendUint8(buf, noar);
+    appendId(buf, QByteArray(applications[app]));
+    appendId(buf, QByteArray(contexts[con]));
+
+    buf.append(payload);
+
+    messageCount++;
+}
+
+void DltBenchGenerator::appendCorruption(QByteArray &buf)
+{
+    if(random() % 2)
+    {
+        /* garbage between messages */
+        int length = 1 + random() % 64;
+        for(int num = 0; num < length; num++)
+            appendUint8(buf, random() & 0xff);
+    }
+    else
+    {
+        /* message truncated in the middle */
+        QByteArray message;
+        appendMessage(message);
+        messageCount--;
+        buf.append(message.left(message.size() / 2));
+    }
+
+    corruptCount++;
+}
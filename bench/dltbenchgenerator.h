@@ -0,0 +1,78 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file dltbenchgenerator.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef DLTBENCHGENERATOR_H
+#define DLTBENCHGENERATOR_H
+
+#include <QString>
+#include <QByteArray>
+
+//! Generator for deterministic synthetic DLT traces.
+/*!
+  The same seed and settings always create the identical file,
+  so results of different builds can be compared.
+*/
+class DltBenchGenerator
+{
+public:
+    DltBenchGenerator();
+
+    void setSeed(quint32 seed) { this->seed = seed; }
+    void setTargetSize(qint64 bytes) { targetSize = bytes; }
+    void setEcuCount(int count) { ecuCount = count > 0 ? count : 1; }
+    void setNonVerbosePercent(int percent) { nonVerbosePercent = percent; }
+    void setCorruptPermille(int permille) { corruptPermille = permille; }
+
+    quint32 getSeed() const { return seed; }
+    int getEcuCount() const { return ecuCount; }
+    int getNonVerbosePercent() const { return nonVerbosePercent; }
+    int getCorruptPermille() const { return corruptPermille; }
+
+    //! Write a trace with storage headers until the target size is reached.
+    /*!
+      \param filename The DLT file to be created
+      \return true if the file was written successfully
+    */
+    bool generateFile(const QString &filename);
+
+    //! Number of valid messages written by the last generateFile() call.
+    qint64 getMessageCount() const { return messageCount; }
+
+    //! Number of corrupt regions written by the last generateFile() call.
+    qint64 getCorruptCount() const { return corruptCount; }
+
+private:
+    quint32 random();
+    void appendMessage(QByteArray &buf);
+    void appendCorruption(QByteArray &buf);
+
+    quint32 seed;
+    quint32 state;
+    qint64 targetSize;
+    int ecuCount;
+    int nonVerbosePercent;
+    int corruptPermille;
+
+    qint64 messageCount;
+    qint64 corruptCount;
+    quint32 seconds;
+    quint32 microseconds;
+    quint32 timestamp;
+    quint8 counter;
+};
+
+#endif // DLTBENCHGENERATOR_H
@@ -0,0 +1,381 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file dltbenchmark.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDir>
+#include <QJsonArray>
+#include <QRegularExpression>
+#include <QtDebug>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "dltbenchmark.h"
+#include "dltfileindexer.h"
+
+/* size of the chunks handed to QDltConnection, similar to a socket read */
+#define DLT_BENCH_INGEST_CHUNK (64*1024)
+
+DltBenchmark::DltBenchmark(const QString &filename, const QString &workDir, int iterations)
+    : filename(filename)
+    , workDir(workDir)
+    , iterations(iterations > 0 ? iterations : 1)
+{
+}
+
+DltBenchmark::~DltBenchmark()
+{
+    file.close();
+}
+
+qint64 DltBenchmark::peakRssKb()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize / 1024;
+    return 0;
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024; /* bytes on macOS */
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+bool DltBenchmark::prepare()
+{
+    if(!file.open(filename))
+        return false;
+
+    DltFileIndexer indexer(&file, &pluginManager, &defaultFilter, 0);
+    indexer.setFilterCacheEnabled(false);
+    if(!indexer.index(0))
+        return false;
+
+    QVector<qint64> indexAll = indexer.getIndexAll();
+    file.setDltIndex(indexAll, 0);
+
+    return true;
+}
+
+void DltBenchmark::addResult(const QString &name, qint64 messages, qint64 bytes, const QList<qint64> &nsecs)
+{
+    Result result;
+    result.name = name;
+    result.messages = messages;
+    result.bytes = bytes;
+    result.iterations = nsecs.size();
+    result.bestNsecs = 0;
+    result.totalNsecs = 0;
+    for(int num = 0; num < nsecs.size(); num++)
+    {
+        if(num == 0 || nsecs[num] < result.bestNsecs)
+            result.bestNsecs = nsecs[num];
+        result.totalNsecs += nsecs[num];
+    }
+    result.peakRssKb = peakRssKb();
+    results.append(result);
+
+    qDebug().noquote() << "Benchmark" << name << "best" << result.bestNsecs / 1000000 << "ms";
+}
+
+void DltBenchmark::runIndex()
+{
+    QList<qint64> nsecs;
+    qint64 messages = 0;
+
+    for(int run = 0; run < iterations; run++)
+    {
+        DltFileIndexer indexer(&file, &pluginManager, &defaultFilter, 0);
+        indexer.setFilterCacheEnabled(false);
+
+        QElapsedTimer timer;
+        timer.start();
+        indexer.index(0);
+        nsecs.append(timer.nsecsElapsed());
+
+        messages = indexer.getIndexAll().size();
+    }
+
+    addResult("index", messages, file.fileSize(), nsecs);
+}
+
+void DltBenchmark::runIndexFilter(const QString &name, QDltFilterList &filterList)
+{
+    QList<qint64> nsecs;
+    qint64 matched = 0;
+
+    file.setFilterList(filterList);
+    file.enableFilter(true);
+
+    for(int run = 0; run < iterations; run++)
+    {
+        DltFileIndexer indexer(&file, &pluginManager, &defaultFilter, 0);
+        indexer.setFilterCacheEnabled(false);
+        indexer.setMode(DltFileIndexer::modeFilter);
+
+        QElapsedTimer timer;
+        timer.start();
+        indexer.indexFilter(QStringList(filename));
+        nsecs.append(timer.nsecsElapsed());
+
+        matched = indexer.getIndexFilters().size();
+    }
+
+    file.enableFilter(false);
+
+    qDebug().noquote() << "Benchmark" << name << "matched" << matched << "messages";
+    addResult(name, file.size(), file.fileSize(), nsecs);
+}
+
+void DltBenchmark::runSearch(const QString &name, const QString &text, bool regExp)
+{
+    QList<qint64> nsecs;
+    qint64 hits = 0;
+    QRegularExpression searchTextRegExp(text, QRegularExpression::CaseInsensitiveOption);
+
+    for(int run = 0; run < iterations; run++)
+    {
+        QDltMsg msg;
+        QByteArray buf;
+        QString headerText;
+        QString payloadText;
+
+        hits = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        /* same steps as SearchDialog::findMessages for each message */
+        for(int searchLine = 0; searchLine < file.size(); searchLine++)
+        {
+            buf = file.getMsg(searchLine);
+            msg.setMsg(buf);
+            pluginManager.decodeMsg(msg, 1);
+
+            headerText = msg.toStringHeader();
+            headerText += " " + QString().sprintf("0x%x", msg.getMessageId());
+            payloadText = msg.toStringPayload();
+
+            if(regExp)
+            {
+                if(searchTextRegExp.match(headerText).hasMatch() || searchTextRegExp.match(payloadText).hasMatch())
+                    hits++;
+            }
+            else
+            {
+                if(headerText.contains(text, Qt::CaseInsensitive) || payloadText.contains(text, Qt::CaseInsensitive))
+                    hits++;
+            }
+        }
+
+        nsecs.append(timer.nsecsElapsed());
+    }
+
+    qDebug().noquote() << "Benchmark" << name << "found" << hits << "messages";
+    addResult(name, file.size(), file.fileSize(), nsecs);
+}
+
+void DltBenchmark::runExport(const QString &name, DltExporter::DltExportFormat format)
+{
+    QList<qint64> nsecs;
+    QString outputName = QDir(workDir).filePath(QString("dlt-bench-%1.out").arg(name));
+
+    for(int run = 0; run < iterations; run++)
+    {
+        QFile output(outputName);
+        DltExporter exporter;
+
+        QElapsedTimer timer;
+        timer.start();
+        exporter.exportMessages(&file, &output, &pluginManager, format, DltExporter::SelectionAll);
+        nsecs.append(timer.nsecsElapsed());
+
+        QFile::remove(outputName);
+    }
+
+    addResult(name, file.size(), file.fileSize(), nsecs);
+}
+
+void DltBenchmark::runIngest(const QString &name, bool serialHeader, bool lineErrors)
+{
+    QList<qint64> nsecs;
+    qint64 received = 0;
+
+    /* build the network stream, messages without storage header */
+    QByteArray stream;
+    stream.reserve(file.fileSize());
+    for(int num = 0; num < file.size(); num++)
+    {
+        QByteArray buf = file.getMsg(num);
+        if(buf.size() <= 16)
+            continue;
+        /* garbage in front of every 16th message, like a serial link with bit errors */
+        if(lineErrors && (num % 16) == 0)
+            stream.append(QByteArray(64, 'D'));
+        if(serialHeader)
+            stream.append("DLS\x01", 4);
+        stream.append(buf.constData() + 16, buf.size() - 16);
+    }
+
+    for(int run = 0; run < iterations; run++)
+    {
+        QDltConnection connection;
+        QDltMsg msg;
+
+        connection.setSyncSerialHeader(serialHeader);
+        received = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        /* same loop as MainWindow::read */
+        for(int pos = 0; pos < stream.size(); pos += DLT_BENCH_INGEST_CHUNK)
+        {
+            connection.add(QByteArray::fromRawData(stream.constData() + pos, qMin(DLT_BENCH_INGEST_CHUNK, stream.size() - pos)));
+            while(connection.parseDlt(msg))
+                received++;
+        }
+
+        nsecs.append(timer.nsecsElapsed());
+    }
+
+    qDebug().noquote() << "Benchmark" << name << "received" << received << "messages";
+    addResult(name, received, stream.size(), nsecs);
+}
+
+void DltBenchmark::createTypicalFilters(QDltFilterList &filterList)
+{
+    QDltFilter *filter;
+
+    filterList.clearFilter();
+
+    filter = new QDltFilter();
+    filter->name = "Navigation routing";
+    filter->enableFilter = true;
+    filter->enableApid = true;
+    filter->apid = "NAVI";
+    filter->enableCtid = true;
+    filter->ctid = "ROUT";
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->name = "Diagnosis";
+    filter->enableFilter = true;
+    filter->enableApid = true;
+    filter->apid = "DIAG";
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->name = "Errors";
+    filter->enableFilter = true;
+    filter->enableLogLevelMax = true;
+    filter->logLevelMax = 2;
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->name = "Connection errors";
+    filter->enableFilter = true;
+    filter->enablePayload = true;
+    filter->payload = "connection error";
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->name = "Timeouts";
+    filter->enableFilter = true;
+    filter->enableRegexp_Payload = true;
+    filter->enablePayload = true;
+    filter->payload = "timeout after \\d+";
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->name = "No heartbeat";
+    filter->type = QDltFilter::negative;
+    filter->enableFilter = true;
+    filter->enableCtid = true;
+    filter->ctid = "HEAR";
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->name = "Mark speed";
+    filter->type = QDltFilter::marker;
+    filter->enableFilter = true;
+    filter->enablePayload = true;
+    filter->payload = "speed";
+    filter->filterColour = "#00ff00";
+    filterList.addFilter(filter);
+
+    for(int num = 0; num < filterList.filters.size(); num++)
+        filterList.filters[num]->compileRegexps();
+    filterList.updateSortedFilter();
+}
+
+void DltBenchmark::createPayloadFilters(QDltFilterList &filterList, int count)
+{
+    filterList.clearFilter();
+
+    for(int num = 0; num < count; num++)
+    {
+        QDltFilter *filter = new QDltFilter();
+        filter->name = QString("Payload %1").arg(num);
+        filter->enableFilter = true;
+        filter->enablePayload = true;
+        filter->payload = QString("pattern %1 not found").arg(num);
+        filter->compileRegexps();
+        filterList.addFilter(filter);
+    }
+
+    filterList.updateSortedFilter();
+}
+
+QJsonObject DltBenchmark::toJson() const
+{
+    QJsonArray array;
+
+    for(int num = 0; num < results.size(); num++)
+    {
+        const Result &result = results[num];
+        QJsonObject object;
+        double seconds = result.bestNsecs / 1e9;
+
+        object["name"] = result.name;
+        object["messages"] = result.messages;
+        object["bytes"] = result.bytes;
+        object["iterations"] = result.iterations;
+        object["bestMsecs"] = result.bestNsecs / 1e6;
+        object["meanMsecs"] = result.iterations ? result.totalNsecs / 1e6 / result.iterations : 0.0;
+        object["msgsPerSec"] = seconds > 0 ? result.messages / seconds : 0.0;
+        object["mbPerSec"] = seconds > 0 ? result.bytes / (1024.0 * 1024.0) / seconds : 0.0;
+        object["peakRssKb"] = result.peakRssKb;
+        array.append(object);
+    }
+
+    QJsonObject object;
+    object["results"] = array;
+    object["peakRssKb"] = peakRssKb();
+    return object;
+}
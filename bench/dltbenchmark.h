@@ -0,0 +1,84 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file dltbenchmark.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef DLTBENCHMARK_H
+#define DLTBENCHMARK_H
+
+#include <QString>
+#include <QStringList>
+#include <QList>
+#include <QJsonObject>
+
+#include "qdlt.h"
+#include "dltexporter.h"
+
+//! Runs the viewer processing stages against one trace file and records throughput.
+class DltBenchmark
+{
+public:
+    struct Result
+    {
+        QString name;
+        qint64 messages;
+        qint64 bytes;
+        int iterations;
+        qint64 bestNsecs;
+        qint64 totalNsecs;
+        qint64 peakRssKb;
+    };
+
+    DltBenchmark(const QString &filename, const QString &workDir, int iterations);
+    ~DltBenchmark();
+
+    //! Open the trace and create the index used by all other benchmarks.
+    bool prepare();
+
+    void runIndex();
+    void runIndexFilter(const QString &name, QDltFilterList &filterList);
+    void runSearch(const QString &name, const QString &text, bool regExp);
+    void runExport(const QString &name, DltExporter::DltExportFormat format);
+    void runIngest(const QString &name, bool serialHeader, bool lineErrors = false);
+
+    //! Filter list similar to the filter sets used for analysis.
+    static void createTypicalFilters(QDltFilterList &filterList);
+
+    //! Many plain payload filters, the cost should not grow with the number of filters.
+    static void createPayloadFilters(QDltFilterList &filterList, int count);
+
+    //! Peak resident set size of the process in kBytes.
+    static qint64 peakRssKb();
+
+    QJsonObject toJson() const;
+
+    qint64 getMessageCount() const { return file.size(); }
+    qint64 getFileSize() const { return file.fileSize(); }
+
+private:
+    void addResult(const QString &name, qint64 messages, qint64 bytes, const QList<qint64> &nsecs);
+
+    QString filename;
+    QString workDir;
+    int iterations;
+
+    QDltFile file;
+    QDltPluginManager pluginManager;
+    QDltDefaultFilter defaultFilter;
+
+    QList<Result> results;
+};
+
+#endif // DLTBENCHMARK_H
@@ -0,0 +1,197 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file main.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QTemporaryDir>
+#include <QJsonDocument>
+#include <QFile>
+#include <QDir>
+#include <QtDebug>
+
+#include <iostream>
+
+#include "dltbenchgenerator.h"
+#include "dltbenchmark.h"
+
+static bool verboseOutput = false;
+
+static void messageHandler(QtMsgType type, const QMessageLogContext &context, const QString &msg)
+{
+    Q_UNUSED(context);
+
+    /* keep stdout clean for the JSON report */
+    if(verboseOutput || type == QtWarningMsg || type == QtCriticalMsg || type == QtFatalMsg)
+        std::cerr << msg.toLocal8Bit().constData() << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    /* the exporter creates progress dialogs, no display is needed for them */
+    if(qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication a(argc, argv);
+    a.setApplicationName("dlt-bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Throughput benchmark for indexing, filtering, searching, exporting and ingesting DLT traces.");
+    parser.addHelpOption();
+
+    QCommandLineOption sizeOption("size", "Size of the generated trace in MBytes (default 64).", "mb", "64");
+    QCommandLineOption ecusOption("ecus", "Number of ECUs in the generated trace (default 4).", "count", "4");
+    QCommandLineOption nonVerboseOption("nonverbose", "Percentage of non verbose messages (default 30).", "percent", "30");
+    QCommandLineOption corruptOption("corrupt", "Corrupt regions per thousand messages (default 1).", "permille", "1");
+    QCommandLineOption seedOption("seed", "Seed of the trace generator (default 1).", "seed", "1");
+    QCommandLineOption repeatOption("repeat", "Iterations of each benchmark, the best run is reported (default 3).", "count", "3");
+    QCommandLineOption traceOption("trace", "Use an existing DLT file instead of generating one.", "file");
+    QCommandLineOption keepOption("keep", "Keep the generated trace in the given directory.", "dir");
+    QCommandLineOption outputOption("output", "Write the JSON report to a file instead of stdout.", "file");
+    QCommandLineOption benchmarksOption("benchmarks", "Comma separated list of index,filter,search,export,ingest (default all).", "list", "index,filter,search,export,ingest");
+    QCommandLineOption verboseOption("verbose", "Print debug output of the viewer components.");
+
+    parser.addOption(sizeOption);
+    parser.addOption(ecusOption);
+    parser.addOption(nonVerboseOption);
+    parser.addOption(corruptOption);
+    parser.addOption(seedOption);
+    parser.addOption(repeatOption);
+    parser.addOption(traceOption);
+    parser.addOption(keepOption);
+    parser.addOption(outputOption);
+    parser.addOption(benchmarksOption);
+    parser.addOption(verboseOption);
+    parser.process(a);
+
+    verboseOutput = parser.isSet(verboseOption);
+    qInstallMessageHandler(messageHandler);
+
+    /* indexer and exporter must not show any dialogs */
+    QStringList options;
+    options << "dlt-bench" << "-s";
+    QDltOptManager::getInstance()->parse(&options);
+
+    QTemporaryDir tempDir;
+    if(!tempDir.isValid())
+    {
+        qCritical() << "Cannot create temporary directory";
+        return 1;
+    }
+
+    QJsonObject trace;
+    QString filename;
+
+    if(parser.isSet(traceOption))
+    {
+        filename = parser.value(traceOption);
+        trace["file"] = filename;
+    }
+    else
+    {
+        DltBenchGenerator generator;
+        generator.setTargetSize(parser.value(sizeOption).toLongLong() * 1024 * 1024);
+        generator.setEcuCount(parser.value(ecusOption).toInt());
+        generator.setNonVerbosePercent(parser.value(nonVerboseOption).toInt());
+        generator.setCorruptPermille(parser.value(corruptOption).toInt());
+        generator.setSeed(parser.value(seedOption).toUInt());
+
+        QString dir = parser.isSet(keepOption) ? parser.value(keepOption) : tempDir.path();
+        filename = QDir(dir).filePath(QString("dlt-bench-seed%1.dlt").arg(generator.getSeed()));
+
+        qDebug() << "Generating trace" << filename;
+        if(!generator.generateFile(filename))
+            return 1;
+
+        trace["file"] = filename;
+        trace["seed"] = (qint64) generator.getSeed();
+        trace["ecus"] = generator.getEcuCount();
+        trace["nonVerbosePercent"] = generator.getNonVerbosePercent();
+        trace["corruptPermille"] = generator.getCorruptPermille();
+        trace["generatedMessages"] = generator.getMessageCount();
+        trace["corruptRegions"] = generator.getCorruptCount();
+    }
+
+    DltBenchmark benchmark(filename, tempDir.path(), parser.value(repeatOption).toInt());
+    if(!benchmark.prepare())
+    {
+        qCritical() << "Cannot open trace" << filename;
+        return 1;
+    }
+
+    trace["messages"] = benchmark.getMessageCount();
+    trace["bytes"] = benchmark.getFileSize();
+
+    QStringList benchmarks = parser.value(benchmarksOption).split(',', QString::SkipEmptyParts);
+
+    if(benchmarks.contains("index"))
+    {
+        benchmark.runIndex();
+    }
+    if(benchmarks.contains("filter"))
+    {
+        QDltFilterList filterList;
+
+        DltBenchmark::createTypicalFilters(filterList);
+        benchmark.runIndexFilter("filter_typical", filterList);
+
+        DltBenchmark::createPayloadFilters(filterList, 50);
+        benchmark.runIndexFilter("filter_payload50", filterList);
+    }
+    if(benchmarks.contains("search"))
+    {
+        benchmark.runSearch("search_text", "connection error", false);
+        benchmark.runSearch("search_regexp", "timeout after \\d+", true);
+    }
+    if(benchmarks.contains("export"))
+    {
+        benchmark.runExport("export_dlt", DltExporter::FormatDlt);
+        benchmark.runExport("export_ascii", DltExporter::FormatAscii);
+        benchmark.runExport("export_csv", DltExporter::FormatCsv);
+        benchmark.runExport("export_utf8", DltExporter::FormatUTF8);
+        benchmark.runExport("export_dlt_decoded", DltExporter::FormatDltDecoded);
+        benchmark.runExport("export_columnar", DltExporter::FormatColumnar);
+    }
+    if(benchmarks.contains("ingest"))
+    {
+        benchmark.runIngest("ingest", false);
+        benchmark.runIngest("ingest_serial", true);
+        benchmark.runIngest("ingest_serial_errors", true, true);
+    }
+
+    QJsonObject report = benchmark.toJson();
+    report["tool"] = QString("dlt-bench");
+    report["qtVersion"] = QString(qVersion());
+    report["trace"] = trace;
+
+    QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    if(parser.isSet(outputOption))
+    {
+        QFile output(parser.value(outputOption));
+        if(!output.open(QIODevice::WriteOnly | QIODevice::Truncate) || output.write(json) != json.size())
+        {
+            qCritical() << "Cannot write report" << output.fileName();
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json.constData();
+    }
+
+    return 0;
+}
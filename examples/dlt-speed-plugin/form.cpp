@@ -84,6 +84,29 @@ void Form::setSpeedGraph(QDltArgument currentSpeed,unsigned int time)
 
 }
 
+void Form::setSpeedSeries(const QDltSignalSeries &series)
+{
+    // Replace the data for speed and time
+    speedX = series.getValues();
+    timeY.clear();
+    timeY.reserve(series.size());
+    for(int num = 0; num < series.size(); num++)
+        timeY.push_back((double)series.getTimestamps()[num]);
+
+    dataArray = new QwtPointArrayData(timeY,speedX);
+    curve1->setData(dataArray);
+
+    if(!speedX.isEmpty())
+    {
+        ui->lcdNumber->display(speedX.last());
+        ui->thermo->setValue(speedX.last());
+        curve1->setPen(QPen(speedX.last() < 80 ? Qt::green : Qt::red, 1));
+    }
+
+    // Replot curve
+    ui->qwtPlot->replot();
+}
+
 void Form::setSpeedLCD(QDltArgument currentSpeed,unsigned int time)
 {
     // Set currentSpeed to lcdNumber
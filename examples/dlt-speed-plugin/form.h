@@ -43,6 +43,7 @@ public:
 
     void setSpeedLCD(QDltArgument currentSpeed,unsigned int time);
     void setSpeedGraph(QDltArgument currentSpeed,unsigned int time);
+    void setSpeedSeries(const QDltSignalSeries &series);
 
 private:
     Ui::Form *ui;
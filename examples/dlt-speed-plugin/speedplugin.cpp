@@ -32,6 +32,8 @@ SpeedPlugin::SpeedPlugin()
     //qDebug() << "SpeedPlugin::SpeedPlugin" << __LINE__ << __FILE__;
     form = NULL;
     dltFile = NULL;
+    signalExtractor = NULL;
+    speedRequest = 0;
     msgIndex = 0;
 }
 
@@ -182,6 +184,16 @@ void SpeedPlugin::initFileFinish()
         return;
     }
 
+    /* the viewer extracts the speed from all messages at once */
+    if(signalExtractor)
+    {
+        QList<QDltSignalSpec> specs;
+        specs << QDltSignalSpec(QString(), "SPEE", "SIG", "1");
+        speedRequest = signalExtractor->requestSeries(specs);
+        msgIndex = dltFile->size();
+        return;
+    }
+
 QByteArray buffer;
 QDltMsg msg;
 QDltArgument argument;
@@ -306,6 +318,25 @@ void SpeedPlugin::configurationChanged()
 
 }
 
+/* QDltPluginSignalInterface */
+void SpeedPlugin::initSignalExtractor(QDltSignalExtractor *extractor)
+{
+    signalExtractor = extractor;
+
+    /* the series are extracted in the background */
+    connect(signalExtractor, SIGNAL(seriesFinished(int,QList<QDltSignalSeries>)),
+            this, SLOT(speedSeriesFinished(int,QList<QDltSignalSeries>)));
+}
+
+void SpeedPlugin::speedSeriesFinished(int request, const QList<QDltSignalSeries> &series)
+{
+    /* only the last request of this plugin is shown */
+    if(request != speedRequest || series.isEmpty() || !form)
+        return;
+
+    form->setSpeedSeries(series.first());
+}
+
 #ifndef QT5
 Q_EXPORT_PLUGIN2(speedplugin, SpeedPlugin);
 #endif
@@ -29,12 +29,14 @@
 class SpeedPlugin : public QObject,
                            QDLTPluginInterface,
                            QDltPluginViewerInterface,
-                           QDltPluginControlInterface
+                           QDltPluginControlInterface,
+                           QDltPluginSignalInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
     Q_INTERFACES(QDltPluginControlInterface)
+    Q_INTERFACES(QDltPluginSignalInterface)
 #ifdef QT5
     Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyViewerPlugin")
 #endif
@@ -85,8 +87,16 @@ public:
     bool stateChanged(int index, QDltConnection::QDltConnectionState connectionState, QString hostname);
     bool autoscrollStateChanged(bool enabled);
 
+    /* QDltPluginSignalInterface */
+    void initSignalExtractor(QDltSignalExtractor *extractor);
+
+private slots:
+    void speedSeriesFinished(int request, const QList<QDltSignalSeries> &series);
+
 private:
     QDltControl *dltControl;
+    QDltSignalExtractor *signalExtractor;
+    int speedRequest;
     QDltFile *dltFile;
     QString errorText;
     int msgIndex;
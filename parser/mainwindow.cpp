@@ -406,7 +406,32 @@ bool MainWindow::parseDirectory(QString dirName, parseType type,bool convert,boo
     filter.append(QString("*.cpp"));
     filter.append(QString("*.cxx"));
 
-    /* parse files in current directory */
+    if(!convert)
+    {
+        /* the whole tree is scanned in parallel, in blocks to update the progress bar */
+        QStringList fileNames;
+        collectSourceFiles(dirName,filter,fileNames);
+        if(progressBarVisible)
+            progress.setMaximum(progress.maximum()+fileNames.size());
+
+        for(int i = 0;i<fileNames.size();i+=PARSER_FILES_BLOCK)
+        {
+            int count = qMin(PARSER_FILES_BLOCK,fileNames.size()-i);
+            if(!parser.parseFiles(fileNames.mid(i,count)))
+                return false;
+
+            /* increase progress bar */
+            if(progressBarVisible)
+            {
+                progress.setValue(progress.value()+count);
+                progress.setLabelText(fileNames.at(i+count-1));
+            }
+        }
+
+        return true;
+    }
+
+    /* converte files in current directory */
     list = dir.entryInfoList(filter,QDir::Files);
     if(progressBarVisible)
         progress.setMaximum(progress.maximum()+list.size());
@@ -417,16 +442,9 @@ bool MainWindow::parseDirectory(QString dirName, parseType type,bool convert,boo
         if(progressBarVisible)
             progress.setValue(progress.value()+1);
 
-        if(convert)
-        {
-            if(!parser.converteFile(list.at(i).absoluteFilePath()))
-                return false;
-        }
-        else
-        {
-            if(!parser.parseFile(list.at(i).absoluteFilePath()))
-                return false;
-        }
+        if(!parser.converteFile(list.at(i).absoluteFilePath()))
+            return false;
+
         if(progressBarVisible)
             progress.setLabelText(list.at(i).absoluteFilePath());
     }
@@ -443,6 +461,20 @@ bool MainWindow::parseDirectory(QString dirName, parseType type,bool convert,boo
 }
 
 
+void MainWindow::collectSourceFiles(QString dirName,const QStringList &filter,QStringList &fileNames)
+{
+    QDir dir(dirName);
+
+    /* files in current directory first, then the subdirectories, like parseDirectory() */
+    QFileInfoList list = dir.entryInfoList(filter,QDir::Files);
+    for(int i = 0;i<list.size();i++)
+        fileNames.append(list.at(i).absoluteFilePath());
+
+    list = dir.entryInfoList(QDir::Dirs|QDir::NoDotAndDotDot);
+    for(int i = 0;i<list.size();i++)
+        collectSourceFiles(list.at(i).absoluteFilePath(),filter,fileNames);
+}
+
 void MainWindow::on_actionInfo_triggered()
 {
 
@@ -30,6 +30,9 @@
 
 #include "qdltparser.h"
 
+/* number of files scanned in parallel between two progress updates */
+#define PARSER_FILES_BLOCK 256
+
 extern const char* commandLineOptions;
 
 class DltCon
@@ -103,6 +106,7 @@ public:
     QStringList parseLine(QFile &file,QString &line,int &linecounter);
 
     bool parseDirectory(QString dirName, parseType type, bool convert, bool create, QProgressDialog &progress);
+    void collectSourceFiles(QString dirName, const QStringList &filter, QStringList &fileNames);
 
     void updateTree();
     void updateTreeApplications();
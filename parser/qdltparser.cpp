@@ -28,9 +28,17 @@
 #include <QXmlStreamWriter>
 #include <QXmlStreamReader>
 #include <QCryptographicHash>
+#include <QByteArrayMatcher>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QVector>
+
+#include <climits>
+#include <cstring>
 
 QDltParser::QDltParser()
 {
+    scanItems = 0;
     clear();
 }
 
@@ -42,7 +50,98 @@ void QDltParser::clear()
     messageIds.clear();
 }
 
+/* scans one file of parseFiles() in the thread pool */
+class QDltParserScanTask : public QRunnable
+{
+public:
+    QDltParserScanTask(const QString &fileName, QList<QDltParserItem> *items, QString *error, bool *ok)
+        : fileName(fileName), items(items), error(error), ok(ok) { }
+
+    void run()
+    {
+        *ok = QDltParser::scanFile(fileName, *items, *error);
+    }
+
+private:
+    QString fileName;
+    QList<QDltParserItem> *items;
+    QString *error;
+    bool *ok;
+};
+
+QByteArray QDltParserSource::readLine()
+{
+    if(file)
+        return file->readLine();
+
+    if(position >= data.size())
+        return QByteArray();
+
+    const char *begin = data.constData() + position;
+    const char *end = (const char*) memchr(begin, '\n', data.size() - position);
+    int length = end ? (int) (end - begin) + 1 : data.size() - position;
+    position += length;
+
+    return QByteArray::fromRawData(begin, length);
+}
+
 bool QDltParser::parseFile(QString fileName)
+{
+    return parseFiles(QStringList(fileName));
+}
+
+bool QDltParser::parseFiles(const QStringList &fileNames)
+{
+    QVector<QList<QDltParserItem> > items(fileNames.size());
+    QVector<QString> errors(fileNames.size());
+    QVector<bool> results(fileNames.size());
+
+    /* scan the files in parallel, every file has its own result */
+    QThreadPool pool;
+    for(int num = 0; num < fileNames.size(); num++)
+        pool.start(new QDltParserScanTask(fileNames[num], &items[num], &errors[num], &results[num]));
+    pool.waitForDone();
+
+    /* add the results in the order of the files, like parsing them one after the other,
+       declarations behind the first error are dropped */
+    bool ok = true;
+    for(int num = 0; num < fileNames.size(); num++)
+    {
+        const QList<QDltParserItem> &list = items[num];
+        for(int i = 0; i < list.size(); i++)
+        {
+            if(ok)
+            {
+                addItem(list[i]);
+            }
+            else
+            {
+                delete list[i].con;
+                delete list[i].frame;
+            }
+        }
+        if(ok && !results[num])
+        {
+            errorString = errors[num];
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+bool QDltParser::scanFile(const QString &fileName, QList<QDltParserItem> &items, QString &error)
+{
+    QDltParser parser;
+    parser.scanItems = &items;
+
+    bool ok = parser.scanSource(fileName);
+    error = parser.errorString;
+
+    return ok;
+}
+
+bool QDltParser::scanSource(const QString &fileName)
 {
     QByteArray data;
     QString text;
@@ -58,12 +157,37 @@ bool QDltParser::parseFile(QString fileName)
         return false;
     }
 
-    // run through whole file
-    while(file.bytesAvailable())
+    // map the file, read it when it cannot be mapped
+    uchar *mapped = 0;
+    if(file.size() > 0 && file.size() <= INT_MAX)
+        mapped = file.map(0, file.size());
+    if(mapped)
+        data = QByteArray::fromRawData((const char*) mapped, (int) file.size());
+    else
+        data = file.readAll();
+
+    // all keywords start with DLT_, so only lines containing it are converted and checked
+    QByteArrayMatcher keyword("DLT_");
+    QDltParserSource source(data, fileName);
+    int pos;
+    while((pos = keyword.indexIn(data, source.pos())) >= 0)
     {
-        data = file.readLine();
+        // skip to the beginning of the line, counting the lines in between
+        int begin = pos;
+        while(begin > source.pos() && data.at(begin - 1) != '\n')
+            begin--;
+        const char *next = data.constData() + source.pos();
+        const char *end = data.constData() + begin;
+        while((next = (const char*) memchr(next, '\n', end - next)) != 0)
+        {
+            linecounter++;
+            next++;
+        }
+
+        source.seek(begin);
+        text = QString(source.readLine());
         linecounter++;
-        text = QString(data);
+
         if(text.contains("DLT_REGISTER_APP"))
         {
             qDebug() << "parseFile" << "DLT_REGISTER_APP";
@@ -91,7 +215,7 @@ bool QDltParser::parseFile(QString fileName)
         else if(text.contains("DLT_LOG_ID") || (text.contains("DLT_LOG")))
         {
             QFile empty;
-            if(!parseMessage(file,empty,linecounter,text))
+            if(!parseMessage(source,empty,linecounter,text))
             {
                 return false;
             }
@@ -105,6 +229,39 @@ bool QDltParser::parseFile(QString fileName)
     return true;
 }
 
+void QDltParser::addItem(const QDltParserItem &item)
+{
+    if(scanItems)
+    {
+        scanItems->append(item);
+        return;
+    }
+
+    switch(item.type)
+    {
+    case QDltParserItem::ItemApplication:
+        applications[item.name] = item.description;
+        break;
+    case QDltParserItem::ItemContext:
+        contexts[item.con->context] = item.con;
+        break;
+    case QDltParserItem::ItemMessageId:
+        messageIds[item.name] = item.id;
+        break;
+    case QDltParserItem::ItemMessage:
+        {
+            QDltCon *con = contexts[item.frame->context];
+            if(con)
+            {
+                item.frame->ctid = con->conid;
+                item.frame->appid = con->appid;
+            }
+            messages.append(item.frame);
+        }
+        break;
+    }
+}
+
 bool QDltParser::converteFile(QString fileName)
 {
     QByteArray data;
@@ -133,6 +290,7 @@ bool QDltParser::converteFile(QString fileName)
     }
 
     // run through whole file
+    QDltParserSource source(file);
     while(file.bytesAvailable())
     {
         data = file.readLine();
@@ -140,7 +298,7 @@ bool QDltParser::converteFile(QString fileName)
         text = QString(data);
         if(text.contains("DLT_LOG_ID") || text.contains("DLT_LOG"))
         {
-            if(!parseMessage(file,fileWrite,linecounter,text))
+            if(!parseMessage(source,fileWrite,linecounter,text))
             {
                 return false;
             }
@@ -160,7 +318,7 @@ bool QDltParser::converteFile(QString fileName)
     return true;
 }
 
-bool QDltParser::parseMessage(QFile &file,QFile &fileWrite,int &linecounter,QString text)
+bool QDltParser::parseMessage(QDltParserSource &source,QFile &fileWrite,int &linecounter,QString text)
 {
     bool withid = false;
     QDltFibexFrame *frame = new QDltFibexFrame();
@@ -171,10 +329,10 @@ bool QDltParser::parseMessage(QFile &file,QFile &fileWrite,int &linecounter,QStr
         withid = true;
     }
 
-    frame->filename = file.fileName();
+    frame->filename = source.fileName();
     frame->lineNumber = linecounter;
 
-    list = parseMessageLine(file,text,linecounter);
+    list = parseMessageLine(source,text,linecounter);
 
     if(fileWrite.isOpen() && withid)
     {
@@ -220,7 +378,12 @@ bool QDltParser::parseMessage(QFile &file,QFile &fileWrite,int &linecounter,QStr
 
     // only if not coverting
     if(!fileWrite.isOpen())
-        messages.append(frame);
+    {
+        QDltParserItem item;
+        item.type = QDltParserItem::ItemMessage;
+        item.frame = frame;
+        addItem(item);
+    }
 
     qDebug() << "parseMessage" << frame->filename << frame->lineNumber;
 
@@ -240,7 +403,8 @@ void QDltParser::parseMessageStringList(QDltFibexFrame *frame,QFile &fileWrite,Q
         {
             frame->context = argtext;
 
-            QDltCon *con = contexts[frame->context];
+            /* a scan resolves the context when its items are added */
+            QDltCon *con = scanItems ? 0 : contexts[frame->context];
             if(con)
             {
                 frame->ctid = con->conid;
@@ -393,7 +557,7 @@ void QDltParser::parseMessageParameter(QString argtext,QDltFibexFrame *frame)
     qDebug() << "parseMessageParameter" <<  pdu->typeInfo << pdu->byteLength << pdu->description;
 }
 
-QStringList QDltParser::parseMessageLine(QFile &file,QString &line,int &linecounter)
+QStringList QDltParser::parseMessageLine(QDltParserSource &source,QString &line,int &linecounter)
 {
     QStringList list;
     int level = 0;
@@ -459,7 +623,9 @@ QStringList QDltParser::parseMessageLine(QFile &file,QString &line,int &linecoun
 
         if(level>0)
         {
-            data = file.readLine();
+            if(source.atEnd())
+                break;
+            data = source.readLine();
             linecounter++;
             line += QString(data);
         }
@@ -479,7 +645,11 @@ bool  QDltParser::parseMessageId(QString text)
     {
         if((list[i] == QString("#define")) && (list.size() > (i+2)))
         {
-            messageIds[list[i+1]]=list[i+2].toUInt();
+            QDltParserItem item;
+            item.type = QDltParserItem::ItemMessageId;
+            item.name = list[i+1];
+            item.id = list[i+2].toUInt();
+            addItem(item);
 
             qDebug() << "parseMessageId" << list[i+1] << list[i+2];
 
@@ -542,7 +712,11 @@ bool QDltParser::parseContextsRegisterApp(QString text)
 
     qDebug() << "parseContextsRegisterApp" << appid << appdesc;
 
-    applications[appid] = appdesc;
+    QDltParserItem item;
+    item.type = QDltParserItem::ItemApplication;
+    item.name = appid;
+    item.description = appdesc;
+    addItem(item);
 
     return true;
 }
@@ -618,7 +792,10 @@ bool QDltParser::parseContextsRegisterContext(QString text)
 
     qDebug() << "parseContextsRegisterContext" << con->context << con->appid << con->conid << con->description;
 
-    contexts[con->context] = con;
+    QDltParserItem item;
+    item.type = QDltParserItem::ItemContext;
+    item.con = con;
+    addItem(item);
 
     return true;
 }
@@ -30,6 +30,8 @@
 
 #include <QMap>
 #include <QFile>
+#include <QList>
+#include <QStringList>
 
 typedef int pid_t;
 typedef unsigned int speed_t;
@@ -92,6 +94,48 @@ public:
        uint32_t pduRefCounter;
 };
 
+/**
+* Lines of a source file, read from an open file or from the mapped file content.
+*/
+class QDltParserSource
+{
+public:
+    QDltParserSource(QFile &file) : file(&file), position(0) { }
+    QDltParserSource(const QByteArray &data, const QString &fileName) : file(0), data(data), name(fileName), position(0) { }
+
+    QString fileName() const { return file ? file->fileName() : name; }
+    bool atEnd() const { return file ? !file->bytesAvailable() : position >= data.size(); }
+
+    int pos() const { return position; }
+    void seek(int pos) { position = pos; }
+
+    QByteArray readLine();
+
+private:
+    QFile *file;
+    QByteArray data;
+    QString name;
+    int position;
+};
+
+/**
+* A declaration found while scanning a source file.
+*/
+class QDltParserItem
+{
+public:
+    typedef enum { ItemApplication, ItemContext, ItemMessageId, ItemMessage } ItemType;
+
+    QDltParserItem() { type = ItemApplication; id = 0; con = 0; frame = 0; }
+
+    ItemType type;
+    QString name;
+    QString description;
+    uint32_t id;
+    QDltCon *con;
+    QDltFibexFrame *frame;
+};
+
 class QDltParser
 {
 public:
@@ -100,6 +144,7 @@ public:
     void clear();
 
     bool parseFile(QString fileName);
+    bool parseFiles(const QStringList &fileNames);
     bool parseConfiguration(QString fileName);
     bool parseCheck();
     bool converteFile(QString fileName);
@@ -121,13 +166,19 @@ public:
     bool writeCsv(QString &fileName);
     bool readFibex(QString &fileName);
 
+    /* scan a file without changing a parser, can be called from several threads */
+    static bool scanFile(const QString &fileName, QList<QDltParserItem> &items, QString &error);
+
 private:
 
+    bool scanSource(const QString &fileName);
+    void addItem(const QDltParserItem &item);
+
     bool parseContextsRegisterApp(QString text);
     bool parseContextsRegisterContext(QString text);
     bool parseMessageId(QString text);
-    bool parseMessage(QFile &file, QFile &fileWrite, int &linecounter, QString text);
-    QStringList parseMessageLine(QFile &file, QString &line, int &linecounter);
+    bool parseMessage(QDltParserSource &source, QFile &fileWrite, int &linecounter, QString text);
+    QStringList parseMessageLine(QDltParserSource &source, QString &line, int &linecounter);
     void parseMessageStringList(QDltFibexFrame *frame,QFile &fileWrite,QStringList &list,bool withid);
     void parseMessageParameter(QString argtext,QDltFibexFrame *frame);
 
@@ -137,6 +188,9 @@ private:
     QMap<QString,uint32_t> messageIds;
     QList<QDltFibexFrame*> messages;
 
+    /* items of a scan, the declarations are collected here instead of added to the parser */
+    QList<QDltParserItem> *scanItems;
+
 };
 
 #endif // QDLTPARSER_H
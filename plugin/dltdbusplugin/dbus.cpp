@@ -19,6 +19,9 @@
 
 #include <QDebug>
 #include <QString>
+#include <QHash>
+#include <QMutex>
+#include <QVarLengthArray>
 
 #include "qdlt.h"
 
@@ -29,6 +32,10 @@ const char *dbus_message_type_short[]={"INVALID","C","R","ERROR","S"};
 const char *dbus_field_code[]={"INVALID","PATH","INTERFACE","MEMBER","NAME","REPLY_SERIAL","DESTINATION","SENDER","SIGNATURE","UNIX_FDS"};
 const char *dbus_type_string[]={"INVALID","BYTE","BOOLEAN","INT16","UINT16","INT32","UINT32","INT64","UINT64","DOUBLE","STRING","OBJECT_PATH","SIGNATURE","ARRAY","STRUCT","STRUCT_BEGIN","STRUCT_END","VARIANT","DICT_ENTRY","DICT_ENTRY_BEGIN","DICT_ENTRY_END","UNIX_FD"};
 
+/* compiled decode plans of all decoders, signatures repeat a lot in DBus traffic */
+static QMutex dbusPlanMutex;
+static QHash<QByteArray,QSharedPointer<const DltDBusPlan> > dbusPlanCache;
+
 QString DltDBusParameter::getTypeString()
 {
     if(type<=DBUS_TYPE_MAX)
@@ -276,13 +283,16 @@ bool DltDBusDecoder::decodeHeader(QByteArray &data)
     return true;
 }
 
-int DltDBusDecoder::indexOfCascaded(QByteArray signature,char ch, char cascade, int from)
+int DltDBusDecoder::indexOfCascaded(const QByteArray &signature,char ch, char cascade, int from, int to)
 {
     int level = 1;
 
+    if(to < 0 || to > signature.size())
+        to = signature.size();
+
     // qDebug() << "indexOfCascaded: " << QString(signature.mid(from)) << ch << cascade;
 
-    for(int num=from;num<signature.size();num++)
+    for(int num=from;num<to;num++)
     {
         if(signature[num]==cascade)
         {
@@ -313,182 +323,267 @@ bool DltDBusDecoder::decodePayload()
     return decodePayloadSignature(signature,dataPtr,offset,payload.size());
 }
 
-bool DltDBusDecoder::decodePayloadSignature(QByteArray signature,char *dataPtr,int &offset,int maxSize)
+bool DltDBusDecoder::decodePayloadSignature(const QByteArray &signature,char *dataPtr,int &offset,int maxSize)
 {
-    DltDBusParameter parameter;
-    uint32_t lengthArray,lengthArray2;
-    bool isArray;
+    return runPlan(getPlan(signature),dataPtr,offset,maxSize);
+}
 
-    // qDebug() << "decodePayloadSignature: " << signature.size() << QString(signature);
+QSharedPointer<const DltDBusPlan> DltDBusDecoder::getPlan(const QByteArray &signature)
+{
+    QMutexLocker locker(&dbusPlanMutex);
 
-    // run through the whole signature
-    for(int num=0;num<signature.size();)
-    {
+    QHash<QByteArray,QSharedPointer<const DltDBusPlan> >::const_iterator it = dbusPlanCache.constFind(signature);
+    if(it != dbusPlanCache.constEnd())
+        return it.value();
 
-        if(offset>=payload.size())
-        {
-            error = QString("decodePayloadSignature: Payload length error!");
-            return false;
-        }
+    // broken payloads may contain random signatures, do not let the cache grow without limit
+    if(dbusPlanCache.size() >= DBUS_PLAN_CACHE_MAX)
+        dbusPlanCache.clear();
+
+    DltDBusPlan *plan = new DltDBusPlan();
+    compileSignature(signature,0,signature.size(),*plan);
+    plan->squeeze();
 
-        isArray = false;
+    QSharedPointer<const DltDBusPlan> result(plan);
+    dbusPlanCache.insert(signature,result);
+    return result;
+}
+
+void DltDBusDecoder::compileSignature(const QByteArray &signature, int from, int to, DltDBusPlan &plan)
+{
+    // steps are emitted in the order the signature is interpreted,
+    // a signature error becomes a failing step at the position where it is reached
+    for(int num=from;num<to;)
+    {
+        plan.append(DltDBusOp(DltDBusOp::OpCheckOffset));
+
+        bool isArray = false;
         if(signature[num]==(char)DBUS_TYPE_CHAR_ARRAY)
         {
             // we are in an array
             isArray = true;
-            if(!readUint32(lengthArray,dataPtr,offset,maxSize))
-                return false;
-            if(num >= (signature.size()-1))
+            plan.append(DltDBusOp(DltDBusOp::OpArrayLength));
+            if(num >= (to-1))
             {
-                error = QString("decodePayloadSignature: Array length error!");
-                return false;
+                DltDBusOp op(DltDBusOp::OpFail);
+                op.error = QString("decodePayloadSignature: Array length error!");
+                plan.append(op);
+                return;
             }
             num++;
-            if(num>=signature.size())
-                // end already reached
-                break;
             // check if two dimensional array
             if(signature[num]==(char)DBUS_TYPE_CHAR_ARRAY)
             {
-                // we are in an array
-                int lastOffset = offset;
-                isArray = true;
-                if(!readUint32(lengthArray2,dataPtr,offset,maxSize))
-                    return false;
-                if(num >= (signature.size()-1))
+                plan.append(DltDBusOp(DltDBusOp::OpArrayLength2));
+                if(num >= (to-1))
                 {
-                    error = QString("decodePayloadSignature: Array length error!");
-                    return false;
+                    DltDBusOp op(DltDBusOp::OpFail);
+                    op.error = QString("decodePayloadSignature: Array length error!");
+                    plan.append(op);
+                    return;
                 }
-                //qDebug() << "lengthArray:" << lengthArray << lengthArray2;
-                lengthArray = lengthArray - (offset-lastOffset);
                 num++;
-                if(num>=signature.size())
-                    // end already reached
-                    break;
             }
         }
 
-        // qDebug() << "Type:" << num << lengthArray << signature[num] << offset ;
-
-        if(signature[num]==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN || signature[num]==(char)DBUS_TYPE_CHAR_STRUCT_BEGIN)
+        char ch = signature[num];
+        if(ch==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN || ch==(char)DBUS_TYPE_CHAR_STRUCT_BEGIN)
         {
+            bool isDict = (ch==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN);
+            char chEnd = isDict ? (char)DBUS_TYPE_CHAR_DICT_ENTRY_END : (char)DBUS_TYPE_CHAR_STRUCT_END;
+            int type = isDict ? DBUS_TYPE_DICT_ENTRY : DBUS_TYPE_STRUCT;
+
             // first find end of dictonary
-            int posFoundEnd;
-            if(signature[num]==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN)
-                posFoundEnd=indexOfCascaded(signature,DBUS_TYPE_CHAR_DICT_ENTRY_END,DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN,num+1);
-            else
-                posFoundEnd=indexOfCascaded(signature,DBUS_TYPE_CHAR_STRUCT_END,DBUS_TYPE_CHAR_STRUCT_BEGIN,num+1);
+            int posFoundEnd = indexOfCascaded(signature,chEnd,ch,num+1,to);
             if(posFoundEnd==-1)
             {
-                if(signature[num]==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN)
-                    error = QString("decodePayloadSignature: Dictonary end not found!");
+                DltDBusOp op(DltDBusOp::OpFail);
+                if(isDict)
+                    op.error = QString("decodePayloadSignature: Dictonary end not found!");
                 else
-                    error = QString("decodePayloadSignature: Struct end not found!");
-                return false;
+                    op.error = QString("decodePayloadSignature: Struct end not found!");
+                plan.append(op);
+                return;
             }
-            if(!isArray)
+
+            int loop = -1;
+            if(isArray)
             {
-                // this is no array
-                offset+=padding(offset,8);
-                if(signature[num]==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN)
-                {
-                    parameter.setType(DBUS_TYPE_DICT_ENTRY);
-                    parameter.setValue(QVariant(QString('{')));
-                }
-                else
-                {
-                    parameter.setType(DBUS_TYPE_STRUCT);
-                    parameter.setValue(QVariant(QString('(')));
-                }
-                parameters.append(parameter);
-                if(!decodePayloadSignature(signature.mid(num+1,posFoundEnd-num-1),dataPtr,offset,maxSize))
-                     return false;
-                if(signature[num]==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN)
-                {
-                    parameter.setType(DBUS_TYPE_DICT_ENTRY);
-                    parameter.setValue(QVariant(QString('}')));
-                }
-                else
-                {
-                    parameter.setType(DBUS_TYPE_STRUCT);
-                    parameter.setValue(QVariant(QString(')')));
-                }
-                parameters.append(parameter);
+                plan.append(DltDBusOp(DltDBusOp::OpArrayBegin,0,8));
+                loop = plan.size();
+                plan.append(DltDBusOp(DltDBusOp::OpArrayLoop));
             }
-            else
+            plan.append(DltDBusOp(DltDBusOp::OpAlign,0,8));
+            plan.append(DltDBusOp(DltDBusOp::OpMarker,ch,type));
+            compileSignature(signature,num+1,posFoundEnd,plan);
+            plan.append(DltDBusOp(DltDBusOp::OpMarker,chEnd,type));
+            if(isArray)
             {
-                // this is an array
-                int lastOffset = offset;
-                offset+=padding(offset,8);
-                parameter.setType(DBUS_TYPE_ARRAY);
-                parameter.setValue(QVariant(QString('[')));
-                parameters.append(parameter);
-                while(offset < static_cast<int>(lastOffset+lengthArray))
-                {
-                    offset+=padding(offset,8);
-                    if(signature[num]==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN)
-                    {
-                        parameter.setType(DBUS_TYPE_DICT_ENTRY);
-                        parameter.setValue(QVariant(QString('{')));
-                    }
-                    else
-                    {
-                        parameter.setType(DBUS_TYPE_STRUCT);
-                        parameter.setValue(QVariant(QString('(')));
-                    }
-                    parameters.append(parameter);
-                    if(!decodePayloadSignature(signature.mid(num+1,posFoundEnd-num-1),dataPtr,offset,maxSize))
-                         return false;
-                    if(signature[num]==(char)DBUS_TYPE_CHAR_DICT_ENTRY_BEGIN)
-                    {
-                        parameter.setType(DBUS_TYPE_DICT_ENTRY);
-                        parameter.setValue(QVariant(QString('}')));
-                    }
-                    else
-                    {
-                        parameter.setType(DBUS_TYPE_STRUCT);
-                        parameter.setValue(QVariant(QString(')')));
-                    }
-                    parameters.append(parameter);
-                }
-                parameter.setType(DBUS_TYPE_ARRAY);
-                parameter.setValue(QVariant(QString(']')));
-                parameters.append(parameter);
+                plan.append(DltDBusOp(DltDBusOp::OpArrayNext,0,loop));
+                plan[loop].argument = plan.size();
+                plan.append(DltDBusOp(DltDBusOp::OpArrayEnd));
             }
-            num+=posFoundEnd-num+1;
+
+            num = posFoundEnd+1;
         }
         else
         {
             // this is no structure or dictionary
+            DltDBusOp::OpCode code = (ch==(char)DBUS_TYPE_CHAR_VARIANT) ? DltDBusOp::OpVariant : DltDBusOp::OpValue;
             if(!isArray)
             {
-                // this no array
-                if(!decodePayloadParameter(signature[num],dataPtr,offset,payload.size()))
-                    return false;
+                plan.append(DltDBusOp(code,ch));
             }
             else
             {
-                // this is an array
-                int lastOffset = offset;
-                parameter.setType(DBUS_TYPE_ARRAY);
-                parameter.setValue(QVariant(QString('[')));
-                parameters.append(parameter);
-                while(offset < static_cast<int>(lastOffset+lengthArray))
-                {
-                    if(!decodePayloadParameter(signature[num],dataPtr,offset,payload.size()))
-                        return false;
-                }
-                parameter.setType(DBUS_TYPE_ARRAY);
-                parameter.setValue(QVariant(QString(']')));
-                parameters.append(parameter);
+                plan.append(DltDBusOp(DltDBusOp::OpArrayBegin,0,0));
+                int loop = plan.size();
+                plan.append(DltDBusOp(DltDBusOp::OpArrayLoop));
+                plan.append(DltDBusOp(code,ch));
+                plan.append(DltDBusOp(DltDBusOp::OpArrayNext,0,loop));
+                plan[loop].argument = plan.size();
+                plan.append(DltDBusOp(DltDBusOp::OpArrayEnd));
             }
 
             num++;
         }
     }
-    return true;
+}
+
+bool DltDBusDecoder::runPlan(QSharedPointer<const DltDBusPlan> plan,char *dataPtr,int &offset,int maxSize)
+{
+    struct Frame
+    {
+        QSharedPointer<const DltDBusPlan> plan;
+        int pc;
+    };
+    struct Array
+    {
+        int end;    // offset behind the last element
+        int start;  // offset of the current element
+    };
 
+    QVector<Frame> frames;              // plans of the enclosing variants
+    QVarLengthArray<Array,16> arrays;   // open arrays of all frames
+    DltDBusParameter parameter;
+    uint32_t lengthArray = 0;
+    int pc = 0;
+
+    for(;;)
+    {
+        if(pc >= plan->size())
+        {
+            // plan finished, continue behind the variant
+            if(frames.isEmpty())
+                return true;
+            plan = frames.last().plan;
+            pc = frames.last().pc;
+            frames.removeLast();
+            continue;
+        }
+
+        const DltDBusOp &op = plan->at(pc++);
+        switch(op.code)
+        {
+        case DltDBusOp::OpCheckOffset:
+            if(offset>=payload.size())
+            {
+                error = QString("decodePayloadSignature: Payload length error!");
+                return false;
+            }
+            break;
+        case DltDBusOp::OpValue:
+            if(!decodePayloadParameter(op.type,dataPtr,offset,payload.size()))
+                return false;
+            break;
+        case DltDBusOp::OpVariant:
+        {
+            QByteArray data;
+
+            // read parameter
+            if(!readSignature(data,dataPtr,offset,maxSize))
+                return false;
+
+            // add parameter
+            parameter.setType(DBUS_TYPE_VARIANT);
+            parameter.setValue(QVariant(QString(data)));
+            parameters.append(parameter);
+
+            if(frames.size() >= DBUS_VARIANT_DEPTH_MAX)
+            {
+                error = QString("decodePayloadSignature: Variant nesting too deep!");
+                return false;
+            }
+
+            // run the plan of the variant signature
+            Frame frame;
+            frame.plan = plan;
+            frame.pc = pc;
+            frames.append(frame);
+            plan = getPlan(data);
+            pc = 0;
+            break;
+        }
+        case DltDBusOp::OpArrayLength:
+            if(!readUint32(lengthArray,dataPtr,offset,maxSize))
+                return false;
+            break;
+        case DltDBusOp::OpArrayLength2:
+        {
+            int lastOffset = offset;
+            uint32_t lengthArray2;
+            if(!readUint32(lengthArray2,dataPtr,offset,maxSize))
+                return false;
+            lengthArray = lengthArray - (offset-lastOffset);
+            break;
+        }
+        case DltDBusOp::OpArrayBegin:
+        {
+            Array array;
+            array.end = static_cast<int>(offset+lengthArray);
+            array.start = -1;
+            arrays.append(array);
+            if(op.argument)
+                offset+=padding(offset,op.argument);
+            parameter.setType(DBUS_TYPE_ARRAY);
+            parameter.setValue(QVariant(QString('[')));
+            parameters.append(parameter);
+            break;
+        }
+        case DltDBusOp::OpArrayLoop:
+            if(offset < arrays.last().end)
+                arrays.last().start = offset;
+            else
+                pc = op.argument;
+            break;
+        case DltDBusOp::OpArrayNext:
+            if(offset <= arrays.last().start)
+            {
+                // an element without size would never reach the end of the array
+                error = QString("decodePayloadSignature: Array element error!");
+                return false;
+            }
+            pc = op.argument;
+            break;
+        case DltDBusOp::OpArrayEnd:
+            arrays.removeLast();
+            parameter.setType(DBUS_TYPE_ARRAY);
+            parameter.setValue(QVariant(QString(']')));
+            parameters.append(parameter);
+            break;
+        case DltDBusOp::OpAlign:
+            offset+=padding(offset,op.argument);
+            break;
+        case DltDBusOp::OpMarker:
+            parameter.setType(op.argument);
+            parameter.setValue(QVariant(QString(op.type)));
+            parameters.append(parameter);
+            break;
+        case DltDBusOp::OpFail:
+            error = op.error;
+            return false;
+        }
+    }
 }
 
 bool DltDBusDecoder::decodePayloadParameter(char type,char *dataPtr,int &offset,int maxSize)
@@ -698,23 +793,8 @@ bool DltDBusDecoder::decodePayloadParameter(char type,char *dataPtr,int &offset,
         return false;
         break;
     case DBUS_TYPE_CHAR_VARIANT: //	118 // (ASCII 'v') 	Variant type (the type of the value is part of the value itself)
-    {
-        QByteArray data;
-
-        // read parameter
-        if(!readSignature(data,dataPtr,offset,maxSize))
-            return false;
-
-        // add parameter
-        parameter.setType(DBUS_TYPE_VARIANT);
-        parameter.setValue(QVariant(QString(data)));
-        parameters.append(parameter);
-
-        if(!decodePayloadSignature(data,dataPtr,offset,maxSize))
-            return false;
-
-        break;
-    }
+        // variants are decoded by the plan, which limits the nesting depth
+        return runPlan(getPlan(QByteArray(1,type)),dataPtr,offset,maxSize);
     case DBUS_TYPE_CHAR_DICT_ENTRY: //	101 // (ASCII 'e'),
         error = QString("Dictonary entry type e invalid!");
         return false;
@@ -786,7 +866,7 @@ bool DltDBusDecoder::readString(QString &data,char *dataPtr,int &offset,int maxS
 
     // read string
     //data = QString::fromLatin1(dataPtr+offset,length);
-    data= QString::fromUtf8(QByteArray(dataPtr+offset,length));
+    data= QString::fromUtf8(dataPtr+offset,length);
 
     // increase offset by size plus termination byte zero
     offset+=length+1;
@@ -23,6 +23,8 @@
 #include <QByteArray>
 #include <QString>
 #include <QList>
+#include <QVector>
+#include <QSharedPointer>
 
 #if defined(_MSC_VER)
 #include <cstdint>
@@ -112,6 +114,9 @@
 #define DBUS_TYPE_UNIX_FD	21 // (ASCII 'h')	Unix file descriptor
 #define DBUS_TYPE_MAX 21
 
+#define DBUS_PLAN_CACHE_MAX 4096 // distinct signatures kept as compiled decode plans
+#define DBUS_VARIANT_DEPTH_MAX 64 // maximum nesting of variants in a payload
+
 extern const char *dbus_message_type[];
 extern const char *dbus_message_type_short[];
 extern const char *dbus_field_code[];
@@ -135,6 +140,41 @@ private:
     QVariant value;
 };
 
+//! One step of a compiled payload signature
+/*!
+  A signature is compiled once into a flat list of steps, which is run
+  for every message with this signature, see DltDBusDecoder::compileSignature().
+  Loops over array elements are jumps inside the list.
+*/
+class DltDBusOp
+{
+public:
+    typedef enum
+    {
+        OpCheckOffset,  // fail if the payload is already consumed
+        OpValue,        // read a basic value of type
+        OpVariant,      // read a signature and run its plan
+        OpArrayLength,  // read the array length
+        OpArrayLength2, // read the length of the inner array of a two dimensional array
+        OpArrayBegin,   // start an array, align to argument
+        OpArrayLoop,    // jump to argument if all array elements are read
+        OpArrayNext,    // jump back to the loop at argument
+        OpArrayEnd,     // finish an array
+        OpAlign,        // align offset to argument
+        OpMarker,       // add parameter of type argument with the bracket in type
+        OpFail          // fail with error
+    } OpCode;
+
+    DltDBusOp(OpCode code = OpFail, char type = 0, int argument = 0) : code(code), type(type), argument(argument) {}
+
+    OpCode code;
+    char type;
+    int argument;
+    QString error;
+};
+
+typedef QVector<DltDBusOp> DltDBusPlan;
+
 class DltDBusDecoder
 {
 public:
@@ -179,8 +219,12 @@ protected:
 
     int padding(uint32_t pos,int alignement);
 
-    int indexOfCascaded(QByteArray signature,char ch, char cascade, int from = 0);
-    bool decodePayloadSignature(QByteArray signature,char *dataPtr,int &offset,int maxSize);
+    static int indexOfCascaded(const QByteArray &signature,char ch, char cascade, int from = 0, int to = -1);
+    bool decodePayloadSignature(const QByteArray &signature,char *dataPtr,int &offset,int maxSize);
+
+    static QSharedPointer<const DltDBusPlan> getPlan(const QByteArray &signature);
+    static void compileSignature(const QByteArray &signature, int from, int to, DltDBusPlan &plan);
+    bool runPlan(QSharedPointer<const DltDBusPlan> plan,char *dataPtr,int &offset,int maxSize);
     bool decodePayloadParameter(char type,char *dataPtr,int &offset,int maxSize);
 
     bool readString(QString &data,char *dataPtr,int &offset,int maxSize);
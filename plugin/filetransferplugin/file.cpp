@@ -209,9 +209,16 @@ QByteArray* File::getFileData(){
 
    fileData = new QByteArray();
 
+   /* the packages are read in blocks of neighbouring messages */
+   QVector<qint64> indexes;
+   for(unsigned int i=0; i<packages;i++){
+       indexes.append(dltFileIndex->value(i));
+   }
+   QDltFileIterator messages(dltFile, indexes);
+
     for(unsigned int i=0; i<packages;i++){
-       int qfileIdx = dltFileIndex->value(i);
-       msgBuffer =  dltFile->getMsg(qfileIdx);
+       messages.seek(i);
+       msgBuffer =  messages.data();
        msg.setMsg(msgBuffer);
        msg.getArgument(PROTOCOL_FLDA_DATA,data);
        fileData->append(data.getData());
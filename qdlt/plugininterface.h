@@ -397,4 +397,30 @@ public:
 Q_DECLARE_INTERFACE(QDltPluginCommandInterface,
                     "org.genivi.DLT.Plugin.DLTViewerPluginCommandInterface/1.1")
 
+//! DLT Signal Plugin Interface
+/*!
+ This interface can be used by plugins, which show numeric values of messages,
+ e.g. plots over time. Instead of parsing every message in initMsg and updateMsg,
+ the plugin requests the series of its signals from the extractor of the viewer.
+*/
+class QDltPluginSignalInterface
+{
+public:
+
+    //! The signal extractor of the loaded log file is injected into the plugin
+    /*!
+      This function is called by the viewer once on creation of the plugin.
+      The plugin requests the series with QDltSignalExtractor::requestSeries(), e.g. in initFileFinish(),
+      and gets them with the signal QDltSignalExtractor::seriesFinished() in its own thread.
+      The series of all signals requested at once are extracted in one parallel pass over
+      the log file in the background and are cached, so requesting them again is fast.
+      Reloading the log file cancels the running requests.
+      \param extractor The signal extractor of the viewer.
+    */
+    virtual void initSignalExtractor(QDltSignalExtractor *extractor) = 0;
+};
+
+Q_DECLARE_INTERFACE(QDltPluginSignalInterface,
+                    "org.genivi.DLT.Plugin.DLTViewerPluginSignalInterface/1.0")
+
 #endif // PLUGININTERFACE_H
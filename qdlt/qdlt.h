@@ -25,12 +25,19 @@
 #include <qdltbase.h>
 
 #include <qdltargument.h>
+#include <qdlttimeformatter.h>
 #include <qdltmsg.h>
+#include <qdltmultipattern.h>
 #include <qdltfilter.h>
 #include <qdltfilterlist.h>
 #include <qdltfilterindex.h>
 #include <qdltdefaultfilter.h>
+#include <qdltmemoryusage.h>
+#include <qdltblocksummary.h>
+#include <qdltfileindex.h>
 #include <qdltfile.h>
+#include <qdltfilereader.h>
+#include <qdltcapturebuffer.h>
 #include <qdltcontrol.h>
 #include <qdltconnection.h>
 #include <qdltipconnection.h>
@@ -40,7 +47,9 @@
 #include <qdltmessagedecoder.h>
 #include <qdltplugin.h>
 #include <qdltpluginmanager.h>
+#include <qdltsignal.h>
 #include <qdltoptmanager.h>
+#include <qdltprofiler.h>
 #include <qdltsettingsmanager.h>
 
 #endif // QDLT_H
@@ -65,6 +65,10 @@ SOURCES +=  \
     qdltmsg.cpp \
     qdltfilter.cpp \
     qdltfile.cpp \
+    qdltfileindex.cpp \
+    qdltblocksummary.cpp \
+    qdltmemoryusage.cpp \
+    qdltsignal.cpp \
     qdltcontrol.cpp \
     qdltconnection.cpp \
     qdltbase.cpp \
@@ -75,6 +79,11 @@ SOURCES +=  \
     qdltpluginmanager.cpp \
     qdltplugin.cpp \
     qdltoptmanager.cpp \
+    qdltprofiler.cpp \
+    qdltmultipattern.cpp \
+    qdlttimeformatter.cpp \
+    qdltfilereader.cpp \
+    qdltcapturebuffer.cpp \
     qdltsegmentedmsg.cpp \
     qdltsettingsmanager.cpp \
 
@@ -90,6 +99,10 @@ HEADERS += qdlt.h \
     qdltmsg.h \
     qdltfilter.h \
     qdltfile.h \
+    qdltfileindex.h \
+    qdltblocksummary.h \
+    qdltmemoryusage.h \
+    qdltsignal.h \
     qdltcontrol.h \
     qdltconnection.h \
     qdltbase.h \
@@ -103,6 +116,11 @@ HEADERS += qdlt.h \
     dlt_types.h \
     dlt_protocol.h \
     qdltoptmanager.h \
+    qdltprofiler.h \
+    qdltmultipattern.h \
+    qdlttimeformatter.h \
+    qdltfilereader.h \
+    qdltcapturebuffer.h \
     qdltsegmentedmsg.h \
     qdltsettingsmanager.h \
 
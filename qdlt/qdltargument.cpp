@@ -20,6 +20,8 @@
  */
 
 #include <QtDebug>
+#include <QtEndian>
+#include <cstring>
 
 #include "qdlt.h"
 
@@ -637,6 +639,98 @@ QVariant QDltArgument::getValue() const
     return QVariant();
 }
 
+bool QDltArgument::getSigned(qint64 &value) const
+{
+    const uchar *raw = (const uchar *) data.constData();
+    bool little = (endianness == DltEndiannessLittleEndian);
+
+    if(typeInfo == DltTypeInfoBool)
+    {
+        if(data.isEmpty())
+            return false;
+        value = raw[0] ? 1 : 0;
+        return true;
+    }
+
+    if(typeInfo != DltTypeInfoSInt)
+        return false;
+
+    switch(data.size())
+    {
+    case 1:
+        value = (qint8) raw[0];
+        break;
+    case 2:
+        value = little ? qFromLittleEndian<qint16>(raw) : qFromBigEndian<qint16>(raw);
+        break;
+    case 4:
+        value = little ? qFromLittleEndian<qint32>(raw) : qFromBigEndian<qint32>(raw);
+        break;
+    case 8:
+        value = little ? qFromLittleEndian<qint64>(raw) : qFromBigEndian<qint64>(raw);
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+bool QDltArgument::getUnsigned(quint64 &value) const
+{
+    const uchar *raw = (const uchar *) data.constData();
+    bool little = (endianness == DltEndiannessLittleEndian);
+
+    if(typeInfo != DltTypeInfoUInt)
+        return false;
+
+    switch(data.size())
+    {
+    case 1:
+        value = raw[0];
+        break;
+    case 2:
+        value = little ? qFromLittleEndian<quint16>(raw) : qFromBigEndian<quint16>(raw);
+        break;
+    case 4:
+        value = little ? qFromLittleEndian<quint32>(raw) : qFromBigEndian<quint32>(raw);
+        break;
+    case 8:
+        value = little ? qFromLittleEndian<quint64>(raw) : qFromBigEndian<quint64>(raw);
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+bool QDltArgument::getFloat(double &value) const
+{
+    const uchar *raw = (const uchar *) data.constData();
+    bool little = (endianness == DltEndiannessLittleEndian);
+
+    if(typeInfo != DltTypeInfoFloa)
+        return false;
+
+    if(data.size() == 4)
+    {
+        quint32 bits = little ? qFromLittleEndian<quint32>(raw) : qFromBigEndian<quint32>(raw);
+        float number;
+        memcpy(&number, &bits, sizeof(number));
+        value = number;
+        return true;
+    }
+    if(data.size() == 8)
+    {
+        quint64 bits = little ? qFromLittleEndian<quint64>(raw) : qFromBigEndian<quint64>(raw);
+        memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+    return false;
+}
+
 bool QDltArgument::setValue(QVariant value, bool verboseMode)
 {
     Q_UNUSED(verboseMode);
@@ -185,6 +185,29 @@ public:
 
     QVariant getValue() const;
 
+    //! Get the value of a signed integer or bool argument.
+    /*!
+      The value is read from the data with the endianness of the argument,
+      without converting it to a string or a variant.
+      \param value The value of the argument, bool arguments are 0 or 1.
+      \return true if the argument is a signed integer or bool, else false.
+    */
+    bool getSigned(qint64 &value) const;
+
+    //! Get the value of an unsigned integer argument.
+    /*!
+      \param value The value of the argument.
+      \return true if the argument is an unsigned integer, else false.
+    */
+    bool getUnsigned(quint64 &value) const;
+
+    //! Get the value of a float argument.
+    /*!
+      \param value The value of the argument.
+      \return true if the argument is a 32 or 64 bit float, else false.
+    */
+    bool getFloat(double &value) const;
+
     bool setValue(QVariant value, bool verboseMode = true);
 
 protected:
@@ -0,0 +1,268 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltblocksummary.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QtDebug>
+#include <QFile>
+#include <QDataStream>
+
+#include "qdlt.h"
+
+QDltBlockSummary::QDltBlockSummary()
+{
+    count = 0;
+    unknown = false;
+    notExtended = false;
+    nonVerbose = false;
+    minSeconds = 0xffffffff;
+    maxSeconds = 0;
+    minTimestamp = 0xffffffff;
+    maxTimestamp = 0;
+    ecus[0] = ecus[1] = 0;
+    apids[0] = apids[1] = 0;
+    ctids[0] = ctids[1] = 0;
+    types = 0;
+    minLogLevel = 0xff;
+    maxLogLevel = -1;
+}
+
+void QDltBlockSummary::addMessage(quint32 seconds, quint32 timestamp, quint32 ecu, quint32 apid, quint32 ctid, int type, int subtype, bool verbose)
+{
+    count++;
+
+    minSeconds = qMin(minSeconds, seconds);
+    maxSeconds = qMax(maxSeconds, seconds);
+    minTimestamp = qMin(minTimestamp, timestamp);
+    maxTimestamp = qMax(maxTimestamp, timestamp);
+    addKey(ecus, ecu);
+
+    if(type < 0)
+    {
+        notExtended = true;
+        return;
+    }
+
+    if(!verbose)
+        nonVerbose = true;
+
+    addKey(apids, apid);
+    addKey(ctids, ctid);
+    types |= 1 << (type & 0x7);
+    if(type == QDltMsg::DltTypeLog)
+    {
+        minLogLevel = qMin(minLogLevel, subtype);
+        maxLogLevel = qMax(maxLogLevel, subtype);
+    }
+}
+
+void QDltBlockSummary::addUnknown()
+{
+    count++;
+    unknown = true;
+}
+
+void QDltBlockSummary::merge(const QDltBlockSummary &other, int messages)
+{
+    count += messages;
+    unknown = unknown || other.unknown;
+    notExtended = notExtended || other.notExtended;
+    nonVerbose = nonVerbose || other.nonVerbose;
+    minSeconds = qMin(minSeconds, other.minSeconds);
+    maxSeconds = qMax(maxSeconds, other.maxSeconds);
+    minTimestamp = qMin(minTimestamp, other.minTimestamp);
+    maxTimestamp = qMax(maxTimestamp, other.maxTimestamp);
+    for(int num = 0; num < 2; num++)
+    {
+        ecus[num] |= other.ecus[num];
+        apids[num] |= other.apids[num];
+        ctids[num] |= other.ctids[num];
+    }
+    types |= other.types;
+    minLogLevel = qMin(minLogLevel, other.minLogLevel);
+    maxLogLevel = qMax(maxLogLevel, other.maxLogLevel);
+}
+
+bool QDltBlockSummary::save(const QString &filename, const QVector<QDltBlockSummary> &blocks)
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream stream(&file);
+    stream << (quint32) QDLT_BLOCK_SUMMARY_FILE_MAGIC << (quint32) QDLT_BLOCK_SUMMARY_FILE_VERSION;
+    stream << (quint32) blocks.size();
+    for(int num = 0; num < blocks.size(); num++)
+    {
+        const QDltBlockSummary &block = blocks[num];
+        stream << (qint32) block.count << block.unknown << block.notExtended << block.nonVerbose;
+        stream << block.minSeconds << block.maxSeconds << block.minTimestamp << block.maxTimestamp;
+        stream << block.ecus[0] << block.ecus[1] << block.apids[0] << block.apids[1] << block.ctids[0] << block.ctids[1];
+        stream << block.types << (qint32) block.minLogLevel << (qint32) block.maxLogLevel;
+    }
+
+    file.close();
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool QDltBlockSummary::load(const QString &filename, QVector<QDltBlockSummary> &blocks)
+{
+    blocks.clear();
+
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0, size = 0;
+    stream >> magic >> version;
+    if(magic != QDLT_BLOCK_SUMMARY_FILE_MAGIC || version != QDLT_BLOCK_SUMMARY_FILE_VERSION)
+    {
+        qDebug() << "Block summary cache" << filename << "has wrong version";
+        return false;
+    }
+
+    stream >> size;
+    for(quint32 num = 0; num < size && stream.status() == QDataStream::Ok; num++)
+    {
+        QDltBlockSummary block;
+        qint32 count, minLogLevel, maxLogLevel;
+        stream >> count >> block.unknown >> block.notExtended >> block.nonVerbose;
+        stream >> block.minSeconds >> block.maxSeconds >> block.minTimestamp >> block.maxTimestamp;
+        stream >> block.ecus[0] >> block.ecus[1] >> block.apids[0] >> block.apids[1] >> block.ctids[0] >> block.ctids[1];
+        stream >> block.types >> minLogLevel >> maxLogLevel;
+        block.count = count;
+        block.minLogLevel = minLogLevel;
+        block.maxLogLevel = maxLogLevel;
+        blocks.append(block);
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        qDebug() << "Block summary cache" << filename << "is invalid";
+        blocks.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool QDltBlockSummary::mayMatch(const QDltFilter &filter, bool decoded) const
+{
+    if(unknown)
+        return true;
+
+    /* the time window is checked with whole seconds */
+    if(filter.enableTime && !mayMatchTime((quint32) qBound<qint64>(0, filter.timeMin / 1000000, 0xffffffff),
+                                          (quint32) qBound<qint64>(0, filter.timeMax / 1000000, 0xffffffff)))
+        return false;
+    if(filter.enableTimestamp && !mayMatchTimestamp(filter.timestampMin / 10000.0, filter.timestampMax / 10000.0))
+        return false;
+
+    if(filter.enableEcuid && !hasKey(ecus, idKey(filter.ecuid)))
+        return false;
+
+    /* ids and type may be set by decoder plugins */
+    if(notExtended || (decoded && nonVerbose))
+        return true;
+
+    if(filter.enableApid && !filter.enableRegexp_Appid && !hasKey(apids, idKey(filter.apid)))
+        return false;
+
+    /* the context id is a substring match, only a complete id can be checked */
+    if(filter.enableCtid && !filter.enableRegexp_Context && filter.ctid.size() == 4 && !hasKey(ctids, idKey(filter.ctid)))
+        return false;
+
+    if(filter.enableCtrlMsgs && !(types & (1 << QDltMsg::DltTypeControl)))
+        return false;
+
+    bool hasLog = types & (1 << QDltMsg::DltTypeLog);
+    if(filter.enableLogLevelMax && (!hasLog || minLogLevel > filter.logLevelMax))
+        return false;
+    if(filter.enableLogLevelMin && (!hasLog || maxLogLevel < filter.logLevelMin))
+        return false;
+
+    return true;
+}
+
+bool QDltBlockSummary::mayMatchIds(const QString &apid, const QString &ctid, bool decoded) const
+{
+    if(unknown || notExtended || (decoded && nonVerbose))
+        return true;
+
+    if(!apid.isEmpty() && !hasKey(apids, idKey(apid)))
+        return false;
+    if(!ctid.isEmpty() && !hasKey(ctids, idKey(ctid)))
+        return false;
+
+    return true;
+}
+
+bool QDltBlockSummary::mayMatchTimestamp(double start, double stop) const
+{
+    if(unknown)
+        return true;
+
+    return count > 0 && maxTimestamp / 10000.0 >= start && minTimestamp / 10000.0 <= stop;
+}
+
+bool QDltBlockSummary::mayMatchTime(quint32 start, quint32 stop) const
+{
+    if(unknown)
+        return true;
+
+    return count > 0 && maxSeconds >= start && minSeconds <= stop;
+}
+
+quint32 QDltBlockSummary::idKey(const QString &id)
+{
+    quint32 key = 0;
+    for(int num = 0; num < 4; num++)
+        key = (key << 8) | ((num < id.size()) ? (quint8) id.at(num).toLatin1() : 0);
+    return key;
+}
+
+quint32 QDltBlockSummary::foldKey(quint32 key)
+{
+    /* upper case of each character */
+    quint32 folded = 0;
+    for(int shift = 24; shift >= 0; shift -= 8)
+    {
+        quint8 c = (key >> shift) & 0xff;
+        if(c >= 'a' && c <= 'z')
+            c -= 'a' - 'A';
+        folded = (folded << 8) | c;
+    }
+    return folded;
+}
+
+void QDltBlockSummary::addKey(quint64 *bloom, quint32 key)
+{
+    quint32 hash = foldKey(key) * 0x9e3779b1;
+    int first = hash >> 25;
+    int second = (hash >> 18) & 0x7f;
+    bloom[first >> 6] |= (quint64) 1 << (first & 0x3f);
+    bloom[second >> 6] |= (quint64) 1 << (second & 0x3f);
+}
+
+bool QDltBlockSummary::hasKey(const quint64 *bloom, quint32 key)
+{
+    quint32 hash = foldKey(key) * 0x9e3779b1;
+    int first = hash >> 25;
+    int second = (hash >> 18) & 0x7f;
+    return (bloom[first >> 6] & ((quint64) 1 << (first & 0x3f))) &&
+           (bloom[second >> 6] & ((quint64) 1 << (second & 0x3f)));
+}
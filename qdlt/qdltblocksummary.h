@@ -0,0 +1,129 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltblocksummary.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTBLOCKSUMMARY_H
+#define QDLTBLOCKSUMMARY_H
+
+#include <QString>
+#include <QVector>
+
+#include "export_rules.h"
+
+/* number of consecutive messages summarised in one block */
+#define QDLT_BLOCK_SUMMARY_SIZE 65536
+
+/* version of the block summary cache files */
+#define QDLT_BLOCK_SUMMARY_FILE_MAGIC 0x444c4253
+#define QDLT_BLOCK_SUMMARY_FILE_VERSION 1
+
+class QDltFilter;
+
+//! Summary of the headers of a block of consecutive messages.
+/*!
+  The summary keeps the range of the times and timestamps, Bloom
+  filters of the ECU ids, application ids and context ids, the message
+  types and the range of the log levels. A filter or search, which
+  cannot match any message of the summary, skips the whole block
+  without reading the messages.
+
+  The checks are conservative: false means that no message of the block
+  can match, true means that a message may match. The ids are compared
+  case insensitive. Decoder plugins may set the ids and the type of
+  non verbose messages, so when decoding is enabled only the ECU id and
+  the times of a block with such messages are checked. Messages without
+  extended header are always checked this way.
+*/
+class QDLT_EXPORT QDltBlockSummary
+{
+public:
+    QDltBlockSummary();
+
+    //! Add a message with the values of its header.
+    /*!
+      \param seconds Storage header time
+      \param timestamp Timestamp in 0.1 milliseconds, 0 if not available
+      \param ecu Packed ECU id
+      \param apid Packed application id
+      \param ctid Packed context id
+      \param type Message type, -1 if the message has no extended header
+      \param subtype Log level or other subtype of the message type
+      \param verbose true if the message is a verbose message
+    */
+    void addMessage(quint32 seconds, quint32 timestamp, quint32 ecu, quint32 apid, quint32 ctid, int type, int subtype, bool verbose);
+
+    //! Add a message, whose header could not be read. Every check of the block matches.
+    void addUnknown();
+
+    //! Number of messages in the block.
+    int size() const { return count; }
+
+    //! Add the messages of another summary.
+    /*!
+      The values of the other summary are merged completely, so the result
+      is conservative, if only a part of its messages belong to this block.
+      \param other Summary of the messages
+      \param messages Number of its messages belonging to this block
+    */
+    void merge(const QDltBlockSummary &other, int messages);
+
+    //! Save summaries to a cache file.
+    static bool save(const QString &filename, const QVector<QDltBlockSummary> &blocks);
+
+    //! Load summaries from a cache file.
+    static bool load(const QString &filename, QVector<QDltBlockSummary> &blocks);
+
+    //! Check if a message of the block may match the filter.
+    /*!
+      \param filter The filter
+      \param decoded true if the messages are decoded by decoder plugins before filtering
+    */
+    bool mayMatch(const QDltFilter &filter, bool decoded) const;
+
+    //! Check if a message of the block may have the ids, empty ids are not checked.
+    bool mayMatchIds(const QString &apid, const QString &ctid, bool decoded) const;
+
+    //! Check if a message of the block may have a timestamp in the range, in seconds.
+    bool mayMatchTimestamp(double start, double stop) const;
+
+    //! Check if a message of the block may have a storage header time in the range.
+    bool mayMatchTime(quint32 start, quint32 stop) const;
+
+    //! Pack an id like the message headers, up to four characters.
+    static quint32 idKey(const QString &id);
+
+private:
+    static quint32 foldKey(quint32 key);
+    static void addKey(quint64 *bloom, quint32 key);
+    static bool hasKey(const quint64 *bloom, quint32 key);
+
+    int count;
+    bool unknown;       /* messages with unreadable header */
+    bool notExtended;   /* messages without extended header */
+    bool nonVerbose;    /* non verbose messages, which may be changed by decoders */
+    quint32 minSeconds;
+    quint32 maxSeconds;
+    quint32 minTimestamp;
+    quint32 maxTimestamp;
+    quint64 ecus[2];
+    quint64 apids[2];
+    quint64 ctids[2];
+    quint32 types;      /* one bit per message type */
+    int minLogLevel;
+    int maxLogLevel;
+};
+
+#endif // QDLTBLOCKSUMMARY_H
@@ -0,0 +1,250 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltcapturebuffer.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QDebug>
+#include <cstring>
+
+#include "qdltcapturebuffer.h"
+
+QDltCaptureBuffer::QDltCaptureBuffer()
+{
+    maxSize = 64 * QDLT_CAPTURE_SEGMENT_SIZE;
+    spillFile = 0;
+    clear();
+}
+
+void QDltCaptureBuffer::setMaxSize(qint64 bytes)
+{
+    QMutexLocker locker(&mutex);
+
+    maxSize = bytes;
+    release();
+}
+
+void QDltCaptureBuffer::setSpillFile(QFile *file)
+{
+    QMutexLocker locker(&mutex);
+
+    spillFile = file;
+    if(file)
+        spillName = file->fileName();
+}
+
+void QDltCaptureBuffer::clear()
+{
+    QMutexLocker locker(&mutex);
+
+    segments.clear();
+    firstInMemory = 0;
+    memory = 0;
+    count = 0;
+    spillReader.close();
+}
+
+void QDltCaptureBuffer::addMessage(const QByteArray &storageHeader, const QByteArray &header, const QByteArray &payload)
+{
+    QMutexLocker locker(&mutex);
+
+    int size = storageHeader.size() + header.size() + payload.size();
+
+    /* start a new segment when the message does not fit, the memory is allocated once */
+    if(segments.isEmpty() || segments.last().spillPos >= 0 ||
+       (segments.last().data.size() > 0 && segments.last().data.size() + size > QDLT_CAPTURE_SEGMENT_SIZE))
+    {
+        Segment segment;
+        segment.first = count;
+        segment.data.reserve(qMax(QDLT_CAPTURE_SEGMENT_SIZE, size));
+        segment.offsets.append(0);
+        segments.append(segment);
+    }
+
+    Segment &segment = segments.last();
+    segment.data.append(storageHeader);
+    segment.data.append(header);
+    segment.data.append(payload);
+    segment.offsets.append(segment.data.size());
+
+    count++;
+    memory += size;
+
+    release();
+}
+
+bool QDltCaptureBuffer::flush()
+{
+    QMutexLocker locker(&mutex);
+
+    if(!spillFile)
+        return false;
+
+    while(firstInMemory < segments.size())
+    {
+        if(!spill(segments[firstInMemory]))
+            return false;
+        firstInMemory++;
+    }
+
+    return true;
+}
+
+qint64 QDltCaptureBuffer::size() const
+{
+    QMutexLocker locker(&mutex);
+
+    return count;
+}
+
+qint64 QDltCaptureBuffer::first() const
+{
+    QMutexLocker locker(&mutex);
+
+    return segments.isEmpty() ? count : segments.first().first;
+}
+
+qint64 QDltCaptureBuffer::memorySize() const
+{
+    QMutexLocker locker(&mutex);
+
+    return memory;
+}
+
+QByteArray QDltCaptureBuffer::getMsg(qint64 number) const
+{
+    QByteArray buffer;
+    QVector<int> offsets;
+
+    if(getMsgRange(number, 1, buffer, offsets) != 1)
+        return QByteArray();
+
+    return buffer;
+}
+
+int QDltCaptureBuffer::getMsgRange(qint64 number, int messages, QByteArray &buffer, QVector<int> &offsets) const
+{
+    QMutexLocker locker(&mutex);
+
+    offsets.clear();
+
+    int num = findSegment(number);
+    if(num < 0 || messages <= 0)
+        return 0;
+
+    /* the range ends at the end of the segment */
+    const Segment &segment = segments[num];
+    int index = (int) (number - segment.first);
+    messages = qMin(messages, segment.offsets.size() - 1 - index);
+    int begin = segment.offsets[index];
+    int end = segment.offsets[index + messages];
+
+    buffer.resize(end - begin);
+    if(!readSegment(segment, begin, end - begin, buffer.data()))
+    {
+        buffer.clear();
+        return 0;
+    }
+
+    for(int i = 0; i <= messages; i++)
+        offsets.append(segment.offsets[index + i] - begin);
+
+    return messages;
+}
+
+void QDltCaptureBuffer::release()
+{
+    /* the segment being filled is never released */
+    while(memory > maxSize && firstInMemory < segments.size() - 1)
+    {
+        Segment &segment = segments[firstInMemory];
+
+        if(spillFile)
+        {
+            if(!spill(segment))
+                break;
+            firstInMemory++;
+        }
+        else if(firstInMemory == 0)
+        {
+            /* dropped messages are only removed from the front, so numbers have no gaps */
+            memory -= segment.data.size();
+            segments.remove(0);
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+bool QDltCaptureBuffer::spill(Segment &segment)
+{
+    /* append the whole segment with one write */
+    qint64 pos = spillFile->size();
+    if(!spillFile->seek(pos) || spillFile->write(segment.data) != segment.data.size())
+    {
+        qDebug() << "Capture: cannot write to" << spillFile->fileName() << spillFile->errorString();
+        return false;
+    }
+    spillFile->flush();
+
+    memory -= segment.data.size();
+    segment.data = QByteArray();
+    segment.spillPos = pos;
+
+    return true;
+}
+
+int QDltCaptureBuffer::findSegment(qint64 number) const
+{
+    if(segments.isEmpty() || number < segments.first().first || number >= count)
+        return -1;
+
+    /* last segment starting at or before the message */
+    int low = 0;
+    int high = segments.size() - 1;
+    while(low < high)
+    {
+        int middle = (low + high + 1) / 2;
+        if(segments[middle].first <= number)
+            low = middle;
+        else
+            high = middle - 1;
+    }
+
+    return low;
+}
+
+bool QDltCaptureBuffer::readSegment(const Segment &segment, int offset, int size, char *data) const
+{
+    if(segment.spillPos < 0)
+    {
+        memcpy(data, segment.data.constData() + offset, size);
+        return true;
+    }
+
+    if(!spillReader.isOpen() || spillReader.fileName() != spillName)
+    {
+        spillReader.close();
+        spillReader.setFileName(spillName);
+        if(!spillReader.open(QIODevice::ReadOnly))
+        {
+            qDebug() << "Capture: cannot read" << spillName << spillReader.errorString();
+            return false;
+        }
+    }
+
+    return spillReader.seek(segment.spillPos + offset) && spillReader.read(data, size) == size;
+}
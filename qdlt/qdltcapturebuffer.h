@@ -0,0 +1,111 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltcapturebuffer.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTCAPTUREBUFFER_H
+#define QDLTCAPTUREBUFFER_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QFile>
+#include <QMutex>
+
+#include "export_rules.h"
+
+/* size of one memory segment of the capture buffer */
+#define QDLT_CAPTURE_SEGMENT_SIZE (4*1024*1024)
+
+//! Keeps received messages in memory.
+/*!
+  Messages are appended to segments of QDLT_CAPTURE_SEGMENT_SIZE bytes.
+  When the messages in memory exceed the maximum size, the oldest
+  segment is written to the spill file with one write, or dropped
+  if there is no spill file. Spilled messages are still readable.
+
+  Messages are numbered in the order they are added, starting with 0.
+  Dropped messages are not readable any more, first() is the number
+  of the oldest readable message.
+*/
+class QDLT_EXPORT QDltCaptureBuffer
+{
+public:
+    QDltCaptureBuffer();
+
+    //! Maximum number of bytes kept in memory, the segment being filled is always kept.
+    void setMaxSize(qint64 bytes);
+    qint64 getMaxSize() const { return maxSize; }
+
+    //! File the oldest segments are appended to, 0 to drop them.
+    /*!
+      The file must be open for writing, the capture does not take ownership.
+      It is not changed while messages are added, the spill file must be
+      kept while spilled messages are read.
+    */
+    void setSpillFile(QFile *file);
+
+    //! Delete all messages.
+    void clear();
+
+    //! Add a message, which consists of storage header, header and payload.
+    void addMessage(const QByteArray &storageHeader, const QByteArray &header, const QByteArray &payload);
+
+    //! Write all messages in memory to the spill file.
+    bool flush();
+
+    //! Number of all added messages, including dropped ones.
+    qint64 size() const;
+
+    //! Number of the oldest message which can be read.
+    qint64 first() const;
+
+    //! Bytes of the messages in memory.
+    qint64 memorySize() const;
+
+    //! Get a copy of a message.
+    QByteArray getMsg(qint64 number) const;
+
+    //! Get consecutive messages with one copy or read, like QDltFile::getMsgRange().
+    int getMsgRange(qint64 number, int messages, QByteArray &buffer, QVector<int> &offsets) const;
+
+private:
+    class Segment
+    {
+    public:
+        Segment() { first = 0; spillPos = -1; }
+
+        qint64 first;           /* number of the first message */
+        QByteArray data;        /* messages, empty when spilled */
+        QVector<int> offsets;   /* start of each message and end of the last one */
+        qint64 spillPos;        /* position in the spill file, -1 if in memory */
+    };
+
+    void release();
+    bool spill(Segment &segment);
+    int findSegment(qint64 number) const;
+    bool readSegment(const Segment &segment, int offset, int size, char *data) const;
+
+    mutable QMutex mutex;
+    QVector<Segment> segments;
+    int firstInMemory;
+    qint64 maxSize;
+    qint64 memory;
+    qint64 count;
+    QFile *spillFile;
+    QString spillName;
+    mutable QFile spillReader;
+};
+
+#endif // QDLTCAPTUREBUFFER_H
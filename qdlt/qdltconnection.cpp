@@ -20,6 +20,7 @@
  */
 
 #include <QtDebug>
+#include <string.h>
 
 #include "qdlt.h"
 
@@ -69,110 +70,136 @@ void QDltConnection::clear()
     bytesError = 0;
     syncFound = 0;
     messageCounter = 0;
+    syncScanPos = 0;
 }
 
 void QDltConnection::add(const QByteArray &bytes)
 {
     bytesReceived += bytes.size();
 
-    data = dataView + bytes;
+    /* remove the parsed data only, if it is at least as large as the remaining data,
+       so the remaining data is not copied again on each call */
+    int consumed = data.size() - dataView.size();
+    if(consumed > 0 && consumed >= dataView.size())
+    {
+        data.remove(0, consumed);
+        consumed = 0;
+    }
+    data.append(bytes);
 
-    dataView.align(data);
+    dataView.align(data, consumed);
 }
 
-bool QDltConnection::parseDlt(QDltMsg &msg)
+void QDltConnection::advance(int num)
 {
-    /* if sync to serial header search for header */
-    int found = 0;
-    int firstPos = 0;
-    int secondPos = 0;
-
-    char lastFound = 0;
+    dataView.advance(num);
+    syncScanPos = 0;
+}
 
-    /* Use primitive buffer for faster access */
-    int cbuf_sz = dataView.size();
+int QDltConnection::findSerialHeader(int pos)
+{
+    int size = dataView.size();
     const char *cbuf = dataView.constData();
 
-    /* find marker in buffer */
-    for(int num=0;num<cbuf_sz;num++) {
-        if(cbuf[num] == 'D')
-        {
-            lastFound = 'D';
-        }
-        else if(lastFound == 'D' && cbuf[num] == 'L')
-        {
-            lastFound = 'L';
-        }
-        else if(lastFound == 'L' && cbuf[num] == 'S')
+    /* memchr is vectorised in the C library, compare the marker only at its candidates */
+    while(pos <= size - (int)sizeof(dltSerialHeader))
+    {
+        const char *found = (const char*) memchr(cbuf + pos, dltSerialHeader[0], size - pos - sizeof(dltSerialHeader) + 1);
+        if(!found)
+            return -1;
+        pos = found - cbuf;
+        if(memcmp(found, dltSerialHeader, sizeof(dltSerialHeader)) == 0)
+            return pos;
+        pos++;
+    }
+    return -1;
+}
+
+bool QDltConnection::parseDlt(QDltMsg &msg)
+{
+    const int markerSize = sizeof(dltSerialHeader);
+    int firstPos = 0;
+    int secondPos = -1;
+
+    if(!syncSerialHeader)
+    {
+        /* serial header is optional at the start of the buffer */
+        if(dataView.size() >= markerSize && memcmp(dataView.constData(), dltSerialHeader, markerSize) == 0)
         {
-            lastFound = 'S';
+            firstPos = markerSize;
+            syncFound++;
         }
-        else if(lastFound == 'S' && cbuf[num] == 0x01)
+    }
+    else
+    {
+        /* find the first serial header, while waiting for the rest of a message it is at the start */
+        int pos = (syncScanPos > 0) ? 0 : findSerialHeader(0);
+        if(pos < 0)
         {
-            /* header found */
-            found++;
-            if(found==1)
-            {
-                firstPos = num+1;
-                syncFound++;
-            }
-            if(found==2)
+            /* keep the bytes which may be the start of a serial header */
+            int keep = 0;
+            for(int len = markerSize - 1; len > 0 && !keep; len--)
             {
-                secondPos = num+1;
-                break;
+                if(dataView.size() >= len && memcmp(dataView.constData() + dataView.size() - len, dltSerialHeader, len) == 0)
+                    keep = len;
             }
-            lastFound = 0;
+            bytesError += dataView.size() - keep;
+            advance(dataView.size() - keep);
+            return false;
         }
-        else
+
+        /* drop the bytes in front of the serial header */
+        if(pos > 0)
         {
-            lastFound = 0;
+            bytesError += pos;
+            advance(pos);
         }
-        if((!syncSerialHeader) && num==3)
-            break;
-    }
+        if(syncScanPos == 0)
+            syncFound++;
+        firstPos = markerSize;
 
-    if(syncSerialHeader && !found)
-    {
-        /* complete sync header not found */
-        if(!lastFound)
+        const char *cbuf = dataView.constData();
+        int size = dataView.size();
+
+        /* parse at the offset given by the length of the standard header,
+           if the message is followed by the next serial header or the end of data */
+        if(size >= firstPos + (int)sizeof(DltStandardHeader))
         {
-            /* clear buffer if even not start of sync header found */
-            bytesError += dataView.size();
-            dataView.clear();
+            const DltStandardHeader *standardheader = (const DltStandardHeader*) (cbuf + firstPos);
+            int end = firstPos + DLT_SWAP_16(standardheader->len);
+            if(end > firstPos && (end == size || (end <= size - markerSize && memcmp(cbuf + end, dltSerialHeader, markerSize) == 0)))
+            {
+                if(msg.setMsg(dataView.mid(firstPos, end - firstPos), false))
+                {
+                    advance(end);
+                    return true;
+                }
+            }
         }
-        return false;
-    }
 
-    //qDebug() << "found " << found << " firstPos " << firstPos << " secondPos " << secondPos;
+        /* the length is not reliable or the message is incomplete,
+           look for the next serial header where the last call stopped */
+        secondPos = findSerialHeader(qMax(syncScanPos, firstPos));
+        if(secondPos < 0)
+            syncScanPos = qMax(firstPos, size - markerSize + 1);
+    }
 
-    if(found==2)
+    if(secondPos >= 0)
     {
-        /* two sync headers found */
-        /* try to read msg */
-        if(!msg.setMsg(dataView.mid(firstPos,secondPos-firstPos-4),false))
+        /* try to read msg between the two serial headers */
+        if(!msg.setMsg(dataView.mid(firstPos, secondPos - firstPos), false))
         {
             /* no valid msg found, perhaps to short */
-            dataView.advance(secondPos-4);
-            /* errors found */
-            bytesError += secondPos-4;
+            bytesError += secondPos;
+            advance(secondPos);
             return false;
         }
-        else
-        {
-            /* msg read successful */
-            dataView.advance(secondPos-4);
-            if(firstPos>4)
-                /* errors found */
-                bytesError += firstPos-4;
-            return true;
-        }
 
+        /* msg read successful */
+        advance(secondPos);
+        return true;
     }
 
-    if(firstPos>4)
-        /* errors found */
-        bytesError += firstPos-4;
-
     /* try to read msg */
     if(!msg.setMsg(dataView.mid(firstPos),false))
     {
@@ -185,13 +212,13 @@ bool QDltConnection::parseDlt(QDltMsg &msg)
             /* clear buffer */
             /* errors found */
             bytesError += dataView.size();
-            dataView.clear();
+            advance(dataView.size());
         }
         return false;
     }
 
     /* msg read successful */
-    dataView.advance(firstPos+msg.getHeaderSize()+msg.getPayloadSize());
+    advance(firstPos+msg.getHeaderSize()+msg.getPayloadSize());
     return true;
 }
 
@@ -119,8 +119,24 @@ protected:
 
 private:
 
+    //! Search the next serial header in the buffer starting at pos.
+    /*!
+      \return position of the serial header or -1 if not found
+    */
+    int findSerialHeader(int pos);
+
+    //! Remove bytes from the start of the buffer and reset the sync search.
+    void advance(int num);
+
     unsigned char messageCounter;
 
+    //! Position in the buffer, up to which no second serial header was found.
+    /*!
+      The buffer starts with a serial header, if not zero. The search for
+      the next serial header continues from here, when more data is received.
+    */
+    int syncScanPos;
+
 };
 
 #endif // QDLT_CONNECTION_H
@@ -104,3 +104,11 @@ void QDltDefaultFilter::clearFilterIndex()
     foreach(t2,defaultFilterIndex)
         *t2 = QDltFilterIndex();
 }
+
+qint64 QDltDefaultFilter::memorySize() const
+{
+    qint64 bytes = 0;
+    for(int num = 0; num < defaultFilterIndex.size(); num++)
+        bytes += QDltMemoryUsage::of(defaultFilterIndex[num]->indexFilter);
+    return bytes;
+}
@@ -73,6 +73,9 @@ public:
     */
     void clearFilterIndex();
 
+    //! Bytes used by the default filter indexes.
+    qint64 memorySize() const;
+
     /* Default Filter List */
     QList<QDltFilterList*> defaultFilterList;
 
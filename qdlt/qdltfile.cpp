@@ -22,6 +22,8 @@
 #include <QFile>
 #include <QtDebug>
 
+#include <algorithm>
+
 #include "qdlt.h"
 
 extern "C"
@@ -31,6 +33,9 @@ extern "C"
 
 QDltFile::QDltFile()
 {
+    current = QDltFileSnapshot(new QDltFileIndex());
+    capture = 0;
+    captureDropped = 0;
     filterFlag = false;
     sortByTimeFlag = false;
     sortByTimestampFlag = false;
@@ -51,6 +56,43 @@ void QDltFile::clear()
         delete(files[num]);
     }
     files.clear();
+
+    QDltFileIndex *index = beginUpdate();
+    index->indexAll.clear();
+    index->blocks.clear();
+    endUpdate(index);
+}
+
+QDltFileSnapshot QDltFile::snapshot() const
+{
+    QMutexLocker locker(&mutexSnapshot);
+    return current;
+}
+
+void QDltFile::memoryUsage(QDltMemoryUsage &usage) const
+{
+    snapshot()->memoryUsage(usage);
+
+    if(capture)
+        usage.add(QString("Capture buffer"), capture->memorySize());
+}
+
+QDltFileIndex* QDltFile::beginUpdate()
+{
+    /* only one update at a time, readers keep using the published generation */
+    mutexUpdate.lock();
+    return new QDltFileIndex(*snapshot());
+}
+
+void QDltFile::endUpdate(QDltFileIndex *index)
+{
+    QDltFileSnapshot next(index);
+    {
+        QMutexLocker locker(&mutexSnapshot);
+        current.swap(next);
+    }
+    mutexUpdate.unlock();
+    /* the old generation is deleted with the last reader */
 }
 
 int QDltFile::getNumberOfFiles() const
@@ -58,6 +100,18 @@ int QDltFile::getNumberOfFiles() const
     return files.size();
 }
 
+void QDltFile::setBlockSummaries(const QVector<QDltBlockSummary> &blocks)
+{
+    QDltFileIndex *index = beginUpdate();
+    index->blocks = blocks;
+    endUpdate(index);
+}
+
+QVector<QDltBlockSummary> QDltFile::getBlockSummaries() const
+{
+    return snapshot()->blocks;
+}
+
 void QDltFile::setDltIndex(QVector<qint64> &_indexAll, int num)
 {
     if(num<0 || num>=files.size())
@@ -65,19 +119,26 @@ void QDltFile::setDltIndex(QVector<qint64> &_indexAll, int num)
         return;
     }
 
-    files[num]->indexAll = _indexAll;
+    QDltFileIndex *index = beginUpdate();
+    if(num < index->indexAll.size())
+        index->indexAll[num] = QDltIndexArray(_indexAll);
+    endUpdate(index);
 }
 
 int QDltFile::size() const
 {
-    int size=0;
-    for(int num=0;num<files.size();num++)
-    {
-      if (nullptr!=files[num])
-         size += files[num]->indexAll.size();
-    }
+    return snapshot()->size();
+}
 
-    return size;
+void QDltFile::setCapture(QDltCaptureBuffer *capture)
+{
+    this->capture = capture;
+    captureDropped = 0;
+
+    QDltFileIndex *index = beginUpdate();
+    index->captureFirst = capture ? capture->first() : 0;
+    index->captureSize = capture ? capture->size() : 0;
+    endUpdate(index);
 }
 
 qint64 QDltFile::fileSize() const
@@ -96,7 +157,7 @@ qint64 QDltFile::fileSize() const
 int QDltFile::sizeFilter() const
 {
     if(filterFlag)
-        return indexFilter.size();
+        return snapshot()->indexFilter.size();
     else
         return size();
 }
@@ -113,6 +174,10 @@ bool QDltFile::open(QString _filename, bool append)
     QDltFileItem *item = new QDltFileItem();
     files.append(item);
 
+    QDltFileIndex *index = beginUpdate();
+    index->indexAll.resize(files.size());
+    endUpdate(index);
+
     /* set new filename */
     item->infile.setFileName(_filename);
 
@@ -129,10 +194,13 @@ bool QDltFile::open(QString _filename, bool append)
 
 void QDltFile::clearIndex()
 {
-    for(int num=0;num<files.size();num++)
+    QDltFileIndex *index = beginUpdate();
+    for(int num=0;num<index->indexAll.size();num++)
     {
-        files[num]->indexAll.clear();
+        index->indexAll[num].clear();
     }
+    index->blocks.clear();
+    endUpdate(index);
 }
 
 bool QDltFile::createIndex()
@@ -159,6 +227,37 @@ bool QDltFile::updateIndex()
     qint64 pos = 0;
     quint16 last_message_length = 0;
 
+    /* the new messages are appended to a new generation of the indexes */
+    QDltFileIndex *index = beginUpdate();
+
+    if(capture)
+    {
+        /* the log files are not searched, the capture can have written its oldest messages to them */
+        qint64 first = capture->first();
+        captureDropped = (int) (first - index->captureFirst);
+        if(captureDropped > 0)
+        {
+            /* remove the dropped messages from the filter index and move the following ones */
+            int base = index->sizeFiles();
+            const QDltIndexArray &indexFilter = index->indexFilter;
+            QDltIndexArray rebased;
+            rebased.reserve(indexFilter.size());
+            for(int num = 0; num < indexFilter.size(); num++)
+            {
+                if(indexFilter[num] < base)
+                    rebased.append(indexFilter[num]);
+                else if(indexFilter[num] >= base + captureDropped)
+                    rebased.append(indexFilter[num] - captureDropped);
+            }
+            index->indexFilter = rebased;
+            index->foldsFilter.clear();
+        }
+        index->captureFirst = first;
+        index->captureSize = capture->size();
+        endUpdate(index);
+        return true;
+    }
+
     mutexQDlt.lock();
 
     for(int numFile=0;numFile<files.size();numFile++)
@@ -168,16 +267,17 @@ bool QDltFile::updateIndex()
         {
             qDebug() << "updateMsg: Infile is not open" << files[numFile]->infile.fileName() << __FILE__ << "line" << __LINE__;
             mutexQDlt.unlock();
+            endUpdate(index);
             return false;
         }
 
+        QDltIndexArray &indexAll = index->indexAll[numFile];
 
         /* start at last found position */
-        if(files[numFile]->indexAll.size())
+        if(indexAll.size())
         {
             /* move behind last found position */
-            const QVector<qint64>* const_indexAll = &(files[numFile]->indexAll);
-            pos = (*const_indexAll)[files[numFile]->indexAll.size()-1];
+            pos = indexAll.last();
 
             // read the first 18 bytes of last message to look for actual size
             files[numFile]->infile.seek(pos + 18);
@@ -241,7 +341,7 @@ bool QDltFile::updateIndex()
                         if(next_message_pos==file_size)
                         {
                             // last message found in file
-                            files[numFile]->indexAll.append(current_message_pos);
+                            indexAll.append(current_message_pos);
                             break;
                         }
                         // speed up move directly to next message, if inside current buffer
@@ -288,7 +388,7 @@ bool QDltFile::updateIndex()
                     else if( next_message_pos == (pos+num-3) )
                     {
                         // Add message only when it is in the correct position in relationship to the last message
-                        files[numFile]->indexAll.append(current_message_pos);
+                        indexAll.append(current_message_pos);
                         current_message_pos = pos+num-3;
                         counter_header = 1;
                         // speed up move directly to message length, if inside current buffer
@@ -327,6 +427,8 @@ bool QDltFile::updateIndex()
 
     mutexQDlt.unlock();
 
+    endUpdate(index);
+
     /* success */
     return true;
 }
@@ -335,7 +437,7 @@ bool QDltFile::updateIndex()
 bool QDltFile::createIndexFilter()
 {
     /* clear old index */
-    indexFilter.clear();
+    clearFilterIndex();
 
     return updateIndexFilter();
 }
@@ -344,29 +446,35 @@ bool QDltFile::updateIndexFilter()
 {
     QDltMsg msg;
     QByteArray buf;
-    int index;
+    int first;
+    QVector<int> found;
+
+    /* filter on a snapshot, other updates are not blocked while reading */
+    QDltFileSnapshot messages = snapshot();
 
     /* update index filter by starting from last found index in list */
 
     /* get lattest found index in filter list */
-    if(indexFilter.size()>0) {
-        index = indexFilter[indexFilter.size()-1] + 1;
+    if(messages->indexFilter.size()>0) {
+        first = messages->indexFilter.last() + 1;
     }
     else {
-        index = 0;
+        first = 0;
     }
 
-    for(int num=index;num<size();num++) {
-        buf = getMsg(num);
+    for(int num=first;num<messages->size();num++) {
+        buf = getMsg(*messages, num);
         if(!buf.isEmpty()) {
             msg.setMsg(buf);
             if(checkFilter(msg)) {
-                indexFilter.append(num);
+                found.append(num);
             }
         }
 
     }
 
+    addFilterIndexes(found);
+
     return true;
 }
 
@@ -393,14 +501,42 @@ void QDltFile::setFilterList(QDltFilterList &_filterList)
 void QDltFile::clearFilterIndex()
 {
     /* clear old index */
-    indexFilter.clear();
-
+    QDltFileIndex *index = beginUpdate();
+    index->indexFilter.clear();
+    index->foldsFilter.clear();
+    endUpdate(index);
 }
 
 void QDltFile::addFilterIndex (int index)
 {
-    indexFilter.append(index);
+    QDltFileIndex *next = beginUpdate();
+    next->indexFilter.append(index);
+    endUpdate(next);
+}
+
+void QDltFile::addFilterIndexes(const QVector<int> &indexes)
+{
+    if(indexes.isEmpty())
+        return;
+
+    /* the filter index must stay ascending, sort the positions first */
+    QVector<int> sorted = indexes;
+    std::sort(sorted.begin(), sorted.end());
+
+    int dropped = 0;
+    QDltFileIndex *next = beginUpdate();
+    for(int num=0;num<sorted.size();num++)
+    {
+        /* positions already in the filter index or before its end can not be added in order */
+        if(next->indexFilter.isEmpty() || sorted[num] > next->indexFilter.last())
+            next->indexFilter.append(sorted[num]);
+        else
+            dropped++;
+    }
+    endUpdate(next);
 
+    if(dropped > 0)
+        qDebug() << "addFilterIndexes:" << dropped << "positions not behind the end of the filter index dropped" << __FILE__ << __LINE__;
 }
 
 #ifdef USECOLOR
@@ -437,10 +573,11 @@ QString QDltFile::getFileName(int num)
 
 int QDltFile::getFileMsgNumber(int num) const
 {
-    if(num<0 || num>=files.size())
+    QDltFileSnapshot index = snapshot();
+    if(num<0 || num>=index->indexAll.size())
         return -1;
 
-    return files[num]->indexAll.size();
+    return index->indexAll[num].size();
 }
 
 void QDltFile::close()
@@ -450,6 +587,11 @@ void QDltFile::close()
 }
 
 QByteArray QDltFile::getMsg(int index) const
+{
+    return getMsg(*snapshot(), index);
+}
+
+QByteArray QDltFile::getMsg(const QDltFileIndex &messages, qint64 index) const
 {
     QByteArray buf;
     int num = 0;
@@ -464,15 +606,15 @@ QByteArray QDltFile::getMsg(int index) const
         return QByteArray();
     }
 
-    for( num=0; num < files.size(); num++ )
+    num = messages.findFile(index);
+
+    if(num >= messages.indexAll.size() && capture && index < messages.captureSize - messages.captureFirst)
     {
-        if(index < files[num]->indexAll.size())
-            break;
-        else
-            index -= files[num]->indexAll.size();
+        /* captured message */
+        return capture->getMsg(messages.captureFirst + index);
     }
 
-    if(num >= files.size())
+    if(num >= messages.indexAll.size() || num >= files.size())
     {
      qDebug() << "getMsg: Index is out of range in" << __FILE__ << "line" << __LINE__;
      /* return empty data buffer */
@@ -492,8 +634,8 @@ QByteArray QDltFile::getMsg(int index) const
     mutexQDlt.lock();
 
     QDltFileItem* file = files[num];
-    const QDltFileItem* const_file = file;
-    qint64 positionForIndex = const_file->indexAll[index];
+    const QDltIndexArray &indexAll = messages.indexAll[num];
+    qint64 positionForIndex = indexAll[index];
 
     /* move to file position selected by index */
     if ( false == file->infile.seek(positionForIndex) )
@@ -505,7 +647,7 @@ QByteArray QDltFile::getMsg(int index) const
     }
 
     /* read DLT message from file */
-    if(index == (file->indexAll.size()-1))
+    if(index == (indexAll.size()-1))
     {
         /* last message in file */
         long int cal_index = file->infile.size() - positionForIndex;
@@ -518,7 +660,7 @@ QByteArray QDltFile::getMsg(int index) const
     else
     {
         /* any other file position */
-        long int cal_index = const_file->indexAll[index+1] - positionForIndex;
+        long int cal_index = indexAll[index+1] - positionForIndex;
         if ( cal_index < 0 )
             qDebug() << "Negativ index " << cal_index << index << "in" << __LINE__ << "of" << __FILE__;
         else
@@ -541,49 +683,346 @@ bool QDltFile::getMsg(int index,QDltMsg &msg) const
     return msg.setMsg(data);
 }
 
+int QDltFile::getMsgRange(int index, int count, QByteArray &buffer, QVector<int> &offsets) const
+{
+    return getMsgRange(*snapshot(), index, count, buffer, offsets);
+}
+
+int QDltFile::getMsgRange(const QDltFileIndex &messages, int first, int count, QByteArray &buffer, QVector<int> &offsets) const
+{
+    int num = 0;
+    qint64 position = first;
+
+    offsets.clear();
+
+    /* check if index is in range */
+    if(first < 0 || count <= 0)
+    {
+        qDebug() << "getMsgRange: Index is out of range" << __FILE__ << "line" << __LINE__;
+        return 0;
+    }
+
+    num = messages.findFile(position);
+
+    if(num >= messages.indexAll.size() && capture && position < messages.captureSize - messages.captureFirst)
+    {
+        /* captured messages */
+        return capture->getMsgRange(messages.captureFirst + position, (int) qMin((qint64) count, messages.captureSize - messages.captureFirst - position), buffer, offsets);
+    }
+
+    if(num >= messages.indexAll.size() || num >= files.size())
+    {
+        qDebug() << "getMsgRange: Index is out of range in" << __FILE__ << "line" << __LINE__;
+        return 0;
+    }
+
+    int index = (int) position;
+    QDltFileItem* file = files[num];
+    const QDltIndexArray &indexAll = messages.indexAll[num];
+
+    /* check if file is already opened */
+    if(false == file->infile.isOpen())
+    {
+        qDebug() << "getMsgRange: Infile is not open" << file->infile.fileName() << __FILE__ << "line" << __LINE__;
+        return 0;
+    }
+
+    mutexQDlt.lock();
+
+    /* messages end at the next message, the last one at the end of the file */
+    qint64 fileSize = file->infile.size();
+    qint64 begin = indexAll[index];
+    count = qMin(count, indexAll.size() - index);
+    int last = 0;
+    for(last = 0; last < count; last++)
+    {
+        qint64 end = (index + last + 1 < indexAll.size()) ? indexAll[index + last + 1] : fileSize;
+        if(end < indexAll[index + last] || (last > 0 && end - begin > QDLT_FILE_RANGE_MAX_SIZE))
+            break;
+    }
+    count = last;
+    if(count == 0)
+    {
+        qDebug() << "getMsgRange: Negativ index" << index << "in" << file->infile.fileName() << __LINE__ << "of" << __FILE__;
+        mutexQDlt.unlock();
+        return 0;
+    }
+    qint64 end = (index + count < indexAll.size()) ? indexAll[index + count] : fileSize;
+
+    /* read all messages at once, the buffer keeps its capacity */
+    qint64 length = -1;
+    buffer.resize((int) (end - begin));
+    if(file->infile.seek(begin))
+        length = file->infile.read(buffer.data(), end - begin);
+    else
+        qDebug() << "Seek error on " << begin << file->infile.fileName() << __FILE__ << __LINE__;
+
+    mutexQDlt.unlock();
+
+    if(length < 0)
+    {
+        buffer.clear();
+        return 0;
+    }
+
+    /* only complete messages are returned after a short read */
+    for(int i = 0; i < count; i++)
+    {
+        qint64 next = (index + i + 1 < indexAll.size()) ? indexAll[index + i + 1] : fileSize;
+        if(next - begin > length)
+        {
+            count = i;
+            break;
+        }
+        offsets.append((int) (indexAll[index + i] - begin));
+    }
+    if(count == 0)
+        return 0;
+    offsets.append((int) (((index + count < indexAll.size()) ? indexAll[index + count] : fileSize) - begin));
+
+    return count;
+}
+
+bool QDltFile::getMsgs(const QVector<qint64> &indexes, QVector<QByteArray> &data) const
+{
+    bool ok = true;
+
+    data.clear();
+    data.resize(indexes.size());
+
+    QDltFileSnapshot messages = snapshot();
+
+    /* collect the ranges of the messages for each log file */
+    QVector<QVector<int> > requests(files.size());
+    QVector<QVector<qint64> > positions(files.size());
+    QVector<QVector<int> > sizes(files.size());
+    for(int i = 0; i < indexes.size(); i++)
+    {
+        qint64 index = indexes[i];
+        int num = index >= 0 ? messages->findFile(index) : 0;
+        if(index >= 0 && num >= messages->indexAll.size() && capture && index < messages->captureSize - messages->captureFirst)
+        {
+            /* captured messages are copied from memory */
+            data[i] = capture->getMsg(messages->captureFirst + index);
+            continue;
+        }
+        if(index < 0 || num >= messages->indexAll.size() || num >= files.size())
+        {
+            qDebug() << "getMsgs: Index is out of range" << indexes[i] << __FILE__ << "line" << __LINE__;
+            ok = false;
+            continue;
+        }
+
+        const QDltIndexArray &indexAll = messages->indexAll[num];
+        qint64 end = (index + 1 < indexAll.size()) ? indexAll[index + 1] : files[num]->infile.size();
+        if(end < indexAll[index])
+        {
+            qDebug() << "getMsgs: Negativ index" << index << "in" << files[num]->infile.fileName() << __LINE__ << "of" << __FILE__;
+            ok = false;
+            continue;
+        }
+        requests[num].append(i);
+        positions[num].append(indexAll[index]);
+        sizes[num].append((int) (end - indexAll[index]));
+    }
+
+    /* the reader has its own file handles, so the reads do not need the file lock */
+    for(int num = 0; num < files.size(); num++)
+    {
+        if(requests[num].isEmpty())
+            continue;
+
+        QDltFileReader reader;
+        QVector<QByteArray> result;
+        if(!reader.open(files[num]->infile.fileName()))
+        {
+            qDebug() << "getMsgs: Cannot open" << files[num]->infile.fileName() << reader.errorString();
+            ok = false;
+            continue;
+        }
+        if(!reader.readBatch(positions[num], sizes[num], result))
+            ok = false;
+        for(int i = 0; i < requests[num].size(); i++)
+            data[requests[num][i]] = result[i];
+    }
+
+    return ok;
+}
+
+QDltFileIterator::QDltFileIterator(const QDltFile *file, Mode mode)
+{
+    this->file = file;
+    messages = file->snapshot();
+    useIndexes = (mode == FilteredMessages && file->isFilter());
+    if(useIndexes)
+        indexes = messages->indexFilter;
+    current = -1;
+    blockBegin = 0;
+    blockEnd = 0;
+    blockFirst = 0;
+}
+
+QDltFileIterator::QDltFileIterator(const QDltFile *file, const QVector<qint64> &indexes)
+{
+    this->file = file;
+    messages = file->snapshot();
+    this->indexes = QDltIndexArray(indexes);
+    useIndexes = true;
+    current = -1;
+    blockBegin = 0;
+    blockEnd = 0;
+    blockFirst = 0;
+}
+
+int QDltFileIterator::size() const
+{
+    return useIndexes ? indexes.size() : messages->size();
+}
+
+bool QDltFileIterator::seek(int position)
+{
+    if(position < 0 || position >= size())
+    {
+        current = qBound(-1, position, size());
+        return false;
+    }
+
+    current = position;
+    if(current >= blockBegin && current < blockEnd)
+        return true;
+
+    if(current == blockBegin - 1)
+    {
+        /* moving backwards, the block ends with the message */
+        int start = current;
+        qint64 last = indexAt(current);
+        while(start > 0)
+        {
+            qint64 previous = indexAt(start - 1);
+            if(previous >= indexAt(start) || indexAt(start) - previous > QDLT_FILE_ITERATOR_MAX_GAP || last - previous >= QDLT_FILE_ITERATOR_BLOCK_MESSAGES)
+                break;
+            start--;
+        }
+        readBlock(start);
+
+        /* the block may end early at the end of a log file */
+        if(current < blockEnd)
+            return true;
+    }
+
+    readBlock(current);
+
+    return true;
+}
+
+qint64 QDltFileIterator::index() const
+{
+    if(current < 0 || current >= size())
+        return -1;
+
+    return indexAt(current);
+}
+
+QByteArray QDltFileIterator::data() const
+{
+    if(current < 0 || current >= size() || current < blockBegin || current >= blockEnd || offsets.isEmpty())
+        return QByteArray();
+
+    /* the message is inside of the block, it is returned without copy */
+    int num = (int) (indexAt(current) - blockFirst);
+    return QByteArray::fromRawData(buffer.constData() + offsets[num], offsets[num + 1] - offsets[num]);
+}
+
+bool QDltFileIterator::getMsg(QDltMsg &msg) const
+{
+    QByteArray data = this->data();
+
+    if(data.isEmpty())
+        return false;
+
+    return msg.setMsg(data);
+}
+
+void QDltFileIterator::readBlock(int position)
+{
+    /* extend the block as long as the next message follows closely */
+    qint64 first = indexAt(position);
+    qint64 last = first;
+    int end = position + 1;
+    while(end < size())
+    {
+        qint64 next = indexAt(end);
+        if(next <= last || next - last > QDLT_FILE_ITERATOR_MAX_GAP || next - first >= QDLT_FILE_ITERATOR_BLOCK_MESSAGES)
+            break;
+        last = next;
+        end++;
+    }
+
+    int count = file->getMsgRange(*messages, (int) first, (int) (last - first + 1), buffer, offsets);
+
+    blockBegin = position;
+    blockFirst = first;
+    if(count <= 0)
+    {
+        /* broken message, it is returned empty */
+        offsets.clear();
+        blockEnd = position + 1;
+        return;
+    }
+
+    /* the range can end early at the end of a log file or the size limit */
+    blockEnd = position + 1;
+    while(blockEnd < end && indexAt(blockEnd) < first + count)
+        blockEnd++;
+}
+
 QByteArray QDltFile::getMsgFilter(int index) const
 {
+    QDltFileSnapshot messages = snapshot();
+
     if(filterFlag)
     {
         /* check if index is in range */
-        if(index<0 || index>=indexFilter.size())
+        if(index<0 || index>=messages->indexFilter.size())
         {
           qDebug() << "getMsg: Index is out of range" << __FILE__ << "line" << __LINE__;
           /* return empty data buffer */
            return QByteArray();
         }
-        return getMsg(indexFilter[index]);
+        return getMsg(*messages, messages->indexFilter[index]);
     }
     else
     {
         /* check if index is in range */
-        if(index<0 || index>=size())
+        if(index<0 || index>=messages->size())
         {
-         qDebug() << "getMsg: Index" << index << "is out of range" << size() << __FILE__ << "line" << __LINE__;
+         qDebug() << "getMsg: Index" << index << "is out of range" << messages->size() << __FILE__ << "line" << __LINE__;
          /* return empty data buffer */
          return QByteArray();
         }
-        return getMsg(index);
+        return getMsg(*messages, index);
     }
 }
 
 int QDltFile::getMsgFilterPos(int index) const
 {
+    QDltFileSnapshot messages = snapshot();
+
     if(filterFlag)
     {
         /* check if index is in range */
-        if(index<0 || index>=indexFilter.size())
+        if(index<0 || index>=messages->indexFilter.size())
         {
         //qDebug() << "getMsg: Index is out of range" << __FILE__ << "line" << __LINE__;
-        qDebug() << "getMsg: Index" << index << "is out of range" << indexFilter.size() << __FILE__ << "line" << __LINE__;
+        qDebug() << "getMsg: Index" << index << "is out of range" << messages->indexFilter.size() << __FILE__ << "line" << __LINE__;
         /* return invalid */
         return -1;
         }
-        return indexFilter[index];
+        return messages->indexFilter[index];
     }
     else {
         /* check if index is in range */
-        if(index<0 || index>=size())
+        if(index<0 || index>=messages->size())
         {
          qDebug() << "getMsg: Index is out of range" << __FILE__ << "line" << __LINE__;
         /* return invalid */
@@ -630,10 +1069,78 @@ void QDltFile::enableSortByTimestamp(bool state)
 
 QVector<qint64> QDltFile::getIndexFilter() const
 {
-    return indexFilter;
+    return snapshot()->indexFilter.toVector();
 }
 
 void QDltFile::setIndexFilter(QVector<qint64> _indexFilter)
 {
-    indexFilter = _indexFilter;
+    QDltFileIndex *index = beginUpdate();
+    index->indexFilter = QDltIndexArray(_indexFilter);
+    index->foldsFilter.clear();
+    endUpdate(index);
+}
+
+void QDltFile::setIndexFilterFolds(const QHash<qint64,QVector<qint64> > &_foldsFilter)
+{
+    QDltFileIndex *index = beginUpdate();
+    index->foldsFilter = _foldsFilter;
+    endUpdate(index);
+}
+
+int QDltFile::getIndexFilterFoldCount() const
+{
+    return snapshot()->foldsFilter.size();
+}
+
+int QDltFile::getFoldCount(int index) const
+{
+    QDltFileSnapshot messages = snapshot();
+    if(!filterFlag || messages->foldsFilter.isEmpty() || index<0 || index>=messages->indexFilter.size())
+        return 1;
+
+    QHash<qint64,QVector<qint64> >::const_iterator it = messages->foldsFilter.constFind(messages->indexFilter[index]);
+    if(it == messages->foldsFilter.constEnd())
+        return 1;
+
+    return 1 + it.value().size();
+}
+
+QVector<qint64> QDltFile::getFold(int index) const
+{
+    QDltFileSnapshot messages = snapshot();
+    if(!filterFlag || index<0 || index>=messages->indexFilter.size())
+        return QVector<qint64>();
+
+    return messages->foldsFilter.value(messages->indexFilter[index]);
+}
+
+int QDltFile::expandFold(int index)
+{
+    if(!filterFlag)
+        return 0;
+
+    QDltFileIndex *next = beginUpdate();
+    const QDltIndexArray &indexFilter = next->indexFilter;
+    QVector<qint64> fold;
+    if(index>=0 && index<indexFilter.size())
+        fold = next->foldsFilter.take(indexFilter[index]);
+    if(fold.isEmpty())
+    {
+        endUpdate(next);
+        return 0;
+    }
+
+    /* rebuild the index once instead of inserting row by row */
+    QDltIndexArray expanded;
+    expanded.reserve(indexFilter.size() + fold.size());
+    for(int num = 0; num <= index; num++)
+        expanded.append(indexFilter[num]);
+    for(int num = 0; num < fold.size(); num++)
+        expanded.append(fold[num]);
+    for(int num = index + 1; num < indexFilter.size(); num++)
+        expanded.append(indexFilter[num]);
+    next->indexFilter = expanded;
+    endUpdate(next);
+
+    return fold.size();
 }
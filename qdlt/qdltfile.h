@@ -31,26 +31,36 @@
 #include <QColor>
 #endif
 #include <QMutex>
+#include <QHash>
+#include <QVector>
 #include <time.h>
 
+#include "qdltcapturebuffer.h"
+#include "qdltfileindex.h"
+
+/* maximum number of bytes read at once by getMsgRange() */
+#define QDLT_FILE_RANGE_MAX_SIZE (4*1024*1024)
+
+/* maximum number of messages in one block of QDltFileIterator */
+#define QDLT_FILE_ITERATOR_BLOCK_MESSAGES 4096
+
+/* maximum distance of two iterated messages read in the same block */
+#define QDLT_FILE_ITERATOR_MAX_GAP 16
+
 class QDLT_EXPORT QDltFileItem
 {
 public:
     //! DLT log file.
     QFile infile;
 
-    //! Index of all DLT messages.
-    /*!
-      Index contains positions of beginning of DLT messages in DLT log file.
-    */
-    QVector<qint64> indexAll;
-
 };
 
 //! Access to a DLT log file.
 /*!
   This class provide access to DLT log file.
-  This class is currently not thread safe.
+  The indexes are published as generations, see snapshot(). Reading
+  messages is possible from several threads, while one thread updates
+  the indexes. Opening and closing files is not thread safe.
 */
 class QDLT_EXPORT QDltFile : public QDlt
 {
@@ -107,6 +117,15 @@ public:
     */
     void setDltIndex(QVector<qint64> &_indexAll, int num = 0);
 
+    //! Sets the summaries of blocks of messages, used to skip blocks in filters and search.
+    /*!
+      \param blocks Summary of each QDLT_BLOCK_SUMMARY_SIZE messages, beginning with the first message
+    */
+    void setBlockSummaries(const QVector<QDltBlockSummary> &blocks);
+
+    //! Get the summaries of blocks of messages, empty if not available.
+    QVector<QDltBlockSummary> getBlockSummaries() const;
+
     //! Clears the internal index of all DLT messages.
     /*!
     */
@@ -124,6 +143,19 @@ public:
     */
     bool updateIndex();
 
+    //! Show the messages of a capture buffer behind the messages of the log files.
+    /*!
+      While a capture is set, updateIndex() does not search the log files for new
+      messages, but takes the new messages of the capture. Messages dropped by the
+      capture are removed from the filter index and the following positions move.
+      \param capture Capture buffer, 0 to show only the log files
+    */
+    void setCapture(QDltCaptureBuffer *capture);
+    QDltCaptureBuffer* getCapture() const { return capture; }
+
+    //! Number of captured messages dropped at the last updateIndex().
+    int getCaptureDropped() const { return captureDropped; }
+
     //! Create an internal index of all filtered DLT messages of the currently opened DLT log file.
     /*!
       \return true if the operation was successful, false if an error occurred.
@@ -152,6 +184,26 @@ public:
     */
     QByteArray getMsg(int index) const;
 
+    //! Get consecutive DLT messages with one read
+    /*!
+      The range ends at the end of the log file containing the first message
+      and is limited to QDLT_FILE_RANGE_MAX_SIZE bytes, but contains at least one message.
+      \param index position of the first DLT message
+      \param count number of DLT messages
+      \param buffer filled with the DLT messages, can be reused to avoid allocations
+      \param offsets filled with the offset of each DLT message in the buffer and the end of the last one
+      \return number of DLT messages read, 0 if an error occurred.
+    */
+    int getMsgRange(int index, int count, QByteArray &buffer, QVector<int> &offsets) const;
+
+    //! Get several DLT messages at any positions with reads in flight at the same time
+    /*!
+      \param indexes positions of the DLT messages in the log file
+      \param data filled with the DLT messages, empty if a message could not be read
+      \return false if an error occurred.
+    */
+    bool getMsgs(const QVector<qint64> &indexes, QVector<QByteArray> &data) const;
+
     //! Get one DLT message of the filtered DLT log file selected by index
     /*!
       \param index position of the DLT message in the log file up to the number of DLT messages in the file
@@ -237,6 +289,15 @@ public:
     */
     void addFilterIndex (int index);
 
+    //! Add positions to the filter index in one update.
+    /*!
+      The positions are sorted before they are added. Positions which are
+      not behind the last position of the filter index are dropped, so the
+      filter index stays ascending.
+      \param indexes The positions of the messages in the allIndex to be added
+    */
+    void addFilterIndexes(const QVector<int> &indexes);
+
     //! Check if message will be marked.
     /*!
       Colours used are:
@@ -279,20 +340,79 @@ public:
      **/
     void setIndexFilter(QVector<qint64> _indexFilter);
 
+    //! Set the repetitions folded into rows of the filter index
+    /*!
+     * Set after setIndexFilter(), which deletes all folds.
+     * \param _foldsFilter Folded message positions, key is the position of the message shown in the row
+     **/
+    void setIndexFilterFolds(const QHash<qint64,QVector<qint64> > &_foldsFilter);
+
+    //! Get the number of messages represented by a row of the filter index
+    /*!
+     * \param index Row in the filter index
+     * \return 1 if the row is not folded, 1 + number of folded repetitions otherwise
+     **/
+    int getFoldCount(int index) const;
+
+    //! Get the number of folded rows in the filter index
+    int getIndexFilterFoldCount() const;
+
+    //! Get the positions of the repetitions folded into a row of the filter index
+    /*!
+     * \param index Row in the filter index
+     * \return List of message positions, empty if the row is not folded
+     **/
+    QVector<qint64> getFold(int index) const;
+
+    //! Expand the repetitions folded into a row of the filter index
+    /*!
+     * The folded messages are inserted as own rows behind the row.
+     * \param index Row in the filter index
+     * \return number of inserted rows
+     **/
+    int expandFold(int index);
+
+    //! Get the current generation of the indexes
+    /*!
+     * The generation is never changed, updates of the indexes publish
+     * a new generation. Work on the snapshot to see consistent indexes
+     * without locking out the updates.
+     **/
+    QDltFileSnapshot snapshot() const;
+
+    //! Add the bytes used by the indexes and the capture buffer.
+    void memoryUsage(QDltMemoryUsage &usage) const;
+
+    //! Get consecutive DLT messages of a generation of the indexes, see getMsgRange().
+    int getMsgRange(const QDltFileIndex &messages, int index, int count, QByteArray &buffer, QVector<int> &offsets) const;
+
 protected:
 
 private:
+    QByteArray getMsg(const QDltFileIndex &messages, qint64 index) const;
+
+    //! Copy the current generation of the indexes to be changed, blocks other updates.
+    QDltFileIndex* beginUpdate();
+
+    //! Publish the changed generation of the indexes.
+    void endUpdate(QDltFileIndex *index);
+
     //! Mutex to lock critical path for infile
     mutable QMutex mutexQDlt;
 
-    //!all files including indexes
-    QList<QDltFileItem*> files;
+    //! Current generation of the indexes, the mutex is only held to copy the pointer.
+    QDltFileSnapshot current;
+    mutable QMutex mutexSnapshot;
 
-    //! Index of all DLT messages matching filter.
-    /*!
-      Index contains positions of DLT messages in indexAll.
-    */
-    QVector<qint64> indexFilter;
+    //! Mutex to serialise updates of the indexes.
+    QMutex mutexUpdate;
+
+    //! Captured messages, shown behind the messages of the log files.
+    QDltCaptureBuffer *capture;
+    int captureDropped;
+
+    //!all files
+    QList<QDltFileItem*> files;
 
     //! This contains the list of filters.
     QDltFilterList filterList;
@@ -319,5 +439,73 @@ private:
     bool sortByTimestampFlag;
 };
 
+//! Iterates over the messages of a DLT log file.
+/*!
+  Neighbouring messages are read in blocks with one read by
+  QDltFile::getMsgRange(), so a pass over many messages does not
+  need a seek and read for each message. The data of a message
+  is only valid until the next block is read.
+  The iterator is placed before the first message, next() must be
+  called before the first message can be accessed.
+  The iterator works on the generation of the indexes, which was
+  current when it was created.
+*/
+class QDLT_EXPORT QDltFileIterator
+{
+public:
+    typedef enum { AllMessages, FilteredMessages } Mode;
+
+    //! Iterate over all messages or over the messages of the filter index.
+    /*!
+      FilteredMessages iterates over all messages, if the filter is disabled,
+      like QDltFile::getMsgFilter().
+    */
+    QDltFileIterator(const QDltFile *file, Mode mode = AllMessages);
+
+    //! Iterate over a list of message positions.
+    QDltFileIterator(const QDltFile *file, const QVector<qint64> &indexes);
+
+    //! Number of iterated messages.
+    int size() const;
+
+    //! Move to a position of the iteration, the block is only read if it does not contain the message.
+    /*!
+      Moving to the position before the block reads the block ending with the message,
+      so iterating backwards reads blocks of messages too.
+    */
+    bool seek(int position);
+
+    //! Move to the next message.
+    bool next() { return seek(current + 1); }
+
+    //! Current position of the iteration, the row for filtered messages.
+    int position() const { return current; }
+
+    //! Position of the current message in the log file.
+    qint64 index() const;
+
+    //! Data of the current message, empty if the message could not be read.
+    QByteArray data() const;
+
+    //! Parse the current message.
+    bool getMsg(QDltMsg &msg) const;
+
+private:
+    qint64 indexAt(int position) const { return useIndexes ? indexes[position] : position; }
+    void readBlock(int position);
+
+    const QDltFile *file;
+    QDltFileSnapshot messages;
+    QDltIndexArray indexes;
+    bool useIndexes;
+    int current;
+
+    QByteArray buffer;
+    QVector<int> offsets;
+    int blockBegin;     /* first position and first message index of the block */
+    int blockEnd;
+    qint64 blockFirst;
+};
+
 
 #endif // QDLT_FILE_H
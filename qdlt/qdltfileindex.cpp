@@ -0,0 +1,150 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltfileindex.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <cstring>
+
+#include "qdltfileindex.h"
+
+QDltIndexArray::Storage::Storage(int capacity)
+{
+    data = new qint64[capacity];
+    this->capacity = capacity;
+}
+
+QDltIndexArray::Storage::~Storage()
+{
+    delete[] data;
+}
+
+QDltIndexArray::QDltIndexArray()
+{
+    count = 0;
+}
+
+QDltIndexArray::QDltIndexArray(const QVector<qint64> &values)
+{
+    count = 0;
+    if(values.isEmpty())
+        return;
+
+    grow(values.size());
+    memcpy(storage->data, values.constData(), values.size() * sizeof(qint64));
+    storage->used.storeRelease(values.size());
+    count = values.size();
+}
+
+void QDltIndexArray::grow(int capacity)
+{
+    /* copies keep the old storage, only values of this array are taken */
+    QSharedPointer<Storage> larger(new Storage(qMax(capacity, QDLT_INDEX_ARRAY_MIN_CAPACITY)));
+    if(count > 0)
+        memcpy(larger->data, storage->data, count * sizeof(qint64));
+    larger->used.storeRelease(count);
+    storage = larger;
+}
+
+void QDltIndexArray::append(qint64 value)
+{
+    /* write behind the end of all copies, otherwise copy the storage */
+    if(!storage || count >= storage->capacity || !storage->used.testAndSetOrdered(count, count + 1))
+    {
+        grow(count * 2);
+        storage->used.storeRelease(count + 1);
+    }
+    storage->data[count++] = value;
+}
+
+void QDltIndexArray::reserve(int capacity)
+{
+    if(!storage || capacity > storage->capacity)
+        grow(capacity);
+}
+
+void QDltIndexArray::clear()
+{
+    storage.clear();
+    count = 0;
+}
+
+QVector<qint64> QDltIndexArray::toVector() const
+{
+    QVector<qint64> values(count);
+    if(count > 0)
+        memcpy(values.data(), storage->data, count * sizeof(qint64));
+    return values;
+}
+
+QDltIndexArray QDltIndexArray::mid(int position, int length) const
+{
+    QDltIndexArray values;
+    if(position < 0 || position >= count)
+        return values;
+    if(length < 0 || position + length > count)
+        length = count - position;
+
+    values.grow(length);
+    memcpy(values.storage->data, storage->data + position, length * sizeof(qint64));
+    values.storage->used.storeRelease(length);
+    values.count = length;
+    return values;
+}
+
+qint64 QDltIndexArray::memorySize() const
+{
+    return storage ? (qint64) storage->capacity * sizeof(qint64) : 0;
+}
+
+QDltFileIndex::QDltFileIndex()
+{
+    captureFirst = 0;
+    captureSize = 0;
+}
+
+int QDltFileIndex::sizeFiles() const
+{
+    int size = 0;
+    for(int num = 0; num < indexAll.size(); num++)
+        size += indexAll[num].size();
+    return size;
+}
+
+int QDltFileIndex::findFile(qint64 &index) const
+{
+    int num = 0;
+    for(num = 0; num < indexAll.size(); num++)
+    {
+        if(index < indexAll[num].size())
+            break;
+        index -= indexAll[num].size();
+    }
+    return num;
+}
+
+void QDltFileIndex::memoryUsage(QDltMemoryUsage &usage) const
+{
+    qint64 bytes = 0;
+    for(int num = 0; num < indexAll.size(); num++)
+        bytes += indexAll[num].memorySize();
+    usage.add(QString("File index"), bytes);
+
+    bytes = indexFilter.memorySize() + QDltMemoryUsage::of(foldsFilter);
+    for(QHash<qint64,QVector<qint64> >::const_iterator it = foldsFilter.constBegin(); it != foldsFilter.constEnd(); ++it)
+        bytes += QDltMemoryUsage::of(it.value());
+    usage.add(QString("Filter index"), bytes);
+
+    usage.add(QString("Block summaries"), QDltMemoryUsage::of(blocks));
+}
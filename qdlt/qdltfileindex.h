@@ -0,0 +1,132 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltfileindex.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTFILEINDEX_H
+#define QDLTFILEINDEX_H
+
+#include <QVector>
+#include <QHash>
+#include <QAtomicInt>
+#include <QSharedPointer>
+
+#include "export_rules.h"
+#include "qdltmemoryusage.h"
+#include "qdltblocksummary.h"
+
+#define QDLT_INDEX_ARRAY_MIN_CAPACITY 1024
+
+//! Append only array of message positions, which can be shared between threads.
+/*!
+  Copies of an array share the storage. Appending to an array writes
+  behind the end of all copies, so the copies still see their values
+  without a lock. The storage is only copied when it is full, or when
+  another copy has already appended to it. Only one thread may append
+  to copies of the same array at the same time.
+*/
+class QDLT_EXPORT QDltIndexArray
+{
+public:
+    QDltIndexArray();
+    QDltIndexArray(const QVector<qint64> &values);
+
+    int size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    qint64 operator[](int index) const { return storage->data[index]; }
+    qint64 last() const { return storage->data[count - 1]; }
+
+    void append(qint64 value);
+    void reserve(int capacity);
+    void clear();
+
+    QVector<qint64> toVector() const;
+    QDltIndexArray mid(int position, int length = -1) const;
+
+    //! Bytes of the storage, which may be shared with copies.
+    qint64 memorySize() const;
+
+private:
+    class Storage
+    {
+    public:
+        Storage(int capacity);
+        ~Storage();
+
+        qint64 *data;
+        int capacity;
+        QAtomicInt used;    /* values written by all copies */
+    };
+
+    void grow(int capacity);
+
+    QSharedPointer<Storage> storage;
+    int count;
+};
+
+//! One generation of the message indexes of a QDltFile.
+/*!
+  A generation is never changed after it is published by QDltFile.
+  Readers keep a reference to the generation they work on, while
+  updates of the indexes publish a new generation.
+*/
+class QDLT_EXPORT QDltFileIndex
+{
+public:
+    QDltFileIndex();
+
+    //! Number of messages in all log files and the capture.
+    int size() const { return sizeFiles() + (int) (captureSize - captureFirst); }
+
+    //! Number of messages in all log files.
+    int sizeFiles() const;
+
+    //! Find the log file of a message.
+    /*!
+      \param index Position of the message, changed to the position in the log file
+      \return number of the log file, the number of log files if the message is captured
+    */
+    int findFile(qint64 &index) const;
+
+    //! Add the bytes used by the indexes.
+    void memoryUsage(QDltMemoryUsage &usage) const;
+
+    //! Positions of the beginning of the messages in each log file.
+    QVector<QDltIndexArray> indexAll;
+
+    //! Positions of the messages matching the filter.
+    QDltIndexArray indexFilter;
+
+    //! Repetitions folded into rows of the filter index.
+    /*!
+      Key is the position of the message shown in the row.
+    */
+    QHash<qint64,QVector<qint64> > foldsFilter;
+
+    //! Summaries of blocks of QDLT_BLOCK_SUMMARY_SIZE messages of the log files.
+    /*!
+      Empty if not available. Messages behind the last summarised message
+      are not covered, the last block may be smaller.
+    */
+    QVector<QDltBlockSummary> blocks;
+
+    //! Range of captured messages shown behind the log files.
+    qint64 captureFirst;
+    qint64 captureSize;
+};
+
+typedef QSharedPointer<const QDltFileIndex> QDltFileSnapshot;
+
+#endif // QDLTFILEINDEX_H
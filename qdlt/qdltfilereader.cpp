@@ -0,0 +1,219 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltfilereader.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QRunnable>
+#include <QDebug>
+
+#include "qdltfilereader.h"
+
+class QDltFileReaderRequest
+{
+public:
+    QDltFileReaderRequest(qint64 pos, int size) : pos(pos), size(size), result(0), done(false) { }
+
+    qint64 pos;
+    int size;
+    QByteArray data;
+    qint64 result;
+    bool done;
+};
+
+class QDltFileReaderTask : public QRunnable
+{
+public:
+    QDltFileReaderTask(QDltFileReader *reader, const QSharedPointer<QDltFileReaderRequest> &request)
+        : reader(reader), request(request) { }
+
+    void run()
+    {
+        reader->execute(*request);
+    }
+
+private:
+    QDltFileReader *reader;
+    QSharedPointer<QDltFileReaderRequest> request;
+};
+
+QDltFileReader::QDltFileReader(int depth)
+{
+    this->depth = qMax(1, depth);
+    fileSize = 0;
+    aheadPos = 0;
+    segmentSize = 0;
+    pool.setMaxThreadCount(this->depth);
+}
+
+QDltFileReader::~QDltFileReader()
+{
+    close();
+}
+
+bool QDltFileReader::open(const QString &fileName)
+{
+    close();
+
+    /* one handle for each read in flight, so no seek position is shared */
+    for(int num = 0; num < depth; num++)
+    {
+        QFile *file = new QFile(fileName);
+        if(!file->open(QIODevice::ReadOnly))
+        {
+            error = file->errorString();
+            delete file;
+            close();
+            return false;
+        }
+        handles.append(file);
+    }
+
+    this->fileName = fileName;
+    fileSize = handles[0]->size();
+    freeHandles = handles;
+    error.clear();
+
+    return true;
+}
+
+void QDltFileReader::close()
+{
+    pool.waitForDone();
+    ahead.clear();
+
+    qDeleteAll(handles);
+    handles.clear();
+    freeHandles.clear();
+    fileSize = 0;
+}
+
+void QDltFileReader::seek(qint64 pos, int segmentSize)
+{
+    /* reads in flight keep their request until they are done */
+    ahead.clear();
+    aheadPos = pos;
+    this->segmentSize = segmentSize;
+}
+
+qint64 QDltFileReader::read(QByteArray &data, qint64 &pos)
+{
+    data.clear();
+    pos = aheadPos;
+
+    if(!isOpen() || segmentSize <= 0)
+        return -1;
+
+    fill();
+    QSharedPointer<QDltFileReaderRequest> request = ahead.dequeue();
+
+    /* keep the next segments in flight while this one is processed */
+    fill();
+
+    wait(request);
+
+    pos = request->pos;
+    data = request->data;
+
+    if(request->result < 0)
+        qDebug() << "Reading" << fileName << "at position" << request->pos << "failed";
+
+    return request->result;
+}
+
+bool QDltFileReader::readBatch(const QVector<qint64> &positions, const QVector<int> &sizes, QVector<QByteArray> &data)
+{
+    data.clear();
+    data.resize(positions.size());
+
+    if(!isOpen() || positions.size() != sizes.size())
+        return false;
+
+    QVector<QSharedPointer<QDltFileReaderRequest> > requests;
+    requests.reserve(positions.size());
+    for(int num = 0; num < positions.size(); num++)
+    {
+        QSharedPointer<QDltFileReaderRequest> request(new QDltFileReaderRequest(positions[num], sizes[num]));
+        requests.append(request);
+        submit(request);
+    }
+
+    bool ok = true;
+    for(int num = 0; num < requests.size(); num++)
+    {
+        wait(requests[num]);
+        if(requests[num]->result < 0)
+            ok = false;
+        else
+            data[num] = requests[num]->data;
+    }
+
+    return ok;
+}
+
+void QDltFileReader::fill()
+{
+    while(ahead.size() < depth)
+    {
+        /* one request behind the end is enough to report the end */
+        if(!ahead.isEmpty() && ahead.last()->pos >= fileSize)
+            break;
+
+        QSharedPointer<QDltFileReaderRequest> request(new QDltFileReaderRequest(aheadPos, segmentSize));
+        ahead.enqueue(request);
+        submit(request);
+        aheadPos += segmentSize;
+    }
+}
+
+void QDltFileReader::submit(const QSharedPointer<QDltFileReaderRequest> &request)
+{
+    pool.start(new QDltFileReaderTask(this, request));
+}
+
+void QDltFileReader::execute(QDltFileReaderRequest &request)
+{
+    mutex.lock();
+    while(freeHandles.isEmpty())
+        condition.wait(&mutex);
+    QFile *file = freeHandles.takeLast();
+    mutex.unlock();
+
+    QByteArray data;
+    qint64 result = -1;
+    if(request.pos >= 0 && request.size >= 0 && file->seek(request.pos))
+    {
+        data.resize(request.size);
+        result = file->read(data.data(), request.size);
+        if(result >= 0)
+            data.resize((int) result);
+        else
+            data.clear();
+    }
+
+    mutex.lock();
+    freeHandles.append(file);
+    request.data = data;
+    request.result = result;
+    request.done = true;
+    condition.wakeAll();
+    mutex.unlock();
+}
+
+void QDltFileReader::wait(const QSharedPointer<QDltFileReaderRequest> &request)
+{
+    QMutexLocker locker(&mutex);
+    while(!request->done)
+        condition.wait(&mutex);
+}
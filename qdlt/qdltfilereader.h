@@ -0,0 +1,118 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltfilereader.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTFILEREADER_H
+#define QDLTFILEREADER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QQueue>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QThreadPool>
+#include <QSharedPointer>
+
+#include "export_rules.h"
+
+/* default number of reads in flight */
+#define QDLT_FILE_READER_DEPTH 4
+
+class QDltFileReaderRequest;
+
+//! Reads a file with several reads in flight.
+/*!
+  Every read in flight uses its own file handle and runs in a
+  thread pool owned by the reader, so reading overlaps with the
+  processing of data already read and slow storage is accessed
+  with several requests at the same time.
+
+  Sequential reading returns segments in file order while the
+  following segments are already read ahead. Batch reading reads
+  a list of ranges, for example the messages of a selection.
+
+  The reader itself is used from one thread.
+*/
+class QDLT_EXPORT QDltFileReader
+{
+public:
+    QDltFileReader(int depth = QDLT_FILE_READER_DEPTH);
+    ~QDltFileReader();
+
+    //! Open the file for reading.
+    bool open(const QString &fileName);
+
+    //! Wait for all reads in flight and close the file.
+    void close();
+
+    bool isOpen() const { return !handles.isEmpty(); }
+    QString errorString() const { return error; }
+
+    //! Size of the file when it was opened.
+    qint64 size() const { return fileSize; }
+
+    //! Start sequential reading at a position.
+    /*!
+      Segments read ahead from an earlier position are dropped.
+      \param pos Position of the first segment
+      \param segmentSize Size of each segment
+    */
+    void seek(qint64 pos, int segmentSize);
+
+    //! Take the next segment, waits until it is read.
+    /*!
+      \param data Filled with the data of the segment
+      \param pos Set to the file position of the segment
+      \return Number of bytes, 0 at the end of the file, -1 on error
+    */
+    qint64 read(QByteArray &data, qint64 &pos);
+
+    //! Read several ranges at once, waits until all reads are done.
+    /*!
+      \param positions File positions of the ranges
+      \param sizes Sizes of the ranges
+      \param data Filled with the data of each range, shorter at the end of the file
+      \return false if a read failed
+    */
+    bool readBatch(const QVector<qint64> &positions, const QVector<int> &sizes, QVector<QByteArray> &data);
+
+private:
+    friend class QDltFileReaderTask;
+
+    void submit(const QSharedPointer<QDltFileReaderRequest> &request);
+    void execute(QDltFileReaderRequest &request);
+    void wait(const QSharedPointer<QDltFileReaderRequest> &request);
+    void fill();
+
+    int depth;
+    QString fileName;
+    QString error;
+    qint64 fileSize;
+
+    QVector<QFile*> handles;
+    QVector<QFile*> freeHandles;
+    QMutex mutex;
+    QWaitCondition condition;
+    QThreadPool pool;
+
+    QQueue<QSharedPointer<QDltFileReaderRequest> > ahead;
+    qint64 aheadPos;
+    int segmentSize;
+};
+
+#endif // QDLTFILEREADER_H
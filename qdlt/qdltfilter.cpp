@@ -20,6 +20,8 @@
  */
 
 #include <QtDebug>
+#include <cstring>
+#include <limits>
 
 #include "qdlt.h"
 
@@ -70,9 +72,17 @@ QDltFilter& QDltFilter::operator= (QDltFilter const& _filter)
     enableLogLevelMin = _filter.enableLogLevelMin;
     enableMarker = _filter.enableMarker;
     enableMessageId=_filter.enableMessageId;
+    enableTime = _filter.enableTime;
+    enableTimestamp = _filter.enableTimestamp;
+    enableArgument = _filter.enableArgument;
 
     messageIdMax=_filter.messageIdMax;
     messageIdMin=_filter.messageIdMin;
+    timeMin = _filter.timeMin;
+    timeMax = _filter.timeMax;
+    timestampMin = _filter.timestampMin;
+    timestampMax = _filter.timestampMax;
+    argumentFilter = _filter.argumentFilter;
     filterColour = _filter.filterColour;
     logLevelMax = _filter.logLevelMax;
     logLevelMin = _filter.logLevelMin;
@@ -83,6 +93,10 @@ QDltFilter& QDltFilter::operator= (QDltFilter const& _filter)
     contextRegularExpression = _filter.contextRegularExpression;
     appidRegularExpression   = _filter.appidRegularExpression;
 
+    // only valid for the filter list which assigned them
+    headerPatternIndex = -1;
+    payloadPatternIndex = -1;
+
     return *this;
 }
 
@@ -116,12 +130,240 @@ void QDltFilter::clear()
     enableLogLevelMin = false;
     enableMarker = false;
     enableRegexSearchReplace = false;
+    enableTime = false;
+    enableTimestamp = false;
+    enableArgument = false;
 
     filterColour = "#000000"; // QColor() default contructor initializes to an invalid color RGB 0,0,0
     logLevelMax = 6;
     logLevelMin = 0;
     messageIdMax=0;
     messageIdMin=0;
+    timeMin = 0;
+    timeMax = 0;
+    timestampMin = 0;
+    timestampMax = 0;
+    argumentFilter.clear();
+
+    headerPatternIndex = -1;
+    payloadPatternIndex = -1;
+}
+
+QDltFilterMatchContext::QDltFilterMatchContext(QDltMsg &msg, const QDltMultiPattern *headerPatterns, const QDltMultiPattern *payloadPatterns)
+    : msg(msg)
+    , headerPatterns(headerPatterns)
+    , payloadPatterns(payloadPatterns)
+    , headerDone(false)
+    , payloadDone(false)
+{
+}
+
+bool QDltFilterMatchContext::headerMatch(int index)
+{
+    if(!headerDone)
+    {
+        headerPatterns->match(msg.toStringHeader(), headerHits);
+        headerDone = true;
+    }
+    return headerHits.testBit(index);
+}
+
+bool QDltFilterMatchContext::payloadMatch(int index)
+{
+    if(!payloadDone)
+    {
+        payloadPatterns->match(msg.toStringPayload(), payloadHits);
+        payloadDone = true;
+    }
+    return payloadHits.testBit(index);
+}
+
+template <typename T> static int compareValues(T a, T b)
+{
+    return (a < b) ? -1 : ((b < a) ? 1 : 0);
+}
+
+QDltArgumentFilter::QDltArgumentFilter()
+{
+    clear();
+}
+
+void QDltArgumentFilter::clear()
+{
+    setArgument(QString("0"));
+    comparison = Equal;
+    setValue(QString());
+}
+
+void QDltArgumentFilter::setArgument(const QString &indexOrName)
+{
+    bool ok;
+    argument = indexOrName;
+    index = indexOrName.toInt(&ok);
+    if(!ok || index < 0)
+        index = -1;
+}
+
+void QDltArgumentFilter::setValue(const QString &value)
+{
+    QString text = value.trimmed();
+
+    this->value = value;
+    valueText = value.toUtf8();
+
+    /* integers above the signed range are only kept as unsigned value */
+    if(text.startsWith("0x", Qt::CaseInsensitive))
+    {
+        valueUnsigned = text.mid(2).toULongLong(&valueIsUnsigned, 16);
+        valueIsInteger = valueIsUnsigned && valueUnsigned <= (quint64) std::numeric_limits<qint64>::max();
+        valueInteger = valueIsInteger ? (qint64) valueUnsigned : 0;
+    }
+    else
+    {
+        valueInteger = text.toLongLong(&valueIsInteger);
+        if(valueIsInteger)
+        {
+            valueIsUnsigned = valueInteger >= 0;
+            valueUnsigned = valueIsUnsigned ? (quint64) valueInteger : 0;
+        }
+        else
+        {
+            valueUnsigned = text.toULongLong(&valueIsUnsigned);
+        }
+    }
+
+    if(text == QString("true") || text == QString("false"))
+    {
+        valueInteger = (text == QString("true")) ? 1 : 0;
+        valueUnsigned = valueInteger;
+        valueIsInteger = true;
+        valueIsUnsigned = true;
+    }
+
+    if(valueIsInteger)
+    {
+        valueNumber = valueInteger;
+        valueIsNumber = true;
+    }
+    else if(valueIsUnsigned)
+    {
+        valueNumber = valueUnsigned;
+        valueIsNumber = true;
+    }
+    else
+    {
+        valueNumber = text.toDouble(&valueIsNumber);
+    }
+}
+
+QString QDltArgumentFilter::comparisonText(Comparison comparison)
+{
+    switch(comparison)
+    {
+    case Equal:
+        return QString("==");
+    case NotEqual:
+        return QString("!=");
+    case Less:
+        return QString("<");
+    case LessEqual:
+        return QString("<=");
+    case Greater:
+        return QString(">");
+    case GreaterEqual:
+        return QString(">=");
+    }
+    return QString();
+}
+
+bool QDltArgumentFilter::match(const QDltMsg &msg) const
+{
+    const QList<QDltArgument> &arguments = msg.getArguments();
+
+    if(index >= 0)
+        return index < arguments.size() && matchArgument(arguments.at(index));
+
+    for(int num = 0; num < arguments.size(); num++)
+    {
+        if(arguments.at(num).getName() == argument)
+            return matchArgument(arguments.at(num));
+    }
+
+    return false;
+}
+
+bool QDltArgumentFilter::matchArgument(const QDltArgument &argument) const
+{
+    qint64 signedValue;
+    quint64 unsignedValue;
+    double floatValue;
+    int result;
+
+    switch(argument.getTypeInfo())
+    {
+    case QDltArgument::DltTypeInfoBool:
+    case QDltArgument::DltTypeInfoSInt:
+        if(!argument.getSigned(signedValue))
+            return false;
+        if(valueIsInteger)
+            result = compareValues(signedValue, valueInteger);
+        else if(valueIsUnsigned)
+            result = -1; /* value above the signed range */
+        else if(valueIsNumber)
+            result = compareValues((double) signedValue, valueNumber);
+        else
+            return false;
+        break;
+    case QDltArgument::DltTypeInfoUInt:
+        if(!argument.getUnsigned(unsignedValue))
+            return false;
+        if(valueIsUnsigned)
+            result = compareValues(unsignedValue, valueUnsigned);
+        else if(valueIsInteger)
+            result = 1; /* negative value */
+        else if(valueIsNumber)
+            result = compareValues((double) unsignedValue, valueNumber);
+        else
+            return false;
+        break;
+    case QDltArgument::DltTypeInfoFloa:
+        /* not a number does not match any comparison */
+        if(!valueIsNumber || !argument.getFloat(floatValue) || floatValue != floatValue)
+            return false;
+        result = compareValues(floatValue, valueNumber);
+        break;
+    case QDltArgument::DltTypeInfoStrg:
+    case QDltArgument::DltTypeInfoUtf8:
+    {
+        /* the data includes the terminating zero */
+        QByteArray data = argument.getData();
+        int size = data.size();
+        while(size > 0 && data.at(size - 1) == 0)
+            size--;
+        result = memcmp(data.constData(), valueText.constData(), qMin(size, valueText.size()));
+        result = result ? compareValues(result, 0) : compareValues(size, valueText.size());
+        break;
+    }
+    default:
+        return false;
+    }
+
+    switch(comparison)
+    {
+    case Equal:
+        return result == 0;
+    case NotEqual:
+        return result != 0;
+    case Less:
+        return result < 0;
+    case LessEqual:
+        return result <= 0;
+    case Greater:
+        return result > 0;
+    case GreaterEqual:
+        return result >= 0;
+    }
+    return false;
 }
 
 bool QDltFilter::isMarker() const
@@ -162,6 +404,24 @@ bool QDltFilter::compileRegexps()
 
 bool QDltFilter::match(QDltMsg &msg) const
 {
+    return match(msg, 0);
+}
+
+bool QDltFilter::match(QDltMsg &msg, QDltFilterMatchContext *context) const
+{
+    if(enableTime)
+    {
+        qint64 time = (qint64) msg.getTime() * 1000000 + msg.getMicroseconds();
+        if(time < timeMin || time > timeMax)
+        {
+            return false;
+        }
+    }
+
+    if(enableTimestamp && (msg.getTimestamp() < timestampMin || msg.getTimestamp() > timestampMax))
+    {
+        return false;
+    }
 
     if( (true == enableEcuid) && (msg.getEcuid() != ecuid))
     {
@@ -199,6 +459,11 @@ bool QDltFilter::match(QDltMsg &msg) const
         }
     }
 
+    if(enableArgument && !argumentFilter.match(msg))
+    {
+        return false;
+    }
+
     if(true == enableRegexp_Header)
     {
         if( (true == enableHeader) && ( false == headerRegularExpression.match(msg.toStringHeader()).hasMatch() ) )
@@ -206,6 +471,13 @@ bool QDltFilter::match(QDltMsg &msg) const
             return false;
         }
     }
+    else if( context && headerPatternIndex >= 0 )
+    {
+        if( ( true == enableHeader ) && ( false == context->headerMatch(headerPatternIndex) ) )
+        {
+            return false;
+        }
+    }
     else
     {
         if( ( true == enableHeader ) && ( false == msg.toStringHeader().contains(header,ignoreCase_Header?Qt::CaseInsensitive:Qt::CaseSensitive)) )
@@ -221,6 +493,13 @@ bool QDltFilter::match(QDltMsg &msg) const
             return false;
         }
     }
+    else if( context && payloadPatternIndex >= 0 )
+    {
+        if( (true == enablePayload) && ( false == context->payloadMatch(payloadPatternIndex) ) )
+        {
+            return false;
+        }
+    }
     else
     {
         if( (true == enablePayload) && ( false == msg.toStringPayload().contains(payload,ignoreCase_Payload?Qt::CaseInsensitive:Qt::CaseSensitive)) )
@@ -384,6 +663,18 @@ void QDltFilter::LoadFilterItem(QXmlStreamReader &xml)
     {
           enableRegexSearchReplace = xml.readElementText().toInt();;
     }
+    if(xml.name() == QString("enableTime"))
+    {
+          enableTime = xml.readElementText().toInt();
+    }
+    if(xml.name() == QString("enableTimestamp"))
+    {
+          enableTimestamp = xml.readElementText().toInt();
+    }
+    if(xml.name() == QString("enableArgument"))
+    {
+          enableArgument = xml.readElementText().toInt();
+    }
     if(xml.name() == QString("filterColour"))
     {
           filterColour = xml.readElementText();
@@ -404,6 +695,34 @@ void QDltFilter::LoadFilterItem(QXmlStreamReader &xml)
     {
           messageIdMin = xml.readElementText().toUInt();
     }
+    if(xml.name() == QString("timeMin"))
+    {
+          timeMin = xml.readElementText().toLongLong();
+    }
+    if(xml.name() == QString("timeMax"))
+    {
+          timeMax = xml.readElementText().toLongLong();
+    }
+    if(xml.name() == QString("timestampMin"))
+    {
+          timestampMin = xml.readElementText().toUInt();
+    }
+    if(xml.name() == QString("timestampMax"))
+    {
+          timestampMax = xml.readElementText().toUInt();
+    }
+    if(xml.name() == QString("argument"))
+    {
+          argumentFilter.setArgument(xml.readElementText());
+    }
+    if(xml.name() == QString("argumentComparison"))
+    {
+          argumentFilter.setComparison((QDltArgumentFilter::Comparison)(xml.readElementText().toInt()));
+    }
+    if(xml.name() == QString("argumentValue"))
+    {
+          argumentFilter.setValue(xml.readElementText());
+    }
 
 }
 
@@ -421,6 +740,13 @@ void QDltFilter::SaveFilterItem(QXmlStreamWriter &xml)
     xml.writeTextElement("regex_replace",regex_replace);
     xml.writeTextElement("messageIdMin",QString("%1").arg(messageIdMin));
     xml.writeTextElement("messageIdMax",QString("%1").arg(messageIdMax));
+    xml.writeTextElement("timeMin",QString("%1").arg(timeMin));
+    xml.writeTextElement("timeMax",QString("%1").arg(timeMax));
+    xml.writeTextElement("timestampMin",QString("%1").arg(timestampMin));
+    xml.writeTextElement("timestampMax",QString("%1").arg(timestampMax));
+    xml.writeTextElement("argument",argumentFilter.getArgument());
+    xml.writeTextElement("argumentComparison",QString("%1").arg((int)(argumentFilter.getComparison())));
+    xml.writeTextElement("argumentValue",argumentFilter.getValue());
 
     xml.writeTextElement("enableregexp_Appid",QString("%1").arg(enableRegexp_Appid));
     xml.writeTextElement("enableregexp_Context",QString("%1").arg(enableRegexp_Context));
@@ -440,6 +766,9 @@ void QDltFilter::SaveFilterItem(QXmlStreamWriter &xml)
     xml.writeTextElement("enableMarker",QString("%1").arg(enableMarker));
     xml.writeTextElement("enableMessageId",QString("%1").arg(enableMessageId));
     xml.writeTextElement("enableRegexSearchReplace",QString("%1").arg(enableRegexSearchReplace));
+    xml.writeTextElement("enableTime",QString("%1").arg(enableTime));
+    xml.writeTextElement("enableTimestamp",QString("%1").arg(enableTimestamp));
+    xml.writeTextElement("enableArgument",QString("%1").arg(enableArgument));
 
     xml.writeTextElement("filterColour",filterColour);
 
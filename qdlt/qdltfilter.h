@@ -32,8 +32,93 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QRegularExpression>
+#include <QBitArray>
 #include "export_rules.h"
 
+class QDltMultiPattern;
+
+//! Results of the multi pattern search for one message.
+/*!
+  All filters of a filter list share the search, which is only
+  done when the first filter needs the header or payload text.
+*/
+class QDLT_EXPORT QDltFilterMatchContext
+{
+public:
+    QDltFilterMatchContext(QDltMsg &msg, const QDltMultiPattern *headerPatterns, const QDltMultiPattern *payloadPatterns);
+
+    //! Check if the header pattern with the index was found.
+    bool headerMatch(int index);
+
+    //! Check if the payload pattern with the index was found.
+    bool payloadMatch(int index);
+
+private:
+    QDltMsg &msg;
+    const QDltMultiPattern *headerPatterns;
+    const QDltMultiPattern *payloadPatterns;
+    QBitArray headerHits;
+    QBitArray payloadHits;
+    bool headerDone;
+    bool payloadDone;
+};
+
+//! Comparison of the value of one argument of a message.
+/*!
+  The argument is selected by its index or by its name. Numbers are
+  compared with the raw data of the argument, strings with its bytes,
+  so the argument is never converted to a string. Decoded non verbose
+  messages are compared with the arguments set by the decoder.
+*/
+class QDLT_EXPORT QDltArgumentFilter
+{
+public:
+
+    typedef enum { Equal = 0, NotEqual, Less, LessEqual, Greater, GreaterEqual } Comparison;
+
+    QDltArgumentFilter();
+
+    //! Reset all values to default values
+    void clear();
+
+    //! Select the argument by its index starting with 0, or by its name.
+    void setArgument(const QString &indexOrName);
+    QString getArgument() const { return argument; }
+
+    void setComparison(Comparison comparison) { this->comparison = comparison; }
+    Comparison getComparison() const { return comparison; }
+
+    //! Set the value, which is a number or a text depending on the type of the argument.
+    /*!
+      Integers can be given in hex with the prefix "0x", bool values as "true" or "false".
+    */
+    void setValue(const QString &value);
+    QString getValue() const { return value; }
+
+    //! Text of a comparison, e.g. ">=".
+    static QString comparisonText(Comparison comparison);
+
+    //! Check if the selected argument of the message exists and its value matches.
+    bool match(const QDltMsg &msg) const;
+
+private:
+    bool matchArgument(const QDltArgument &argument) const;
+
+    QString argument;
+    int index;              /* -1 if the argument is selected by its name */
+    Comparison comparison;
+    QString value;
+
+    // generated from the value
+    bool valueIsInteger;
+    qint64 valueInteger;
+    bool valueIsUnsigned;
+    quint64 valueUnsigned;
+    bool valueIsNumber;
+    double valueNumber;
+    QByteArray valueText;
+};
+
 
 class QDLT_EXPORT QDltFilter
 {
@@ -72,6 +157,9 @@ public:
     bool enableMarker;
     bool enableMessageId;
     bool enableRegexSearchReplace;
+    bool enableTime;
+    bool enableTimestamp;
+    bool enableArgument;
 
     QString filterColour;
     int logLevelMax;
@@ -79,12 +167,28 @@ public:
     unsigned int messageIdMax;
     unsigned int messageIdMin;
 
+    // time window of the storage header time in microseconds since epoch, both inclusive
+    qint64 timeMin;
+    qint64 timeMax;
+
+    // range of the timestamp in 0.1 milliseconds, both inclusive
+    unsigned int timestampMin;
+    unsigned int timestampMax;
+
+    // comparison of the value of one argument
+    QDltArgumentFilter argumentFilter;
+
     // generated from header and payload string
     QRegularExpression headerRegularExpression;
     QRegularExpression payloadRegularExpression;
     QRegularExpression contextRegularExpression;
     QRegularExpression appidRegularExpression;
 
+    // index of the plain header and payload text in the multi pattern search
+    // of the filter list, -1 if the text is searched by the filter itself
+    int headerPatternIndex;
+    int payloadPatternIndex;
+
     //! Constructor.
     /*!
     */
@@ -131,6 +235,14 @@ public:
     */
     bool match(QDltMsg &msg) const;
 
+    //! Check if filter matches, using the shared search of plain texts.
+    /*!
+      \param msg The message to be checked
+      \param context Search results of the filter list, can be 0
+      \return true if filter matches the message, else false
+    */
+    bool match(QDltMsg &msg, QDltFilterMatchContext *context) const;
+
     //! Save filter parameters in XML file.
     /*!
     */
@@ -88,11 +88,13 @@ QColor QDltFilterList::checkMarker(QDltMsg &msg)
     QDltFilter *filter;
     QColor color;
 
+    QDltFilterMatchContext context(msg, &headerPatterns, &payloadPatterns);
+
     for(int numfilter=0;numfilter<mfilters.size();numfilter++)
     {
         filter = mfilters[numfilter];
 
-        if(filter->match(msg))
+        if(filter->match(msg, &context))
         {
             color = filter->filterColour;
             break;
@@ -106,11 +108,13 @@ QString QDltFilterList::checkMarker(QDltMsg &msg)
     QDltFilter *filter;
     QString color=DEFAULT_COLOR;
 
+    QDltFilterMatchContext context(msg, &headerPatterns, &payloadPatterns);
+
     for(int numfilter=0;numfilter<mfilters.size();numfilter++)
     {
         filter = mfilters[numfilter];
 
-        if(filter->match(msg))
+        if(filter->match(msg, &context))
         {
             color = filter->filterColour;
             break;
@@ -126,6 +130,7 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
     QDltFilter *filter;
     bool found = false;
     bool filterActivated = false;
+    QDltFilterMatchContext context(msg, &headerPatterns, &payloadPatterns);
 
     /* If there are no positive filters, or all positive filters
      * are disabled, the default case is to show all messages. Only
@@ -142,7 +147,7 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
     for(int numfilter=0;numfilter<pfilters.size();numfilter++)
     {
         filter = pfilters[numfilter];
-        found = filter->match(msg);
+        found = filter->match(msg, &context);
         if (found)
           break;
     }
@@ -156,7 +161,7 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
         for(int numfilter=0;numfilter<nfilters.size();numfilter++)
         {
             filter = nfilters[numfilter];
-            if (filter->match(msg))
+            if (filter->match(msg, &context))
             {
                 // a negative filter has matched -> found = false
                 found = false;
@@ -168,6 +173,21 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
     return found;
 }
 
+bool QDltFilterList::mayMatch(const QDltBlockSummary &block, bool decoded) const
+{
+    /* without positive filters all messages are shown, except the negative ones */
+    if(pfilters.isEmpty())
+        return true;
+
+    for(int numfilter=0;numfilter<pfilters.size();numfilter++)
+    {
+        if(block.mayMatch(*pfilters[numfilter], decoded))
+            return true;
+    }
+
+    return false;
+}
+
 bool QDltFilterList::SaveFilter(QString _filename)
 {
     QFile file(_filename);
@@ -319,4 +339,37 @@ void QDltFilterList::updateSortedFilter()
         }
     }
 
+    /* search the plain texts of all enabled filters in one pass */
+    headerPatterns.clear();
+    payloadPatterns.clear();
+
+    int headerCount = 0;
+    int payloadCount = 0;
+    for(int numfilter=0;numfilter<filters.size();numfilter++)
+    {
+        filter = filters[numfilter];
+        if(filter->enableFilter && filter->enableHeader && !filter->enableRegexp_Header)
+            headerCount++;
+        if(filter->enableFilter && filter->enablePayload && !filter->enableRegexp_Payload)
+            payloadCount++;
+    }
+
+    for(int numfilter=0;numfilter<filters.size();numfilter++)
+    {
+        filter = filters[numfilter];
+        filter->headerPatternIndex = -1;
+        filter->payloadPatternIndex = -1;
+
+        if(!filter->enableFilter)
+            continue;
+
+        if(headerCount >= QDLT_FILTER_LIST_MIN_PATTERNS && filter->enableHeader && !filter->enableRegexp_Header)
+            filter->headerPatternIndex = headerPatterns.addPattern(filter->header, filter->ignoreCase_Header ? Qt::CaseInsensitive : Qt::CaseSensitive);
+        if(payloadCount >= QDLT_FILTER_LIST_MIN_PATTERNS && filter->enablePayload && !filter->enableRegexp_Payload)
+            filter->payloadPatternIndex = payloadPatterns.addPattern(filter->payload, filter->ignoreCase_Payload ? Qt::CaseInsensitive : Qt::CaseSensitive);
+    }
+
+    headerPatterns.compile();
+    payloadPatterns.compile();
+
 }
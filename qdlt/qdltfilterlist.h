@@ -35,6 +35,13 @@
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
+#include "qdltmultipattern.h"
+#include "qdltblocksummary.h"
+
+/* minimum number of plain text header or payload filters,
+   for which the texts are searched together */
+#define QDLT_FILTER_LIST_MIN_PATTERNS 2
+
 class QDLT_EXPORT QDltFilterList
 {
 public:
@@ -96,6 +103,14 @@ public:
     */
     bool checkFilter(QDltMsg &msg);
 
+    //! Check if a message of a block may match the filter.
+    /*!
+      \param block Summary of the block of messages
+      \param decoded true if the messages are decoded by decoder plugins before filtering
+      \return false if no message of the block will be displayed
+    */
+    bool mayMatch(const QDltBlockSummary &block, bool decoded) const;
+
     //! Save the filter.
     /*!
     */
@@ -136,6 +151,10 @@ private:
     //! List of nfilters.
     QList<QDltFilter*> nfilters;
 
+    //! Plain header and payload texts of all enabled filters.
+    QDltMultiPattern headerPatterns;
+    QDltMultiPattern payloadPatterns;
+
 };
 
 #endif // QDLT_FILTER_LIST_H
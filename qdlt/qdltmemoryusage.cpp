@@ -0,0 +1,67 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmemoryusage.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "qdltmemoryusage.h"
+
+void QDltMemoryUsage::add(const QString &subsystem, qint64 bytes)
+{
+    for(int num = 0; num < items.size(); num++)
+    {
+        if(items[num].first == subsystem)
+        {
+            items[num].second += bytes;
+            return;
+        }
+    }
+    items.append(qMakePair(subsystem, bytes));
+}
+
+qint64 QDltMemoryUsage::total() const
+{
+    qint64 sum = 0;
+    for(int num = 0; num < items.size(); num++)
+        sum += items[num].second;
+    return sum;
+}
+
+qint64 QDltMemoryUsage::bytes(const QString &subsystem) const
+{
+    for(int num = 0; num < items.size(); num++)
+    {
+        if(items[num].first == subsystem)
+            return items[num].second;
+    }
+    return 0;
+}
+
+QStringList QDltMemoryUsage::report() const
+{
+    QStringList lines;
+    for(int num = 0; num < items.size(); num++)
+        lines.append(QString("%1: %2").arg(items[num].first).arg(toString(items[num].second)));
+    lines.append(QString("Total: %1").arg(toString(total())));
+    return lines;
+}
+
+QString QDltMemoryUsage::toString(qint64 bytes)
+{
+    if(bytes >= 1024 * 1024)
+        return QString("%1 MB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+    if(bytes >= 1024)
+        return QString("%1 kB").arg(bytes / 1024.0, 0, 'f', 1);
+    return QString("%1 B").arg(bytes);
+}
@@ -0,0 +1,83 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmemoryusage.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTMEMORYUSAGE_H
+#define QDLTMEMORYUSAGE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QList>
+#include <QHash>
+#include <QMap>
+#include <QPair>
+
+#include "export_rules.h"
+
+//! Bytes used by the indexes and caches of each subsystem.
+/*!
+  The subsystems add their estimated memory use, which is the size
+  of the allocated containers without the allocator overhead. The
+  report is shown in the UI and written to the log in silent mode.
+*/
+class QDLT_EXPORT QDltMemoryUsage
+{
+public:
+    //! Add the bytes used by a subsystem, bytes of the same subsystem are summed up.
+    void add(const QString &subsystem, qint64 bytes);
+
+    //! Bytes used by all subsystems.
+    qint64 total() const;
+
+    //! Bytes used by a subsystem.
+    qint64 bytes(const QString &subsystem) const;
+
+    //! One line per subsystem and the total, e.g. "Filter index: 12.5 MB".
+    QStringList report() const;
+
+    //! Format a number of bytes, e.g. "12.5 MB".
+    static QString toString(qint64 bytes);
+
+    //! Estimated bytes of the containers.
+    template<typename T> static qint64 of(const QVector<T> &vector)
+    {
+        return (qint64) vector.capacity() * sizeof(T);
+    }
+
+    template<typename T> static qint64 of(const QList<T> &list)
+    {
+        /* QList stores pointers, large or static types are allocated on their own */
+        return (qint64) list.size() * (sizeof(void*) + (QTypeInfo<T>::isLarge || QTypeInfo<T>::isStatic ? sizeof(T) : 0));
+    }
+
+    template<typename K, typename T> static qint64 of(const QMap<K,T> &map)
+    {
+        /* node with parent, left and right pointer */
+        return (qint64) map.size() * (3 * sizeof(void*) + sizeof(K) + sizeof(T));
+    }
+
+    template<typename K, typename T> static qint64 of(const QHash<K,T> &hash)
+    {
+        /* node with next pointer and hash value, one bucket per node */
+        return (qint64) hash.size() * (2 * sizeof(void*) + sizeof(uint) + sizeof(K) + sizeof(T));
+    }
+
+private:
+    QList<QPair<QString,qint64> > items;
+};
+
+#endif // QDLTMEMORYUSAGE_H
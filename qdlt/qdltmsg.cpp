@@ -104,37 +104,12 @@ QString QDltMsg::getCtrlReturnTypeString() const
 }
 QString QDltMsg::getTimeString() const
 {
-    char strtime[256];
-    struct tm *time_tm;
-    time_tm = localtime(&time);
-    if(time_tm)
-        strftime(strtime, 256, "%Y/%m/%d %H:%M:%S", time_tm);
-    return QString(strtime);
+    return QDltTimeFormatter::localTimeString(time);
 }
 
 QString QDltMsg::getGmTimeWithOffsetString(qlonglong offset, bool dst)
 {
-    struct tm *time_tm;
-    time_tm = gmtime(&time);
-
-    /*Reason for adding:
-        tm_mon	months since January	0-11
-        tm_year	years since 1900
-    */
-    QDate date(time_tm->tm_year+1900,time_tm->tm_mon+1,time_tm->tm_mday);
-    QTime time(time_tm->tm_hour,time_tm->tm_min,time_tm->tm_sec);
-
-    if(!date.isValid() || !time.isValid())
-        return QString("Invalid date");
-
-    QDateTime gmDateTime(date,time,Qt::UTC);
-
-    gmDateTime = gmDateTime.addSecs(offset);
-
-    if(dst)
-       gmDateTime = gmDateTime.addSecs(3600);
-
-    return gmDateTime.toString("yyyy/MM/dd hh:mm:ss");
+    return QDltTimeFormatter::gmTimeWithOffsetString(time, offset, dst);
 }
 
 
@@ -191,8 +166,8 @@ bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader)
     /* store header size */
     headerSize = headersize;
 
-    /* copy header */
-    header = buf.mid(0,headersize);
+    /* copy header, also when buf has no payload and refers to a shared block */
+    header = QByteArray(buf.constData(),headersize);
 
     /* load standard header extra parameters and Extended header if used */
     if (extra_size>0)
@@ -500,12 +475,19 @@ void QDltMsg::removeArgument(int index)
 
 
 QString QDltMsg::toStringHeader() const
+{
+    QDltTimeFormatter formatter;
+    return toStringHeader(formatter);
+}
+
+QString QDltMsg::toStringHeader(QDltTimeFormatter &formatter) const
 {
     QString text;
     text.reserve(1024);
 
-    text += QString("%1.%2").arg(getTimeString()).arg(getMicroseconds(),6,10,QLatin1Char('0'));
-    text += QString(" %1.%2").arg(getTimestamp()/10000).arg(getTimestamp()%10000,4,10,QLatin1Char('0'));
+    text += formatter.time(getTime(), getMicroseconds());
+    text += QLatin1Char(' ');
+    text += QDltTimeFormatter::timestamp(getTimestamp());
     text += QString(" %1").arg(getMessageCounter());
     text += QString(" %1").arg(getEcuid());
     text += QString(" %1").arg(getApid());
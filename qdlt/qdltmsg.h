@@ -31,6 +31,7 @@
 #include <time.h>
 
 #include "export_rules.h"
+#include "qdlttimeformatter.h"
 
 //! Access to a DLT message.
 /*!
@@ -404,6 +405,12 @@ public:
     */
     bool getArgument(int index,QDltArgument &argument) const;
 
+    //! Get all arguments from the DLT message without copying them.
+    /*!
+      \return The list of arguments, empty if the payload is not parsed.
+    */
+    const QList<QDltArgument> &getArguments() const { return arguments; }
+
     //! Add an argument to the argument list.
     /*!
       \param argument the argument to be added.
@@ -448,6 +455,13 @@ public:
     */
     QString toStringHeader() const;
 
+    //! Print Header into a string.
+    /*!
+      \param formatter Formatter of the time, which caches the formatted seconds.
+      \return The header string.
+    */
+    QString toStringHeader(QDltTimeFormatter &formatter) const;
+
     //! Print Payload content into a string.
     /*!
       \return The payload string.
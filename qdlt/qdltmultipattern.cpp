@@ -0,0 +1,239 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmultipattern.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QMap>
+#include <QQueue>
+
+#include "qdltmultipattern.h"
+
+QDltMultiPattern::QDltMultiPattern()
+{
+    patternCount = 0;
+}
+
+void QDltMultiPattern::clear()
+{
+    caseSensitive.clear();
+    caseInsensitive.clear();
+    emptyPatterns.clear();
+    patternCount = 0;
+}
+
+int QDltMultiPattern::addPattern(const QString &pattern, Qt::CaseSensitivity cs)
+{
+    int index = patternCount++;
+
+    if(pattern.isEmpty())
+        emptyPatterns.append(index);
+    else if(cs == Qt::CaseSensitive)
+        caseSensitive.add(pattern, index);
+    else
+        caseInsensitive.add(pattern.toCaseFolded(), index);
+
+    return index;
+}
+
+void QDltMultiPattern::compile()
+{
+    caseSensitive.compile();
+    caseInsensitive.compile();
+}
+
+void QDltMultiPattern::match(const QString &text, QBitArray &hits) const
+{
+    if(hits.size() != patternCount)
+        hits.resize(patternCount);
+    hits.fill(false);
+
+    for(int num = 0; num < emptyPatterns.size(); num++)
+        hits.setBit(emptyPatterns[num]);
+
+    if(!caseSensitive.isEmpty())
+        caseSensitive.match(text, false, hits);
+    if(!caseInsensitive.isEmpty())
+        caseInsensitive.match(text, true, hits);
+}
+
+QDltMultiPattern::Automaton::Automaton()
+{
+    clear();
+}
+
+void QDltMultiPattern::Automaton::clear()
+{
+    patterns.clear();
+    nodes.clear();
+    edges.clear();
+    outputs.clear();
+    for(int num = 0; num < 256; num++)
+        rootTable[num] = -1;
+}
+
+void QDltMultiPattern::Automaton::add(const QString &pattern, int index)
+{
+    patterns.append(qMakePair(pattern, index));
+}
+
+void QDltMultiPattern::Automaton::compile()
+{
+    /* build the trie, children sorted by character */
+    QVector<QMap<ushort,int> > children;
+    QVector<QVector<int> > ends;
+    children.append(QMap<ushort,int>());
+    ends.append(QVector<int>());
+
+    for(int num = 0; num < patterns.size(); num++)
+    {
+        const QString &pattern = patterns[num].first;
+        int state = 0;
+        for(int pos = 0; pos < pattern.size(); pos++)
+        {
+            ushort c = pattern.at(pos).unicode();
+            QMap<ushort,int>::const_iterator it = children[state].constFind(c);
+            if(it != children[state].constEnd())
+            {
+                state = it.value();
+            }
+            else
+            {
+                int node = children.size();
+                children.append(QMap<ushort,int>());
+                ends.append(QVector<int>());
+                children[state].insert(c, node);
+                state = node;
+            }
+        }
+        ends[state].append(patterns[num].second);
+    }
+
+    /* flatten nodes and edges */
+    nodes.resize(children.size());
+    edges.clear();
+    outputs.clear();
+    for(int num = 0; num < children.size(); num++)
+    {
+        Node &node = nodes[num];
+        node.fail = 0;
+        node.outputLink = -1;
+        node.firstEdge = edges.size();
+        node.edgeCount = children[num].size();
+        for(QMap<ushort,int>::const_iterator it = children[num].constBegin(); it != children[num].constEnd(); ++it)
+        {
+            Edge edge;
+            edge.c = it.key();
+            edge.target = it.value();
+            edges.append(edge);
+        }
+        node.firstPattern = outputs.size();
+        node.patternCount = ends[num].size();
+        outputs += ends[num];
+    }
+
+    for(int num = 0; num < 256; num++)
+        rootTable[num] = -1;
+    for(int num = 0; num < nodes[0].edgeCount; num++)
+    {
+        const Edge &edge = edges[nodes[0].firstEdge + num];
+        if(edge.c < 256)
+            rootTable[edge.c] = edge.target;
+    }
+
+    /* failure and output links in breadth first order */
+    QQueue<int> queue;
+    for(int num = 0; num < nodes[0].edgeCount; num++)
+        queue.enqueue(edges[nodes[0].firstEdge + num].target);
+
+    while(!queue.isEmpty())
+    {
+        int state = queue.dequeue();
+        for(int num = 0; num < nodes[state].edgeCount; num++)
+        {
+            const Edge &edge = edges[nodes[state].firstEdge + num];
+            int child = edge.target;
+
+            int fail = nodes[state].fail;
+            int target = find(fail, edge.c);
+            while(target < 0 && fail != 0)
+            {
+                fail = nodes[fail].fail;
+                target = find(fail, edge.c);
+            }
+            nodes[child].fail = (target >= 0 && target != child) ? target : 0;
+
+            int suffix = nodes[child].fail;
+            nodes[child].outputLink = nodes[suffix].patternCount > 0 ? suffix : nodes[suffix].outputLink;
+
+            queue.enqueue(child);
+        }
+    }
+}
+
+int QDltMultiPattern::Automaton::find(int state, ushort c) const
+{
+    if(state == 0 && c < 256)
+        return rootTable[c];
+
+    /* binary search in the sorted edges of the node */
+    int low = nodes[state].firstEdge;
+    int high = low + nodes[state].edgeCount - 1;
+    while(low <= high)
+    {
+        int middle = (low + high) / 2;
+        if(edges[middle].c < c)
+            low = middle + 1;
+        else if(edges[middle].c > c)
+            high = middle - 1;
+        else
+            return edges[middle].target;
+    }
+    return -1;
+}
+
+int QDltMultiPattern::Automaton::next(int state, ushort c) const
+{
+    for(;;)
+    {
+        int target = find(state, c);
+        if(target >= 0)
+            return target;
+        if(state == 0)
+            return 0;
+        state = nodes[state].fail;
+    }
+}
+
+void QDltMultiPattern::Automaton::match(const QString &text, bool fold, QBitArray &hits) const
+{
+    const QChar *data = text.constData();
+    int length = text.size();
+    int state = 0;
+
+    for(int pos = 0; pos < length; pos++)
+    {
+        ushort c = fold ? data[pos].toCaseFolded().unicode() : data[pos].unicode();
+        state = next(state, c);
+
+        int output = nodes[state].patternCount > 0 ? state : nodes[state].outputLink;
+        while(output > 0)
+        {
+            const Node &node = nodes[output];
+            for(int num = 0; num < node.patternCount; num++)
+                hits.setBit(outputs[node.firstPattern + num]);
+            output = node.outputLink;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltmultipattern.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTMULTIPATTERN_H
+#define QDLTMULTIPATTERN_H
+
+#include <QString>
+#include <QVector>
+#include <QBitArray>
+
+#include "export_rules.h"
+
+//! Searches many plain text patterns in one pass.
+/*!
+  The patterns are compiled into an Aho-Corasick automaton, so the
+  cost of a search depends on the length of the text and not on the
+  number of patterns. Case insensitive patterns are kept in a second
+  automaton, which is fed with case folded characters like
+  QString::contains() with Qt::CaseInsensitive does.
+*/
+class QDLT_EXPORT QDltMultiPattern
+{
+public:
+    QDltMultiPattern();
+
+    //! Delete all patterns.
+    void clear();
+
+    //! Add a pattern.
+    /*!
+      compile() must be called before the next search.
+      \param pattern Text to be searched, an empty pattern matches every text
+      \param cs Case sensitivity of the pattern
+      \return index of the pattern in the result bitmap
+    */
+    int addPattern(const QString &pattern, Qt::CaseSensitivity cs);
+
+    //! Build the automatons from the added patterns.
+    void compile();
+
+    //! Number of patterns.
+    int size() const { return patternCount; }
+    bool isEmpty() const { return patternCount == 0; }
+
+    //! Search all patterns in the text.
+    /*!
+      \param text The text to be searched
+      \param hits Resized to size(), the bits of all found patterns are set
+    */
+    void match(const QString &text, QBitArray &hits) const;
+
+private:
+    class Automaton
+    {
+    public:
+        struct Node
+        {
+            int fail;         /* longest proper suffix which is also in the trie */
+            int outputLink;   /* next suffix node where patterns end, -1 if none */
+            int firstEdge;
+            int edgeCount;
+            int firstPattern;
+            int patternCount;
+        };
+
+        struct Edge
+        {
+            ushort c;
+            int target;
+        };
+
+        Automaton();
+        void clear();
+        void add(const QString &pattern, int index);
+        void compile();
+        bool isEmpty() const { return patterns.isEmpty(); }
+        void match(const QString &text, bool fold, QBitArray &hits) const;
+
+    private:
+        int next(int state, ushort c) const;
+        int find(int state, ushort c) const;
+
+        QVector<QPair<QString,int> > patterns;
+
+        QVector<Node> nodes;
+        QVector<Edge> edges;
+        QVector<int> outputs;
+        int rootTable[256];   /* fast transitions of the root for Latin-1 text */
+    };
+
+    Automaton caseSensitive;
+    Automaton caseInsensitive;
+    QVector<int> emptyPatterns;
+    int patternCount;
+};
+
+#endif // QDLTMULTIPATTERN_H
@@ -82,6 +82,7 @@ void QDltOptManager::printUsage()
     qDebug()<<" -csv Conversion will be done in CSV format";
     qDebug()<<" -d Conversion will NOT be done, save in dlt file format again instead";
     qDebug()<<" -dd Conversion will NOT be done, save as decoded messages in dlt format";
+    qDebug()<<" -col Conversion will be done in columnar format for analysis tools";
     qDebug()<<" -e \"plugin|command|param1|..|param<n>\" \tExecute a plugin command with <n> parameters.\n";
     qDebug()<<"Examples:";
     #if (WIN32)
@@ -298,6 +299,10 @@ void QDltOptManager::parse(QStringList *opt)
          {
             convertionmode = e_DDLT;
          }
+        if(str.compare("-col")==0)
+         {
+            convertionmode = e_COL;
+         }
         if(str.compare("-e")==0)
          {
             QString c = opt->value(i+1);
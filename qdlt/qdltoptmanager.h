@@ -31,6 +31,7 @@ enum e_convertionmode
     e_DLT  = 2,
     e_CSV  = 3,
     e_DDLT = 4,
+    e_COL  = 5,
 };
 
 
@@ -3,9 +3,99 @@
 #include <QDir>
 #include <QCoreApplication>
 #include <QTableView>
+#include <QElapsedTimer>
 
 #include <QPluginLoader>
 
+QDltPluginStatistics::QDltPluginStatistics()
+{
+    clear();
+}
+
+void QDltPluginStatistics::clear()
+{
+    calls.store(0);
+    claimed.store(0);
+    totalNsecs.store(0);
+    for(int num = 0; num < HistogramSize; num++)
+        histogram[num].store(0);
+}
+
+void QDltPluginStatistics::addCall(qint64 nsecs, bool claimed)
+{
+    /* bucket is the number of significant bits of the duration */
+    int bucket = 0;
+    quint64 value = nsecs > 0 ? nsecs : 0;
+    while(value && bucket < HistogramSize - 1)
+    {
+        value >>= 1;
+        bucket++;
+    }
+
+    calls.fetchAndAddRelaxed(1);
+    totalNsecs.fetchAndAddRelaxed(nsecs);
+    histogram[bucket].fetchAndAddRelaxed(1);
+    if(claimed)
+        this->claimed.fetchAndAddRelaxed(1);
+}
+
+qint64 QDltPluginStatistics::getPercentileNsecs(double percentile) const
+{
+    qint64 counts[HistogramSize];
+    qint64 total = 0;
+
+    for(int num = 0; num < HistogramSize; num++)
+    {
+        counts[num] = histogram[num].load();
+        total += counts[num];
+    }
+
+    if(total == 0)
+        return 0;
+
+    qint64 limit = (qint64) (percentile * total);
+    if(limit >= total)
+        limit = total - 1;
+
+    qint64 sum = 0;
+    for(int num = 0; num < HistogramSize; num++)
+    {
+        sum += counts[num];
+        if(sum > limit)
+            return ((qint64) 1) << num;
+    }
+
+    return ((qint64) 1) << (HistogramSize - 1);
+}
+
+static QString formatNsecs(qint64 nsecs)
+{
+    if(nsecs < 10000)
+        return QString("%1 ns").arg(nsecs);
+    if(nsecs < 10000000)
+        return QString("%1 us").arg(nsecs / 1000);
+    return QString("%1 ms").arg(nsecs / 1000000);
+}
+
+QString QDltPluginStatistics::toString(bool showClaimed) const
+{
+    qint64 numberOfCalls = getCalls();
+
+    if(numberOfCalls == 0)
+        return QString("no calls");
+
+    QString calls = QString("%L1 calls").arg(numberOfCalls);
+    if(showClaimed)
+        calls += QString(", %L1 decoded").arg(getClaimed());
+
+    return QString("%1, total %2, mean %3, p50 %4, p99 %5")
+            .arg(calls)
+            .arg(formatNsecs(getTotalNsecs()))
+            .arg(formatNsecs(getTotalNsecs() / numberOfCalls))
+            .arg(formatNsecs(getPercentileNsecs(0.5)))
+            .arg(formatNsecs(getPercentileNsecs(0.99)));
+}
+
 QDltPlugin::QDltPlugin()
 {
     plugininterface = 0;
@@ -13,6 +103,7 @@ QDltPlugin::QDltPlugin()
     plugindecoderinterface = 0;
     plugincontrolinterface = 0;
     plugincommandinterface = 0;
+    pluginsignalinterface = 0;
 
     mode = ModeDisable;
 }
@@ -95,17 +186,48 @@ void QDltPlugin::loadPlugin(QObject *plugin)
     plugindecoderinterface = qobject_cast<QDLTPluginDecoderInterface *>(plugin);
     plugincontrolinterface = qobject_cast<QDltPluginControlInterface *>(plugin);
     plugincommandinterface = qobject_cast<QDltPluginCommandInterface *>(plugin);
+    pluginsignalinterface = qobject_cast<QDltPluginSignalInterface *>(plugin);
     //item->update();
 
 }
 
 bool QDltPlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
 {
-    if(mode != ModeDisable && plugindecoderinterface && plugindecoderinterface->isMsg(msg,triggeredByUser))
+    if(mode == ModeDisable || !plugindecoderinterface)
+        return false;
+
+    /* one measurement for the statistics and the profiler */
+    QDltProfiler *profiler = QDltProfiler::getInstance();
+    qint64 start = profiler->isEnabled() ? profiler->timestamp() : -1;
+    QElapsedTimer timer;
+    timer.start();
+
+    bool decoded = false;
+    if(plugindecoderinterface->isMsg(msg,triggeredByUser))
     {
-        return plugindecoderinterface->decodeMsg(msg,triggeredByUser);
+        decoded = plugindecoderinterface->decodeMsg(msg,triggeredByUser);
     }
-    return false;
+
+    qint64 nsecs = timer.nsecsElapsed();
+    decoderStatistics.addCall(nsecs, decoded);
+
+    /* the plugin name is only needed when profiling */
+    if(start >= 0)
+        profiler->addSpan("decode", getName(), start, nsecs / 1000, QDltProfiler::SpanAggregate);
+
+    return decoded;
+}
+
+QString QDltPlugin::statisticsText()
+{
+    QStringList text;
+
+    if(isDecoder())
+        text.append(QString("decoder: %1").arg(decoderStatistics.toString(true)));
+    if(isViewer())
+        text.append(QString("viewer: %1").arg(viewerStatistics.toString(false)));
+
+    return text.join("; ");
 }
 
 bool QDltPlugin::isDecoder()
@@ -128,6 +250,11 @@ bool QDltPlugin::isCommand()
     return (plugincommandinterface?true:false);
 }
 
+bool QDltPlugin::isSignal()
+{
+    return (pluginsignalinterface?true:false);
+}
+
 QStringList QDltPlugin::infoConfig()
 {
     if(plugininterface)
@@ -160,6 +287,13 @@ bool QDltPlugin::command(QString cmd,QStringList params)
         return false;
 }
 
+// signal plugin interface
+void QDltPlugin::initSignalExtractor(QDltSignalExtractor *extractor)
+{
+    if(pluginsignalinterface)
+        pluginsignalinterface->initSignalExtractor(extractor);
+}
+
 // viewer plugin interfaces
 QWidget* QDltPlugin::initViewer()
 {
@@ -181,12 +315,22 @@ if(pluginviewerinterface)
 void QDltPlugin::initMsg(int index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
+{
+    QElapsedTimer timer;
+    timer.start();
     pluginviewerinterface->initMsg(index,msg);
+    viewerStatistics.addCall(timer.nsecsElapsed(), false);
+}
 }
 void QDltPlugin::initMsgDecoded(int index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
+{
+    QElapsedTimer timer;
+    timer.start();
     pluginviewerinterface->initMsgDecoded(index,msg);
+    viewerStatistics.addCall(timer.nsecsElapsed(), false);
+}
 }
 void QDltPlugin::updateFileStart()
 {
@@ -196,12 +340,22 @@ if(pluginviewerinterface)
 void QDltPlugin::updateMsg(int index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
+{
+    QElapsedTimer timer;
+    timer.start();
     pluginviewerinterface->updateMsg(index,msg);
+    viewerStatistics.addCall(timer.nsecsElapsed(), false);
+}
 }
 void QDltPlugin::updateMsgDecoded(int index, QDltMsg &msg)
 {
 if(pluginviewerinterface)
+{
+    QElapsedTimer timer;
+    timer.start();
     pluginviewerinterface->updateMsgDecoded(index,msg);
+    viewerStatistics.addCall(timer.nsecsElapsed(), false);
+}
 }
 void QDltPlugin::updateFileFinish()
 {
@@ -4,6 +4,7 @@
 #include "plugininterface.h"
 
 #include <QDir>
+#include <QAtomicInteger>
 
 #include "export_rules.h"
 
@@ -12,8 +13,56 @@ class QDLTPluginDecoderInterface;
 class QDltPluginViewerInterface;
 class QDltPluginControlInterface;
 class QDltPluginCommandInterface;
+class QDltPluginSignalInterface;
 class QTableView;
 
+//! Call counters and latency histogram of a plugin
+/*!
+  Counters are updated lock free, as plugins are called from the indexer
+  thread and the GUI thread at the same time. Latencies are collected in
+  power of two buckets, so percentiles are upper bounds of the bucket.
+*/
+class QDLT_EXPORT QDltPluginStatistics
+{
+public:
+    enum { HistogramSize = 48 };
+
+    QDltPluginStatistics();
+
+    //! Reset all counters to zero
+    void clear();
+
+    //! Add a call of the plugin
+    /*!
+      \param nsecs Duration of the call in nanoseconds
+      \param claimed True if the plugin decoded the message
+    */
+    void addCall(qint64 nsecs, bool claimed);
+
+    qint64 getCalls() const { return calls.load(); }
+    qint64 getClaimed() const { return claimed.load(); }
+    qint64 getTotalNsecs() const { return totalNsecs.load(); }
+
+    //! Latency in nanoseconds which is not exceeded by the given share of calls
+    /*!
+      \param percentile Value between 0 and 1, e.g. 0.99
+      \return Upper bound of the histogram bucket, 0 if there was no call
+    */
+    qint64 getPercentileNsecs(double percentile) const;
+
+    //! One line summary, e.g. for the plugin list or the command line
+    /*!
+      \param showClaimed Show the number of decoded messages, used for decoder calls
+    */
+    QString toString(bool showClaimed = true) const;
+
+private:
+    QAtomicInteger<qint64> calls;
+    QAtomicInteger<qint64> claimed;
+    QAtomicInteger<qint64> totalNsecs;
+    QAtomicInteger<qint64> histogram[HistogramSize];
+};
+
 //! Access class to a DLT Plugin to decode, view and control DLT messages
 /*!
   This class loads a DLT Viewer Plugin library and provides functions to access the plugin.
@@ -91,6 +140,12 @@ public:
     */
     bool isCommand();
 
+    //! Check if this is a signal plugin
+    /*!
+      \return True if it is a signal plugin
+    */
+    bool isSignal();
+
     // generic plugin interfaces
     QStringList infoConfig();
     QString error();
@@ -122,6 +177,18 @@ public:
     // command plugin interfaces
     bool command(QString cmd,QStringList params);
 
+    // signal plugin interfaces
+    void initSignalExtractor(QDltSignalExtractor *extractor);
+
+    //! Cost of the decoder calls of this plugin
+    QDltPluginStatistics &getDecoderStatistics() { return decoderStatistics; }
+
+    //! Cost of the viewer calls of this plugin, initMsg and updateMsg with their decoded variants
+    QDltPluginStatistics &getViewerStatistics() { return viewerStatistics; }
+
+    //! Summary of the decoder and viewer costs, e.g. for the plugin list or the command line
+    QString statisticsText();
+
 private:
 
     //! The complete filename of the plugin including path
@@ -139,6 +206,13 @@ private:
     QDltPluginViewerInterface  *pluginviewerinterface;
     QDltPluginControlInterface *plugincontrolinterface;
     QDltPluginCommandInterface *plugincommandinterface;
+    QDltPluginSignalInterface *pluginsignalinterface;
+
+    //! Cost of the decoder calls
+    QDltPluginStatistics decoderStatistics;
+
+    //! Cost of the viewer calls
+    QDltPluginStatistics viewerStatistics;
 
 };
 
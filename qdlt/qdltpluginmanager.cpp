@@ -7,6 +7,10 @@
 #include <QTextStream>
 #include <QString>
 
+#include "qdltprofiler.h"
+
+#include <algorithm>
+
 #ifndef PLUGIN_INSTALLATION_PATH
 #define PLUGIN_INSTALLATION_PATH ""
 #endif
@@ -149,6 +153,7 @@ void QDltPluginManager::decodeMsg(QDltMsg &msg, int triggeredByUser)
     {
         QDltPlugin *plugin = plugins[num];
 
+        /* the plugin records its cost in the statistics and the profiler */
         if(plugin->decodeMsg(msg,triggeredByUser))
             break;
 
@@ -167,6 +172,36 @@ QDltPlugin* QDltPluginManager::findPlugin(QString &name)
     return 0;
 }
 
+void QDltPluginManager::clearStatistics()
+{
+    for(int num=0;num<plugins.size();num++)
+    {
+        plugins[num]->getDecoderStatistics().clear();
+        plugins[num]->getViewerStatistics().clear();
+    }
+}
+
+QStringList QDltPluginManager::statisticsReport()
+{
+    QList<QPair<qint64,QDltPlugin*> > list;
+    QStringList report;
+
+    for(int num=0;num<plugins.size();num++)
+    {
+        QDltPlugin *plugin = plugins[num];
+
+        if(plugin->getDecoderStatistics().getCalls() > 0 || plugin->getViewerStatistics().getCalls() > 0)
+            list.append(qMakePair(plugin->getDecoderStatistics().getTotalNsecs() + plugin->getViewerStatistics().getTotalNsecs(), plugin));
+    }
+
+    std::sort(list.begin(), list.end(), [](const QPair<qint64,QDltPlugin*> &a, const QPair<qint64,QDltPlugin*> &b) { return a.first > b.first; });
+
+    for(int num=0;num<list.size();num++)
+        report.append(QString("%1: %2").arg(list[num].second->getName()).arg(list[num].second->statisticsText()));
+
+    return report;
+}
+
 QList<QDltPlugin*> QDltPluginManager::getDecoderPlugins()
 {
     QList<QDltPlugin*> list;
@@ -74,6 +74,16 @@ public:
     */
     QDltPlugin* findPlugin(QString &name);
 
+    //! Reset the call statistics of all plugins
+    void clearStatistics();
+
+    //! Call statistics of all plugins which were called, one line per plugin
+    /*!
+      The plugins are sorted by the total time spent in the plugin.
+      \return list of text lines
+    */
+    QStringList statisticsReport();
+
     //control plugin interface
     bool stateChanged(int index, QDltConnection::QDltConnectionState connectionState, QString hostname);
     bool autoscrollStateChanged(bool enabled);
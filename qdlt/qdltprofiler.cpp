@@ -0,0 +1,271 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltprofiler.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QThread>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QStringList>
+#include <QDebug>
+
+#include <algorithm>
+
+#include "qdltprofiler.h"
+
+QDltProfiler::QDltProfiler()
+{
+    droppedEvents = 0;
+    timer.start();
+}
+
+QDltProfiler::QDltProfiler(QDltProfiler const&)
+{
+
+}
+
+QDltProfiler* QDltProfiler::getInstance()
+{
+    // created on first use, the initialisation is thread safe
+    static QDltProfiler instance;
+
+    return &instance;
+}
+
+void QDltProfiler::setEnabled(bool enable)
+{
+    if(enable && !isEnabled())
+        clear();
+
+    enabled.store(enable ? 1 : 0);
+}
+
+void QDltProfiler::clear()
+{
+    QMutexLocker locker(&mutex);
+
+    events.clear();
+    totals.clear();
+    threads.clear();
+    droppedEvents = 0;
+    timer.restart();
+}
+
+qint64 QDltProfiler::timestamp() const
+{
+    return timer.nsecsElapsed() / 1000;
+}
+
+int QDltProfiler::threadNumber()
+{
+    /* small numbers are easier to read in the trace viewer than thread handles */
+    Qt::HANDLE handle = QThread::currentThreadId();
+    QHash<Qt::HANDLE,int>::const_iterator it = threads.constFind(handle);
+    if(it != threads.constEnd())
+        return it.value();
+
+    int number = threads.size() + 1;
+    threads.insert(handle, number);
+    return number;
+}
+
+void QDltProfiler::addSpan(const char *category, const QString &name, qint64 start, qint64 duration, SpanType type)
+{
+    if(!isEnabled())
+        return;
+
+    QMutexLocker locker(&mutex);
+
+    QHash<QString,Total>::iterator it = totals.find(name);
+    if(it == totals.end())
+    {
+        Total total;
+        total.category = category;
+        total.count = 0;
+        total.duration = 0;
+        it = totals.insert(name, total);
+    }
+    it.value().count++;
+    it.value().duration += duration;
+
+    if(type != SpanEvent)
+        return;
+
+    if(events.size() >= QDLT_PROFILER_MAX_EVENTS)
+    {
+        droppedEvents++;
+        return;
+    }
+
+    Event event;
+    event.category = category;
+    event.name = name;
+    event.phase = 'X';
+    event.start = start;
+    event.duration = duration;
+    event.value = 0;
+    event.thread = threadNumber();
+    events.append(event);
+}
+
+void QDltProfiler::addCounter(const QString &name, qint64 value)
+{
+    if(!isEnabled())
+        return;
+
+    QMutexLocker locker(&mutex);
+
+    if(events.size() >= QDLT_PROFILER_MAX_EVENTS)
+    {
+        droppedEvents++;
+        return;
+    }
+
+    Event event;
+    event.category = "counter";
+    event.name = name;
+    event.phase = 'C';
+    event.start = timer.nsecsElapsed() / 1000;
+    event.duration = 0;
+    event.value = value;
+    event.thread = threadNumber();
+    events.append(event);
+}
+
+bool QDltProfiler::writeChromeTrace(const QString &filename)
+{
+    QJsonArray traceEvents;
+    QJsonObject summaryArgs;
+
+    {
+        QMutexLocker locker(&mutex);
+
+        for(int num = 0; num < events.size(); num++)
+        {
+            const Event &event = events[num];
+            QJsonObject object;
+
+            object["name"] = event.name;
+            object["cat"] = QString(event.category);
+            object["ph"] = QString(QChar(event.phase));
+            object["ts"] = event.start;
+            object["pid"] = 1;
+            object["tid"] = event.thread;
+            if(event.phase == 'X')
+            {
+                object["dur"] = event.duration;
+            }
+            else
+            {
+                QJsonObject args;
+                args["value"] = event.value;
+                object["args"] = args;
+            }
+            traceEvents.append(object);
+        }
+
+        /* accumulated values of all spans, including per message spans */
+        for(QHash<QString,Total>::const_iterator it = totals.constBegin(); it != totals.constEnd(); ++it)
+        {
+            QJsonObject total;
+            total["category"] = QString(it.value().category);
+            total["count"] = it.value().count;
+            total["msecs"] = it.value().duration / 1000.0;
+            summaryArgs[it.key()] = total;
+        }
+        summaryArgs["droppedEvents"] = droppedEvents;
+    }
+
+    QJsonObject summaryEvent;
+    summaryEvent["name"] = QString("Summary");
+    summaryEvent["cat"] = QString("summary");
+    summaryEvent["ph"] = QString("i");
+    summaryEvent["s"] = QString("g");
+    summaryEvent["ts"] = timestamp();
+    summaryEvent["pid"] = 1;
+    summaryEvent["tid"] = 1;
+    summaryEvent["args"] = summaryArgs;
+    traceEvents.append(summaryEvent);
+
+    QJsonObject document;
+    document["traceEvents"] = traceEvents;
+    document["displayTimeUnit"] = QString("ms");
+
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Cannot write performance trace" << filename << file.errorString();
+        return false;
+    }
+
+    QByteArray data = QJsonDocument(document).toJson(QJsonDocument::Compact);
+    if(file.write(data) != data.size())
+    {
+        qWarning() << "Cannot write performance trace" << filename << file.errorString();
+        return false;
+    }
+
+    file.close();
+
+    return true;
+}
+
+QString QDltProfiler::summary(int maxEntries)
+{
+    QList<QPair<qint64,QString> > list;
+
+    {
+        QMutexLocker locker(&mutex);
+
+        for(QHash<QString,Total>::const_iterator it = totals.constBegin(); it != totals.constEnd(); ++it)
+            list.append(qMakePair(it.value().duration, it.key()));
+    }
+
+    std::sort(list.begin(), list.end());
+
+    QStringList entries;
+    for(int num = list.size() - 1; num >= 0 && entries.size() < maxEntries; num--)
+        entries.append(QString("%1 %2 ms").arg(list[num].second).arg(list[num].first / 1000));
+
+    return entries.join(", ");
+}
+
+QDltProfilerSpan::QDltProfilerSpan(const char *category, const QString &name, QDltProfiler::SpanType type)
+    : category(category)
+    , type(type)
+{
+    QDltProfiler *profiler = QDltProfiler::getInstance();
+
+    if(profiler->isEnabled())
+    {
+        this->name = name;
+        start = profiler->timestamp();
+    }
+    else
+    {
+        start = -1;
+    }
+}
+
+QDltProfilerSpan::~QDltProfilerSpan()
+{
+    QDltProfiler *profiler = QDltProfiler::getInstance();
+
+    if(start >= 0)
+        profiler->addSpan(category, name, start, profiler->timestamp() - start, type);
+}
@@ -0,0 +1,128 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltprofiler.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTPROFILER_H
+#define QDLTPROFILER_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+
+#include "export_rules.h"
+
+/* maximum number of single events kept for the trace file,
+   durations are still accumulated when the limit is reached */
+#define QDLT_PROFILER_MAX_EVENTS 200000
+
+//! Collects timing spans and counters of the processing phases.
+/*!
+  The profiler is disabled by default. When disabled a span costs
+  one atomic load, so spans can stay in the code permanently.
+  The collected data can be written as Chrome trace event file,
+  which can be opened in chrome://tracing or Perfetto.
+*/
+class QDLT_EXPORT QDltProfiler
+{
+public:
+    typedef enum { SpanEvent, SpanAggregate } SpanType;
+
+    static QDltProfiler* getInstance();
+
+    //! Enable or disable recording, enabling clears old data.
+    void setEnabled(bool enable);
+    bool isEnabled() const { return enabled.load() != 0; }
+
+    //! Delete all recorded events, totals and counters.
+    void clear();
+
+    //! Microseconds since the profiler was enabled or cleared.
+    qint64 timestamp() const;
+
+    //! Record a span.
+    /*!
+      Spans of type SpanEvent are written as single events to the trace file.
+      Spans of type SpanAggregate, used for per message work, only add up
+      count and duration.
+      \param category Static category name
+      \param name Name of the span
+      \param start Start time from timestamp()
+      \param duration Duration in microseconds
+      \param type Event or aggregate only
+    */
+    void addSpan(const char *category, const QString &name, qint64 start, qint64 duration, SpanType type);
+
+    //! Record the current value of a counter.
+    void addCounter(const QString &name, qint64 value);
+
+    //! Write all recorded data in the Chrome trace event format.
+    bool writeChromeTrace(const QString &filename);
+
+    //! Short text with the phases taking the most time, used for the status bar.
+    QString summary(int maxEntries = 4);
+
+private:
+    QDltProfiler();
+    QDltProfiler(QDltProfiler const&);
+
+    struct Event
+    {
+        const char *category;
+        QString name;
+        char phase;
+        qint64 start;
+        qint64 duration;
+        qint64 value;
+        int thread;
+    };
+
+    struct Total
+    {
+        const char *category;
+        qint64 count;
+        qint64 duration;
+    };
+
+    int threadNumber();
+
+    QAtomicInt enabled;
+    QElapsedTimer timer;
+    mutable QMutex mutex;
+
+    QVector<Event> events;
+    QHash<QString,Total> totals;
+    QHash<Qt::HANDLE,int> threads;
+    qint64 droppedEvents;
+};
+
+//! Measures the lifetime of the object and records it as span.
+class QDLT_EXPORT QDltProfilerSpan
+{
+public:
+    QDltProfilerSpan(const char *category, const QString &name, QDltProfiler::SpanType type = QDltProfiler::SpanEvent);
+    ~QDltProfilerSpan();
+
+private:
+    const char *category;
+    QString name;
+    QDltProfiler::SpanType type;
+    qint64 start;
+};
+
+#endif // QDLTPROFILER_H
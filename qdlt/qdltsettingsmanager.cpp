@@ -186,6 +186,11 @@ void QDltSettingsManager::writeSettings()
     settings->setValue("startup/splitfileyesno",splitlogfile);
     settings->setValue("startup/maxFileSizeMB",fmaxFileSizeMB);
     settings->setValue("startup/appendDateTime",appendDateTime);
+    settings->setValue("startup/captureMemory",captureMemory);
+    settings->setValue("startup/captureMemoryMB",captureMemoryMB);
+    settings->setValue("startup/captureSpill",captureSpill);
+    settings->setValue("startup/memoryBudget",memoryBudget);
+    settings->setValue("startup/memoryBudgetMB",memoryBudgetMB);
     settings->setValue("startup/markercolor",markercolor.name());
 
     /* table */
@@ -429,6 +434,11 @@ void QDltSettingsManager::readSettings()
     splitlogfile = settings->value("startup/splitfileyesno",0).toInt();
     fmaxFileSizeMB = settings->value("startup/maxFileSizeMB",0).toFloat();
     appendDateTime = settings->value("startup/appendDateTime",0).toInt();
+    captureMemory = settings->value("startup/captureMemory",0).toInt();
+    captureMemoryMB = settings->value("startup/captureMemoryMB",256).toInt();
+    captureSpill = settings->value("startup/captureSpill",1).toInt();
+    memoryBudget = settings->value("startup/memoryBudget",0).toInt();
+    memoryBudgetMB = settings->value("startup/memoryBudgetMB",4096).toInt();
     markercolor.setNamedColor(settings->value("startup/markercolor","#aaaaaa").toString() );
 
     /* project table */
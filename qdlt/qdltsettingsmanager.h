@@ -93,6 +93,11 @@ public:
     int splitlogfile; // local and project setting
     float fmaxFileSizeMB; // local and project setting
     int appendDateTime; // local and project setting
+    int captureMemory; // local setting
+    int captureMemoryMB; // local setting
+    int captureSpill; // local setting
+    int memoryBudget; // local setting
+    int memoryBudgetMB; // local setting
 
     int fontSize; // project and local setting
     int sectionSize; // project and local setting
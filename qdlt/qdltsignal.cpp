@@ -0,0 +1,487 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltsignal.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QtDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QSet>
+
+#include "qdlt.h"
+
+QDltSignalSpec::QDltSignalSpec()
+{
+    index = 0;
+    argument = QString("0");
+    messageId = -1;
+}
+
+QDltSignalSpec::QDltSignalSpec(const QString &ecuid, const QString &apid, const QString &ctid, const QString &argument, qint64 messageId)
+    : ecuid(ecuid), apid(apid), ctid(ctid), argument(argument), messageId(messageId)
+{
+    bool ok;
+    index = argument.toInt(&ok);
+    if(!ok || index < 0)
+        index = -1;
+}
+
+QString QDltSignalSpec::key() const
+{
+    return ecuid + "/" + apid + "/" + ctid + "/" + QString::number(messageId) + "/" + argument;
+}
+
+bool QDltSignalSpec::mayMatch(const QDltBlockSummary &block, bool decoded) const
+{
+    return block.mayMatchIds(apid, ctid, decoded);
+}
+
+bool QDltSignalSpec::value(const QDltMsg &msg, double &value) const
+{
+    if(!ecuid.isEmpty() && msg.getEcuid() != ecuid)
+        return false;
+    if(!apid.isEmpty() && msg.getApid() != apid)
+        return false;
+    if(!ctid.isEmpty() && msg.getCtid() != ctid)
+        return false;
+    if(messageId >= 0 && msg.getMessageId() != messageId)
+        return false;
+
+    const QList<QDltArgument> &arguments = msg.getArguments();
+    const QDltArgument *selected = 0;
+    if(index >= 0)
+    {
+        if(index < arguments.size())
+            selected = &arguments.at(index);
+    }
+    else
+    {
+        for(int num = 0; num < arguments.size() && !selected; num++)
+        {
+            if(arguments.at(num).getName() == argument)
+                selected = &arguments.at(num);
+        }
+    }
+    if(!selected)
+        return false;
+
+    qint64 signedValue;
+    quint64 unsignedValue;
+    if(selected->getSigned(signedValue))
+    {
+        value = signedValue;
+        return true;
+    }
+    if(selected->getUnsigned(unsignedValue))
+    {
+        value = unsignedValue;
+        return true;
+    }
+    return selected->getFloat(value);
+}
+
+QDltSignalSeries::QDltSignalSeries()
+{
+}
+
+QDltSignalSeries::QDltSignalSeries(const QDltSignalSpec &spec)
+    : spec(spec)
+{
+}
+
+void QDltSignalSeries::append(qint64 time, quint32 timestamp, double value, int index)
+{
+    times.append(time);
+    timestamps.append(timestamp);
+    values.append(value);
+    indexes.append(index);
+}
+
+void QDltSignalSeries::append(const QDltSignalSeries &other)
+{
+    times += other.times;
+    timestamps += other.timestamps;
+    values += other.values;
+    indexes += other.indexes;
+}
+
+qint64 QDltSignalSeries::memorySize() const
+{
+    return QDltMemoryUsage::of(times) + QDltMemoryUsage::of(timestamps) +
+           QDltMemoryUsage::of(values) + QDltMemoryUsage::of(indexes);
+}
+
+bool QDltSignalSeries::save(const QString &filename) const
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream stream(&file);
+    stream << (quint32) QDLT_SIGNAL_SERIES_FILE_MAGIC << (quint32) QDLT_SIGNAL_SERIES_FILE_VERSION;
+    stream << spec.key() << times << timestamps << values << indexes;
+
+    file.close();
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool QDltSignalSeries::load(const QString &filename)
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0;
+    QString key;
+    stream >> magic >> version;
+    if(magic != QDLT_SIGNAL_SERIES_FILE_MAGIC || version != QDLT_SIGNAL_SERIES_FILE_VERSION)
+    {
+        qDebug() << "Signal cache" << filename << "has wrong version";
+        return false;
+    }
+
+    stream >> key >> times >> timestamps >> values >> indexes;
+
+    if(stream.status() != QDataStream::Ok || key != spec.key() ||
+       timestamps.size() != times.size() || values.size() != times.size() || indexes.size() != times.size())
+    {
+        qDebug() << "Signal cache" << filename << "is invalid";
+        times.clear();
+        timestamps.clear();
+        values.clear();
+        indexes.clear();
+        return false;
+    }
+
+    return true;
+}
+
+//! Extracts the signals from the messages of one block.
+class QDltSignalExtractorTask : public QRunnable
+{
+public:
+    QDltSignalExtractorTask(const QDltFile *file, QDltPluginManager *pluginManager, const QList<QDltSignalSpec> &specs,
+                            const QDltBlockSummary *block, int first, int last, QList<QDltSignalSeries> *result,
+                            const QAtomicInt *generation, int expected, QAtomicInt *done)
+        : file(file), pluginManager(pluginManager), specs(specs), block(block), first(first), last(last), result(result),
+          generation(generation), expected(expected), done(done) {}
+
+    void run()
+    {
+        extractBlock();
+        done->ref();
+    }
+
+private:
+    void extractBlock()
+    {
+        /* only the signals, which may be contained in the block */
+        QList<int> active;
+        for(int num = 0; num < specs.size(); num++)
+        {
+            result->append(QDltSignalSeries(specs[num]));
+            if(!block || specs[num].mayMatch(*block, pluginManager != 0))
+                active.append(num);
+        }
+        if(active.isEmpty())
+            return;
+
+        QDltFileIterator messages(file);
+        QDltMsg msg;
+        double value;
+        for(int ix = first; ix < last; ix++)
+        {
+            /* stop when the extraction is cancelled */
+            if(0 == (ix % 1024) && generation->loadAcquire() != expected)
+                return;
+
+            if(!messages.seek(ix) || !messages.getMsg(msg))
+                continue; // Skip broken messages
+
+            if(pluginManager)
+                pluginManager->decodeMsg(msg, 0);
+
+            for(int num = 0; num < active.size(); num++)
+            {
+                int spec = active[num];
+                if(specs[spec].value(msg, value))
+                    (*result)[spec].append((qint64) msg.getTime() * 1000000 + msg.getMicroseconds(), msg.getTimestamp(), value, ix);
+            }
+        }
+    }
+
+    const QDltFile *file;
+    QDltPluginManager *pluginManager;
+    QList<QDltSignalSpec> specs;
+    const QDltBlockSummary *block;
+    int first;
+    int last;
+    QList<QDltSignalSeries> *result;
+    const QAtomicInt *generation;
+    int expected;
+    QAtomicInt *done;
+};
+
+//! Handles one request of series in the background.
+class QDltSignalRequestTask : public QRunnable
+{
+public:
+    QDltSignalRequestTask(QDltSignalExtractor *extractor, const QList<QDltSignalSpec> &specs, int generation, int request)
+        : extractor(extractor), specs(specs), generation(generation), request(request) {}
+
+    void run()
+    {
+        QList<QDltSignalSeries> result;
+        if(extractor->lookup(specs, generation, request, result))
+            emit extractor->seriesFinished(request, result);
+    }
+
+private:
+    QDltSignalExtractor *extractor;
+    QList<QDltSignalSpec> specs;
+    int generation;
+    int request;
+};
+
+QDltSignalExtractor::QDltSignalExtractor(QDltFile *file, QDltPluginManager *pluginManager)
+{
+    this->file = file;
+    this->pluginManager = pluginManager;
+    pluginsEnabled = 1;
+    cacheEnabled = 0;
+
+    /* one request after the other, each extraction uses its own pool */
+    requestPool.setMaxThreadCount(1);
+
+    qRegisterMetaType<QDltSignalSeries>("QDltSignalSeries");
+    qRegisterMetaType<QList<QDltSignalSeries> >("QList<QDltSignalSeries>");
+}
+
+QDltSignalExtractor::~QDltSignalExtractor()
+{
+    stop();
+}
+
+void QDltSignalExtractor::setPluginsEnabled(bool enabled)
+{
+    pluginsEnabled.storeRelease(enabled ? 1 : 0);
+}
+
+void QDltSignalExtractor::setCacheEnabled(bool enabled)
+{
+    cacheEnabled.storeRelease(enabled ? 1 : 0);
+}
+
+QList<QDltSignalSeries> QDltSignalExtractor::series(const QList<QDltSignalSpec> &specs)
+{
+    QList<QDltSignalSeries> result;
+    if(!lookup(specs, generation.loadAcquire(), -1, result))
+    {
+        result.clear();
+        for(int num = 0; num < specs.size(); num++)
+            result.append(QDltSignalSeries(specs[num]));
+    }
+    return result;
+}
+
+int QDltSignalExtractor::requestSeries(const QList<QDltSignalSpec> &specs)
+{
+    int request = requests.fetchAndAddOrdered(1) + 1;
+    requestPool.start(new QDltSignalRequestTask(this, specs, generation.loadAcquire(), request));
+    return request;
+}
+
+void QDltSignalExtractor::cancel()
+{
+    generation.fetchAndAddOrdered(1);
+}
+
+void QDltSignalExtractor::stop()
+{
+    cancel();
+    requestPool.waitForDone();
+
+    /* wait for extractions of series() called in other threads */
+    QMutexLocker locker(&mutex);
+}
+
+bool QDltSignalExtractor::lookup(const QList<QDltSignalSpec> &specs, int expected, int request, QList<QDltSignalSeries> &result)
+{
+    QMutexLocker locker(&mutex);
+
+    if(generation.loadAcquire() != expected)
+        return false;
+
+    /* the series are only valid for the same log files, messages and decoders */
+    QString current = fingerprint();
+    if(current != cacheFingerprint)
+    {
+        cache.clear();
+        cacheFingerprint = current;
+    }
+
+    bool useFile = cacheEnabled.loadAcquire() && file->getNumberOfFiles() > 0;
+    QList<QDltSignalSpec> missing;
+    QSet<QString> missingKeys;
+    for(int num = 0; num < specs.size(); num++)
+    {
+        QString key = specs[num].key();
+        if(cache.contains(key) || missingKeys.contains(key))
+            continue;
+
+        QDltSignalSeries loaded(specs[num]);
+        if(useFile && loaded.load(cacheFilename(current, specs[num])))
+        {
+            cache.insert(key, loaded);
+            continue;
+        }
+
+        missing.append(specs[num]);
+        missingKeys.insert(key);
+    }
+
+    if(!missing.isEmpty())
+    {
+        /* cancelled extractions are incomplete, they are not cached */
+        QList<QDltSignalSeries> extracted;
+        if(!extract(missing, expected, request, extracted))
+            return false;
+
+        for(int num = 0; num < extracted.size(); num++)
+        {
+            cache.insert(missing[num].key(), extracted[num]);
+            if(useFile && !extracted[num].save(cacheFilename(current, missing[num])))
+                qDebug() << "Saving signal cache failed" << cacheFilename(current, missing[num]);
+        }
+    }
+
+    for(int num = 0; num < specs.size(); num++)
+        result.append(cache.value(specs[num].key(), QDltSignalSeries(specs[num])));
+
+    return true;
+}
+
+void QDltSignalExtractor::clear()
+{
+    /* do not wait for a running extraction to finish */
+    cancel();
+
+    QMutexLocker locker(&mutex);
+    cache.clear();
+    cacheFingerprint.clear();
+}
+
+void QDltSignalExtractor::memoryUsage(QDltMemoryUsage &usage)
+{
+    /* do not wait for a running extraction */
+    if(!mutex.tryLock())
+        return;
+
+    qint64 bytes = QDltMemoryUsage::of(cache);
+    for(QHash<QString,QDltSignalSeries>::const_iterator it = cache.constBegin(); it != cache.constEnd(); ++it)
+        bytes += it.value().memorySize();
+    usage.add(QString("Signal series"), bytes);
+
+    mutex.unlock();
+}
+
+QString QDltSignalExtractor::fingerprint()
+{
+    QString hashString;
+
+    for(int num = 0; num < file->getNumberOfFiles(); num++)
+        hashString += file->getFileName(num) + "_";
+    hashString += QString("%1_%2").arg(file->fileSize()).arg(file->size());
+
+    if(pluginsEnabled.loadAcquire() && pluginManager)
+    {
+        QList<QDltPlugin*> decoderPlugins = pluginManager->getDecoderPlugins();
+        for(int num = 0; num < decoderPlugins.size(); num++)
+        {
+            hashString += decoderPlugins[num]->getName();
+            hashString += decoderPlugins[num]->getPluginVersion();
+            hashString += decoderPlugins[num]->getFilename();
+        }
+    }
+
+    return QString(QCryptographicHash::hash(hashString.toUtf8(), QCryptographicHash::Md5).toHex());
+}
+
+QString QDltSignalExtractor::cacheFilename(const QString &fingerprint, const QDltSignalSpec &spec)
+{
+    // stored in the subdirectory index next to the index cache
+    QFileInfo info(file->getFileName(0));
+    QDir dir(info.dir().path() + "/index");
+    if (!dir.exists())
+        dir.mkpath(".");
+
+    QByteArray md5 = QCryptographicHash::hash(spec.key().toUtf8(), QCryptographicHash::Md5);
+    return info.dir().path() + "/index/" + fingerprint + "_" + QString(md5.toHex()) + ".dsg";
+}
+
+bool QDltSignalExtractor::extract(const QList<QDltSignalSpec> &specs, int expected, int request, QList<QDltSignalSeries> &result)
+{
+    QDltProfilerSpan span("signals", QStringLiteral("Extract signals"));
+
+    int count = file->size();
+    QVector<QDltBlockSummary> blocks = file->getBlockSummaries();
+    int chunks = (count + QDLT_BLOCK_SUMMARY_SIZE - 1) / QDLT_BLOCK_SUMMARY_SIZE;
+    QVector<QList<QDltSignalSeries> > partial(chunks);
+    QDltPluginManager *decoder = pluginsEnabled.loadAcquire() ? pluginManager : 0;
+
+    /* own pool, so only the tasks of this extraction are waited for */
+    QThreadPool pool;
+    QAtomicInt done;
+    for(int chunk = 0; chunk < chunks; chunk++)
+    {
+        int first = chunk * QDLT_BLOCK_SUMMARY_SIZE;
+        int last = qMin(count, first + QDLT_BLOCK_SUMMARY_SIZE);
+
+        /* a block is only skipped, if its summary covers all messages */
+        const QDltBlockSummary *block = 0;
+        if(chunk < blocks.size() && blocks[chunk].size() >= last - first)
+            block = &blocks[chunk];
+
+        pool.start(new QDltSignalExtractorTask(file, decoder, specs, block, first, last, &partial[chunk], &generation, expected, &done));
+    }
+
+    /* report the progress of requests while waiting */
+    while(!pool.waitForDone(100))
+    {
+        if(request >= 0 && chunks > 0)
+            emit progress(request, (int) ((qint64) done.loadAcquire() * 100 / chunks));
+    }
+
+    if(generation.loadAcquire() != expected)
+        return false;
+
+    /* concatenate the blocks in file order */
+    for(int num = 0; num < specs.size(); num++)
+    {
+        QDltSignalSeries series(specs[num]);
+        for(int chunk = 0; chunk < chunks; chunk++)
+            series.append(partial[chunk][num]);
+        result.append(series);
+    }
+
+    return true;
+}
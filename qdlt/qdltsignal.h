@@ -0,0 +1,225 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdltsignal.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTSIGNAL_H
+#define QDLTSIGNAL_H
+
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <QMetaType>
+
+#include "export_rules.h"
+
+/* version of the signal series cache files */
+#define QDLT_SIGNAL_SERIES_FILE_MAGIC 0x444c5347
+#define QDLT_SIGNAL_SERIES_FILE_VERSION 1
+
+class QDltMsg;
+class QDltFile;
+class QDltPluginManager;
+class QDltBlockSummary;
+class QDltMemoryUsage;
+
+//! Description of a numeric signal, the value of one argument of matching messages.
+/*!
+  Empty ids match any message. The argument is selected by its index
+  starting with 0, or by its name. Integer, bool and float arguments
+  are read from the raw data, other arguments are no values.
+*/
+class QDLT_EXPORT QDltSignalSpec
+{
+public:
+    QDltSignalSpec();
+    QDltSignalSpec(const QString &ecuid, const QString &apid, const QString &ctid, const QString &argument, qint64 messageId = -1);
+
+    QString getEcuid() const { return ecuid; }
+    QString getApid() const { return apid; }
+    QString getCtid() const { return ctid; }
+    QString getArgument() const { return argument; }
+
+    //! Message id of non verbose messages, -1 matches any message.
+    qint64 getMessageId() const { return messageId; }
+
+    //! Unique text of the signal, used as key of the caches.
+    QString key() const;
+
+    //! Check if a message of the block may contain the signal.
+    /*!
+      \param block Summary of the block of messages
+      \param decoded true if the messages are decoded by decoder plugins
+    */
+    bool mayMatch(const QDltBlockSummary &block, bool decoded) const;
+
+    //! Get the value of the signal from a message.
+    /*!
+      \param msg The parsed, and if needed decoded, message
+      \param value Set to the value of the argument
+      \return true if the message matches and the argument is a number, else false
+    */
+    bool value(const QDltMsg &msg, double &value) const;
+
+private:
+    QString ecuid;
+    QString apid;
+    QString ctid;
+    QString argument;
+    int index;          /* -1 if the argument is selected by its name */
+    qint64 messageId;
+};
+
+//! Values of one signal, kept as compact columns.
+class QDLT_EXPORT QDltSignalSeries
+{
+public:
+    QDltSignalSeries();
+    QDltSignalSeries(const QDltSignalSpec &spec);
+
+    const QDltSignalSpec &getSpec() const { return spec; }
+
+    int size() const { return values.size(); }
+
+    //! Append a value of a message.
+    void append(qint64 time, quint32 timestamp, double value, int index);
+
+    //! Append all values of another series.
+    void append(const QDltSignalSeries &other);
+
+    //! Storage header times in microseconds since epoch.
+    const QVector<qint64> &getTimes() const { return times; }
+
+    //! Timestamps in 0.1 milliseconds.
+    const QVector<quint32> &getTimestamps() const { return timestamps; }
+
+    const QVector<double> &getValues() const { return values; }
+
+    //! Positions of the messages in the log file.
+    const QVector<qint32> &getIndexes() const { return indexes; }
+
+    qint64 memorySize() const;
+
+    bool save(const QString &filename) const;
+    bool load(const QString &filename);
+
+private:
+    QDltSignalSpec spec;
+    QVector<qint64> times;
+    QVector<quint32> timestamps;
+    QVector<double> values;
+    QVector<qint32> indexes;
+};
+
+Q_DECLARE_METATYPE(QDltSignalSeries)
+Q_DECLARE_METATYPE(QList<QDltSignalSeries>)
+
+//! Extracts numeric signals from all messages of a log file.
+/*!
+  All requested signals, which are not cached yet, are extracted in one
+  pass over the file. The messages are split into the blocks of the
+  block summaries, which are read and decoded in parallel in a thread
+  pool; blocks, which cannot contain any of the signals, are skipped.
+
+  The series are kept in memory until the log file changes, and are
+  saved next to the index cache, so plotting them again does not read
+  the log file. The extractor can be used from several threads, the
+  decoder plugins are called from the threads of the pool.
+
+  The GUI thread requests the series with requestSeries() and gets them
+  with the signal seriesFinished(), series() waits for the extraction.
+*/
+class QDLT_EXPORT QDltSignalExtractor : public QObject
+{
+    Q_OBJECT
+public:
+    QDltSignalExtractor(QDltFile *file, QDltPluginManager *pluginManager = 0);
+    ~QDltSignalExtractor();
+
+    //! Decode the messages with the enabled decoder plugins, enabled by default.
+    void setPluginsEnabled(bool enabled);
+
+    //! Save and load series in the index cache directory of the log file, disabled by default.
+    void setCacheEnabled(bool enabled);
+
+    //! Get the series of the signals, extracting the missing ones.
+    /*!
+      Waits until the extraction is finished, use requestSeries() in the GUI thread.
+      \param specs The signals
+      \return One series for each signal in the same order, empty series if cancelled
+    */
+    QList<QDltSignalSeries> series(const QList<QDltSignalSpec> &specs);
+
+    //! Request the series of the signals without waiting.
+    /*!
+      The requests are handled one after the other in a background thread.
+      The signal seriesFinished() is emitted with the series when the request
+      is finished, nothing is emitted if the request is cancelled.
+      \param specs The signals
+      \return Number of the request
+    */
+    int requestSeries(const QList<QDltSignalSpec> &specs);
+
+    //! Cancel the running and the waiting requests and extractions.
+    void cancel();
+
+    //! Cancel and wait until the running requests and extractions are finished.
+    /*!
+      Must be called before the log files are closed or opened again,
+      the extraction reads the files of the QDltFile.
+    */
+    void stop();
+
+    //! Release all series kept in memory, cancels the running extractions.
+    void clear();
+
+    //! Add the bytes used by the series kept in memory.
+    void memoryUsage(QDltMemoryUsage &usage);
+
+signals:
+    //! Progress of the extraction of a request in percent.
+    void progress(int request, int percent);
+
+    //! The series of a request are available, one series for each signal in the same order.
+    void seriesFinished(int request, const QList<QDltSignalSeries> &series);
+
+private:
+    friend class QDltSignalRequestTask;
+
+    bool lookup(const QList<QDltSignalSpec> &specs, int generation, int request, QList<QDltSignalSeries> &result);
+    QString fingerprint();
+    QString cacheFilename(const QString &fingerprint, const QDltSignalSpec &spec);
+    bool extract(const QList<QDltSignalSpec> &specs, int generation, int request, QList<QDltSignalSeries> &result);
+
+    QDltFile *file;
+    QDltPluginManager *pluginManager;
+    QAtomicInt pluginsEnabled;
+    QAtomicInt cacheEnabled;
+
+    QAtomicInt generation;  /* incremented to cancel the running extractions */
+    QAtomicInt requests;
+    QThreadPool requestPool;
+
+    QMutex mutex;
+    QString cacheFingerprint;
+    QHash<QString,QDltSignalSeries> cache;
+};
+
+#endif // QDLTSIGNAL_H
@@ -0,0 +1,140 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdlttimeformatter.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QDateTime>
+#include <cstring>
+
+#include "qdlttimeformatter.h"
+
+QDltTimeFormatter::QDltTimeFormatter()
+{
+    local = true;
+    offset = 0;
+    dst = false;
+    clearCache();
+}
+
+void QDltTimeFormatter::clearCache()
+{
+    for(int num = 0; num < QDLT_TIME_FORMATTER_CACHE_SIZE; num++)
+        cache[num].valid = false;
+}
+
+void QDltTimeFormatter::setLocalTime()
+{
+    if(local)
+        return;
+    local = true;
+    clearCache();
+}
+
+void QDltTimeFormatter::setUtcOffset(qlonglong utcOffsetInSeconds, bool dst)
+{
+    if(!local && offset == utcOffsetInSeconds && this->dst == dst)
+        return;
+    local = false;
+    offset = utcOffsetInSeconds;
+    this->dst = dst;
+    clearCache();
+}
+
+QString QDltTimeFormatter::time(time_t seconds, unsigned int microseconds)
+{
+    Entry &entry = cache[(quint64) seconds % QDLT_TIME_FORMATTER_CACHE_SIZE];
+    if(!entry.valid || entry.seconds != seconds)
+    {
+        entry.prefix = local ? localTimeString(seconds) : gmTimeWithOffsetString(seconds, offset, dst);
+        entry.prefix += QLatin1Char('.');
+        entry.seconds = seconds;
+        entry.valid = true;
+    }
+
+    /* append six digits, like arg(microseconds,6,10,QLatin1Char('0')) */
+    int length = entry.prefix.size();
+    QString text(length + 6, Qt::Uninitialized);
+    QChar *data = text.data();
+    memcpy(data, entry.prefix.constData(), length * sizeof(QChar));
+    for(int pos = length + 5; pos >= length; pos--)
+    {
+        data[pos] = QLatin1Char('0' + microseconds % 10);
+        microseconds /= 10;
+    }
+    if(microseconds)
+        return entry.prefix + QString::number(microseconds) + text.mid(length);
+
+    return text;
+}
+
+QString QDltTimeFormatter::timestamp(unsigned int timestamp)
+{
+    /* seconds with at least one digit, a dot and four digits */
+    QChar buffer[16];
+    int pos = 16;
+    unsigned int value = timestamp;
+    for(int num = 0; num < 4; num++)
+    {
+        buffer[--pos] = QLatin1Char('0' + value % 10);
+        value /= 10;
+    }
+    buffer[--pos] = QLatin1Char('.');
+    do
+    {
+        buffer[--pos] = QLatin1Char('0' + value % 10);
+        value /= 10;
+    } while(value);
+
+    return QString(buffer + pos, 16 - pos);
+}
+
+QString QDltTimeFormatter::localTimeString(time_t seconds)
+{
+    char strtime[256];
+    struct tm *time_tm;
+    time_tm = localtime(&seconds);
+    if(time_tm)
+        strftime(strtime, 256, "%Y/%m/%d %H:%M:%S", time_tm);
+    else
+        strtime[0] = 0;
+    return QString(strtime);
+}
+
+QString QDltTimeFormatter::gmTimeWithOffsetString(time_t seconds, qlonglong utcOffsetInSeconds, bool dst)
+{
+    struct tm *time_tm;
+    time_tm = gmtime(&seconds);
+    if(!time_tm)
+        return QString("Invalid date");
+
+    /*Reason for adding:
+        tm_mon	months since January	0-11
+        tm_year	years since 1900
+    */
+    QDate date(time_tm->tm_year+1900,time_tm->tm_mon+1,time_tm->tm_mday);
+    QTime time(time_tm->tm_hour,time_tm->tm_min,time_tm->tm_sec);
+
+    if(!date.isValid() || !time.isValid())
+        return QString("Invalid date");
+
+    QDateTime gmDateTime(date,time,Qt::UTC);
+
+    gmDateTime = gmDateTime.addSecs(utcOffsetInSeconds);
+
+    if(dst)
+       gmDateTime = gmDateTime.addSecs(3600);
+
+    return gmDateTime.toString("yyyy/MM/dd hh:mm:ss");
+}
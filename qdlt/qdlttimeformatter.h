@@ -0,0 +1,79 @@
+/**
+ * @licence app begin@
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \file qdlttimeformatter.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLTTIMEFORMATTER_H
+#define QDLTTIMEFORMATTER_H
+
+#include <QString>
+#include <time.h>
+
+#include "export_rules.h"
+
+#define QDLT_TIME_FORMATTER_CACHE_SIZE 64
+
+//! Formats message times and timestamps for display and export.
+/*!
+  Formatting the date and time of a message is expensive, but many
+  consecutive messages are logged in the same second. The formatted
+  date and time of a second is kept in a small cache, the microseconds
+  are appended with a fast integer formatter. The cache is not thread
+  safe, each thread must use its own formatter.
+*/
+class QDLT_EXPORT QDltTimeFormatter
+{
+public:
+    QDltTimeFormatter();
+
+    //! Format times in the local time zone of the system, the default.
+    void setLocalTime();
+
+    //! Format times based on gmtime with an offset.
+    /*!
+      \param utcOffsetInSeconds Offset in seconds added to gmtime.
+      \param dst Daylight saving time - if true, adding automatically 3600 seconds on top.
+    */
+    void setUtcOffset(qlonglong utcOffsetInSeconds, bool dst);
+
+    //! Format the time of a message, e.g. "2024/01/31 12:00:00.123456".
+    QString time(time_t seconds, unsigned int microseconds);
+
+    //! Format a timestamp in 0.1 milliseconds, e.g. "1234.5678".
+    static QString timestamp(unsigned int timestamp);
+
+    //! Format the date and time in the local time zone, e.g. "2024/01/31 12:00:00".
+    static QString localTimeString(time_t seconds);
+
+    //! Format the date and time based on gmtime with an offset.
+    static QString gmTimeWithOffsetString(time_t seconds, qlonglong utcOffsetInSeconds, bool dst);
+
+private:
+    struct Entry
+    {
+        time_t seconds;
+        bool valid;
+        QString prefix;     /* formatted date and time including the dot */
+    };
+
+    void clearCache();
+
+    bool local;
+    qlonglong offset;
+    bool dst;
+    Entry cache[QDLT_TIME_FORMATTER_CACHE_SIZE];
+};
+
+#endif // QDLTTIMEFORMATTER_H
@@ -0,0 +1,248 @@
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+#include "dltcolumnarwriter.h"
+
+DltColumnarWriter::DltColumnarWriter()
+{
+    device = 0;
+    columnCount = 0;
+    argumentsEnabled = true;
+    error = false;
+    batchRows = 0;
+    batchArguments = 0;
+    rows = 0;
+}
+
+void DltColumnarWriter::addColumn(int num, const QString &name, ColumnType type)
+{
+    columns[num].name = name;
+    columns[num].type = type;
+}
+
+bool DltColumnarWriter::start(QIODevice *device)
+{
+    this->device = device;
+    error = false;
+    rows = 0;
+
+    columns.clear();
+    columns.resize(ColCount);
+    addColumn(ColIndex, "index", ColumnInt64);
+    addColumn(ColTime, "time_us", ColumnInt64);
+    addColumn(ColTimestamp, "timestamp_100us", ColumnUInt32);
+    addColumn(ColCounter, "counter", ColumnUInt8);
+    addColumn(ColEcuId, "ecuid", ColumnString);
+    addColumn(ColAppId, "apid", ColumnString);
+    addColumn(ColContextId, "ctid", ColumnString);
+    addColumn(ColSessionId, "sessionid", ColumnUInt32);
+    addColumn(ColType, "type", ColumnUInt8);
+    addColumn(ColSubtype, "subtype", ColumnUInt8);
+    addColumn(ColMode, "mode", ColumnUInt8);
+    addColumn(ColArgCount, "argcount", ColumnUInt8);
+    addColumn(ColMessageId, "messageid", ColumnUInt32);
+    addColumn(ColPayload, "payload", ColumnString);
+    addColumn(ColPayloadRaw, "payload_raw", ColumnBinary);
+    addColumn(ColArgs, "args", ColumnList);
+    addColumn(ColArgType, "arg_type", ColumnUInt8);
+    addColumn(ColArgName, "arg_name", ColumnString);
+    addColumn(ColArgInt, "arg_int", ColumnInt64);
+    addColumn(ColArgFloat, "arg_float", ColumnDouble);
+    addColumn(ColArgText, "arg_text", ColumnString);
+    columnCount = argumentsEnabled ? (int) ColCount : (int) ColArgs;
+
+    /* file header and column descriptors */
+    QByteArray header(DLT_COLUMNAR_MAGIC);
+    uchar value[4];
+    qToLittleEndian<quint32>(DLT_COLUMNAR_VERSION, value);
+    header.append((const char*) value, 4);
+    qToLittleEndian<quint32>(columnCount, value);
+    header.append((const char*) value, 4);
+    for(int num = 0; num < columnCount; num++)
+    {
+        QByteArray name = columns[num].name.toUtf8();
+        header.append((char) columns[num].type);
+        header.append((char) 0);
+        qToLittleEndian<quint16>(name.size(), value);
+        header.append((const char*) value, 2);
+        header.append(name);
+    }
+
+    clearBatch();
+
+    return write(header);
+}
+
+void DltColumnarWriter::clearBatch()
+{
+    for(int num = 0; num < columns.size(); num++)
+    {
+        Column &column = columns[num];
+        column.data.clear();
+        column.bytes.clear();
+        if(column.type == ColumnString || column.type == ColumnBinary || column.type == ColumnList)
+            appendUInt32(num, 0);
+    }
+    batchRows = 0;
+    batchArguments = 0;
+}
+
+bool DltColumnarWriter::addMessage(qint64 index, QDltMsg &msg)
+{
+    if(!device || error)
+        return false;
+
+    appendInt64(ColIndex, index);
+    appendInt64(ColTime, (qint64) msg.getTime() * 1000000 + msg.getMicroseconds());
+    appendUInt32(ColTimestamp, msg.getTimestamp());
+    appendUInt8(ColCounter, msg.getMessageCounter());
+    appendBytes(ColEcuId, msg.getEcuid().toUtf8());
+    appendBytes(ColAppId, msg.getApid().toUtf8());
+    appendBytes(ColContextId, msg.getCtid().toUtf8());
+    appendUInt32(ColSessionId, msg.getSessionid());
+    appendUInt8(ColType, (quint8) msg.getType());
+    appendUInt8(ColSubtype, (quint8) msg.getSubtype());
+    appendUInt8(ColMode, (quint8) msg.getMode());
+    appendUInt8(ColArgCount, (quint8) msg.getNumberOfArguments());
+    appendUInt32(ColMessageId, msg.getMessageId());
+    appendBytes(ColPayload, msg.toStringPayload().toUtf8());
+    appendBytes(ColPayloadRaw, msg.getPayload());
+
+    if(argumentsEnabled)
+    {
+        QDltArgument arg;
+        for(int num = 0; num < msg.sizeArguments(); num++)
+        {
+            if(!msg.getArgument(num, arg))
+                continue;
+
+            qint64 intValue = 0;
+            double floatValue = 0.0;
+            QByteArray text;
+            switch(arg.getTypeInfo())
+            {
+            case QDltArgument::DltTypeInfoBool:
+            case QDltArgument::DltTypeInfoSInt:
+                intValue = arg.getValue().toLongLong();
+                floatValue = (double) intValue;
+                break;
+            case QDltArgument::DltTypeInfoUInt:
+                /* values above the signed range wrap around, arg_float keeps the magnitude */
+                intValue = (qint64) arg.getValue().toULongLong();
+                floatValue = (double) arg.getValue().toULongLong();
+                break;
+            case QDltArgument::DltTypeInfoFloa:
+                floatValue = arg.getValue().toDouble();
+                intValue = (qint64) floatValue;
+                break;
+            default:
+                text = arg.toString().toUtf8();
+                break;
+            }
+
+            appendUInt8(ColArgType, (quint8) arg.getTypeInfo());
+            appendBytes(ColArgName, arg.getName().toUtf8());
+            appendInt64(ColArgInt, intValue);
+            appendDouble(ColArgFloat, floatValue);
+            appendBytes(ColArgText, text);
+            batchArguments++;
+        }
+        appendUInt32(ColArgs, batchArguments);
+    }
+
+    rows++;
+    if(++batchRows >= DLT_COLUMNAR_BATCH_SIZE)
+        return writeBatch();
+
+    return true;
+}
+
+bool DltColumnarWriter::finish()
+{
+    if(!device)
+        return false;
+
+    if(batchRows > 0)
+        writeBatch();
+
+    uchar value[8];
+    QByteArray end;
+    qToLittleEndian<quint32>(0, value);
+    end.append((const char*) value, 4);
+    qToLittleEndian<quint64>(rows, value);
+    end.append((const char*) value, 8);
+    write(end);
+
+    device = 0;
+    if(error)
+        qDebug() << "Columnar export failed after" << rows << "messages";
+
+    return !error;
+}
+
+bool DltColumnarWriter::writeBatch()
+{
+    uchar value[8];
+    QByteArray header;
+    qToLittleEndian<quint32>(batchRows, value);
+    header.append((const char*) value, 4);
+    write(header);
+
+    for(int num = 0; num < columnCount && !error; num++)
+    {
+        const Column &column = columns[num];
+        qToLittleEndian<quint64>(column.data.size() + column.bytes.size(), value);
+        write(QByteArray((const char*) value, 8));
+        write(column.data);
+        write(column.bytes);
+    }
+
+    clearBatch();
+
+    return !error;
+}
+
+bool DltColumnarWriter::write(const QByteArray &data)
+{
+    if(error)
+        return false;
+    if(!data.isEmpty() && device->write(data) != data.size())
+        error = true;
+    return !error;
+}
+
+void DltColumnarWriter::appendInt64(int num, qint64 value)
+{
+    uchar buffer[8];
+    qToLittleEndian<qint64>(value, buffer);
+    columns[num].data.append((const char*) buffer, 8);
+}
+
+void DltColumnarWriter::appendUInt32(int num, quint32 value)
+{
+    uchar buffer[4];
+    qToLittleEndian<quint32>(value, buffer);
+    columns[num].data.append((const char*) buffer, 4);
+}
+
+void DltColumnarWriter::appendUInt8(int num, quint8 value)
+{
+    columns[num].data.append((char) value);
+}
+
+void DltColumnarWriter::appendDouble(int num, double value)
+{
+    quint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uchar buffer[8];
+    qToLittleEndian<quint64>(bits, buffer);
+    columns[num].data.append((const char*) buffer, 8);
+}
+
+void DltColumnarWriter::appendBytes(int num, const QByteArray &value)
+{
+    Column &column = columns[num];
+    column.bytes.append(value);
+    appendUInt32(num, column.bytes.size());
+}
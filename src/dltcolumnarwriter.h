@@ -0,0 +1,91 @@
+#ifndef DLTCOLUMNARWRITER_H
+#define DLTCOLUMNARWRITER_H
+
+#include <QIODevice>
+#include <QByteArray>
+#include <QVector>
+
+#include "qdlt.h"
+
+#define DLT_COLUMNAR_MAGIC "DLTC"
+#define DLT_COLUMNAR_VERSION 1
+#define DLT_COLUMNAR_BATCH_SIZE 65536
+
+//! Writes messages as typed columns for analysis tools
+/*!
+  The file is self describing, all values are little endian:
+
+  file header: "DLTC", uint32 version, uint32 column count
+  per column:  uint8 type, uint8 reserved, uint16 name length, UTF-8 name
+  per batch:   uint32 row count, per column uint64 data length and data
+  end:         uint32 0, uint64 total row count
+
+  Fixed size columns contain one value per row. String and binary
+  columns contain row count + 1 uint32 offsets followed by the bytes.
+  The list column "args" contains row count + 1 uint32 offsets into
+  the following "arg_" columns, which contain one value per argument.
+  A batch contains at most DLT_COLUMNAR_BATCH_SIZE rows, so a reader
+  can map a batch column directly into an array.
+*/
+class DltColumnarWriter
+{
+public:
+    typedef enum { ColumnInt64 = 1, ColumnUInt32, ColumnUInt8, ColumnDouble, ColumnString, ColumnBinary, ColumnList } ColumnType;
+
+    DltColumnarWriter();
+
+    //! Add the decoded arguments as typed columns, enabled by default
+    void setArgumentsEnabled(bool enable) { argumentsEnabled = enable; }
+    bool getArgumentsEnabled() const { return argumentsEnabled; }
+
+    //! Write the file header to an open device
+    bool start(QIODevice *device);
+
+    //! Add a message, a batch is written when it is full
+    bool addMessage(qint64 index, QDltMsg &msg);
+
+    //! Write the last batch and the end marker
+    bool finish();
+
+    qint64 getRows() const { return rows; }
+
+private:
+    enum
+    {
+        ColIndex, ColTime, ColTimestamp, ColCounter, ColEcuId, ColAppId, ColContextId,
+        ColSessionId, ColType, ColSubtype, ColMode, ColArgCount, ColMessageId,
+        ColPayload, ColPayloadRaw,
+        ColArgs, ColArgType, ColArgName, ColArgInt, ColArgFloat, ColArgText,
+        ColCount
+    };
+
+    struct Column
+    {
+        QString name;
+        ColumnType type;
+        QByteArray data;    // values or offsets
+        QByteArray bytes;   // string and binary data
+    };
+
+    void addColumn(int num, const QString &name, ColumnType type);
+    void clearBatch();
+    bool writeBatch();
+    bool write(const QByteArray &data);
+
+    void appendInt64(int num, qint64 value);
+    void appendUInt32(int num, quint32 value);
+    void appendUInt8(int num, quint8 value);
+    void appendDouble(int num, double value);
+    void appendBytes(int num, const QByteArray &value);
+
+    QIODevice *device;
+    QVector<Column> columns;
+    int columnCount;
+    bool argumentsEnabled;
+    bool error;
+    int batchRows;
+    quint32 batchArguments;
+    qint64 rows;
+};
+
+#endif // DLTCOLUMNARWRITER_H
@@ -2,11 +2,27 @@
 #include <QMessageBox>
 #include <QApplication>
 #include <QClipboard>
+#include <QThread>
 
 #include "dltexporter.h"
 #include "fieldnames.h"
 #include "project.h"
 
+QAtomicInt DltExporter::running;
+
+/* runs the export loop, while the GUI thread shows the progress */
+class DltExporterWorker : public QThread
+{
+public:
+    DltExporterWorker(DltExporter *exporter) : exporter(exporter) {}
+
+protected:
+    void run() { exporter->exportLoop(); }
+
+private:
+    DltExporter *exporter;
+};
+
 DltExporter::DltExporter(QObject *parent) :
     QObject(parent)
 {
@@ -19,6 +35,14 @@ DltExporter::DltExporter(QObject *parent) :
     exportSelection = SelectionAll;
     starting_index=0;
     stoping_index=0;
+    messages = NULL;
+    loopStart = 0;
+    loopStop = 0;
+    decodeSilent = false;
+    stopFlag.storeRelease(0);
+    readErrors = 0;
+    exportErrors = 0;
+    exportCounter = 0;
 }
 
 QString DltExporter::escapeCSVValue(QString arg)
@@ -52,8 +76,8 @@ void DltExporter::writeCSVLine(int index, QFile *to, QDltMsg msg)
     QString text("");
 
     text += escapeCSVValue(QString("%1").arg(index)).append(",");
-    text += escapeCSVValue(QString("%1.%2").arg(msg.getTimeString()).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'))).append(",");
-    text += escapeCSVValue(QString("%1.%2").arg(msg.getTimestamp()/10000).arg(msg.getTimestamp()%10000,4,10,QLatin1Char('0'))).append(",");
+    text += escapeCSVValue(timeFormatter.time(msg.getTime(),msg.getMicroseconds())).append(",");
+    text += escapeCSVValue(QDltTimeFormatter::timestamp(msg.getTimestamp())).append(",");
     text += escapeCSVValue(QString("%1").arg(msg.getMessageCounter())).append(",");
     text += escapeCSVValue(QString("%1").arg(msg.getEcuid())).append(",");
     text += escapeCSVValue(QString("%1").arg(msg.getApid())).append(",");
@@ -84,10 +108,11 @@ bool DltExporter::start()
         }
     }
 
-    /* open the export file */
+    /* open the export file, the clipboard formats can be written to a file */
     if(exportFormat == DltExporter::FormatAscii ||
        exportFormat == DltExporter::FormatUTF8 ||
-       exportFormat == DltExporter::FormatCsv)
+       exportFormat == DltExporter::FormatCsv ||
+       ((exportFormat == DltExporter::FormatClipboard || exportFormat == DltExporter::FormatClipboardPayloadOnly) && to))
     {
         if(!to->open(QIODevice::WriteOnly | QIODevice::Text))
         {
@@ -101,7 +126,7 @@ bool DltExporter::start()
             return false;
         }
     }
-    else if((exportFormat == DltExporter::FormatDlt)||(exportFormat == DltExporter::FormatDltDecoded))
+    else if((exportFormat == DltExporter::FormatDlt)||(exportFormat == DltExporter::FormatDltDecoded)||(exportFormat == DltExporter::FormatColumnar))
     {
         if(!to->open(QIODevice::WriteOnly))
         {
@@ -133,6 +158,22 @@ bool DltExporter::start()
         }
     }
 
+    /* write column descriptors if columnar export */
+    if(exportFormat == DltExporter::FormatColumnar)
+    {
+        if(!columnar.start(to))
+        {
+            if ( true == QDltOptManager::getInstance()->issilentMode() )
+             {
+             qDebug() << QString("ERROR - cannot write the export file %1").arg(to->fileName());
+             }
+            else
+            QMessageBox::critical(qobject_cast<QWidget *>(parent()), QString("DLT Viewer"),
+                                  QString("Cannot write the export file %1").arg(to->fileName()));
+            return false;
+        }
+    }
+
     /* calculate size */
     if(exportSelection == DltExporter::SelectionAll)
         size = from->size();
@@ -149,12 +190,21 @@ bool DltExporter::start()
 
 bool DltExporter::finish()
 {
+    bool result = true;
+
+    /* write last batch of columnar export */
+    if(exportFormat == DltExporter::FormatColumnar)
+    {
+        result = columnar.finish();
+    }
 
     if(exportFormat == DltExporter::FormatAscii ||
        exportFormat == DltExporter::FormatUTF8 ||
        exportFormat == DltExporter::FormatCsv ||
        exportFormat == DltExporter::FormatDlt ||
-       exportFormat == DltExporter::FormatDltDecoded)
+       exportFormat == DltExporter::FormatDltDecoded ||
+       exportFormat == DltExporter::FormatColumnar ||
+       to)
     {
         /* close output file */
         to->close();
@@ -173,23 +223,19 @@ bool DltExporter::finish()
         clipboard->setText(clipboardString);
     }
 
-    return true;
+    return result;
 }
 
-bool DltExporter::getMsg(unsigned long int num,QDltMsg &msg,QByteArray &buf)
+bool DltExporter::getMsg(QDltFileIterator &messages,unsigned long int num,QDltMsg &msg,QByteArray &buf)
 {
     buf.clear();
-    if(exportSelection == DltExporter::SelectionAll)
-    {
-        buf = from->getMsg(num);
-    }
-    else if(exportSelection == DltExporter::SelectionFiltered)
-    {
-        buf = from->getMsgFilter(num);
-    }
-    else if(exportSelection == DltExporter::SelectionSelected)
+    if(exportSelection == DltExporter::SelectionAll ||
+       exportSelection == DltExporter::SelectionFiltered ||
+       exportSelection == DltExporter::SelectionSelected)
     {
-        buf = from->getMsgFilter(selectedRows[num]);
+        /* the data is only valid until the next block is read */
+        if(messages.seek(num))
+            buf = messages.data();
     }
     else
     {
@@ -229,7 +275,7 @@ bool DltExporter::exportMsg(unsigned long int num, QDltMsg &msg, QByteArray &buf
                 text += QString("%1 ").arg(from->getMsgFilterPos(selectedRows[num]));
             else
                 return false;
-            text += msg.toStringHeader();
+            text += msg.toStringHeader(timeFormatter);
             text += " ";
         }
         text += msg.toStringPayload().trimmed();
@@ -241,6 +287,9 @@ bool DltExporter::exportMsg(unsigned long int num, QDltMsg &msg, QByteArray &buf
                 to->write(text.toLatin1().constData());
             else if (exportFormat == DltExporter::FormatUTF8)
                 to->write(text.toUtf8().constData());
+            else if(to)
+                /* clipboard text streamed to a file */
+                to->write(text.toUtf8().constData());
             else if(exportFormat == DltExporter::FormatClipboard ||
                     exportFormat == DltExporter::FormatClipboardPayloadOnly)
                 clipboardString += text;
@@ -260,6 +309,17 @@ bool DltExporter::exportMsg(unsigned long int num, QDltMsg &msg, QByteArray &buf
         else
             return false;
     }
+    else if(exportFormat == DltExporter::FormatColumnar)
+    {
+        if(exportSelection == DltExporter::SelectionAll)
+            return columnar.addMessage(num, msg);
+        else if(exportSelection == DltExporter::SelectionFiltered)
+            return columnar.addMessage(from->getMsgFilterPos(num), msg);
+        else if(exportSelection == DltExporter::SelectionSelected)
+            return columnar.addMessage(from->getMsgFilterPos(selectedRows[num]), msg);
+        else
+            return false;
+    }
 
     return true;
 }
@@ -275,24 +335,38 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
                                  DltExporter::DltExportFormat exportFormat,
                                  DltExporter::DltExportSelection exportSelection, QModelIndexList *selection)
 {
-    QDltMsg msg;
-    QByteArray buf;
+    this->selection = selection;
+    selectedRows.clear();
+    exportRows(from, to, pluginManager, exportFormat, exportSelection);
+}
+
+void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *pluginManager,
+                                 DltExporter::DltExportFormat exportFormat, const QList<int> &rows)
+{
+    this->selection = NULL;
+    selectedRows = rows;
+    exportRows(from, to, pluginManager, exportFormat, DltExporter::SelectionSelected);
+}
+
+void DltExporter::exportRows(QDltFile *from, QFile *to, QDltPluginManager *pluginManager,
+                             DltExporter::DltExportFormat exportFormat,
+                             DltExporter::DltExportSelection exportSelection)
+{
     float percent=0;
-    QString qszPercent;
     /* initialise values */
-    int readErrors=0;
-    int exportErrors=0;
-    int exportCounter=0;
+    readErrors=0;
+    exportErrors=0;
+    exportCounter=0;
     int startFinishError=0;
     this->from = from;
     this->to = to;
     clipboardString.clear();
     this->pluginManager = pluginManager;
-    this->selection = selection;
     this->exportFormat = exportFormat;
     this->exportSelection = exportSelection;
     unsigned long int starting = 0;
     unsigned long int stoping = this->size;
+    QDltProfilerSpan span("export", QStringLiteral("Export"));
     /* start export */
     if(false == start())
     {
@@ -304,6 +378,18 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
 
     bool silentMode = !QDltOptManager::getInstance()->issilentMode();
 
+    /* messages are read in blocks, the selection as list of positions in the file */
+    QVector<qint64> selectedIndexes;
+    if(exportSelection == DltExporter::SelectionSelected)
+    {
+        selectedIndexes.reserve(selectedRows.size());
+        for(int num = 0; num < selectedRows.size(); num++)
+            selectedIndexes.append(from->getMsgFilterPos(selectedRows[num]));
+    }
+    QDltFileIterator iterator = (exportSelection == DltExporter::SelectionSelected) ?
+                QDltFileIterator(from, selectedIndexes) :
+                QDltFileIterator(from, exportSelection == DltExporter::SelectionAll ? QDltFileIterator::AllMessages : QDltFileIterator::FilteredMessages);
+
     if ( this->stoping_index == 0 || this->stoping_index > this->size || this->stoping_index < this->starting_index )
     {
         stoping = this->size;
@@ -317,53 +403,112 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
         qDebug() << "Start DLT export" << stoping - starting << "messages" << "of" << this->size << "range: " << starting << "-" << stoping << ",silent mode" << !silentMode;
     }
 
-    /* init fileprogress */
+    messages = &iterator;
+    loopStart = starting;
+    loopStop = stoping;
+    decodeSilent = silentMode;
+    stopFlag.storeRelease(0);
+    progressValue.store((int) starting);
 
-    QProgressDialog fileprogress("Export ...", "Cancel", 0, stoping, qobject_cast<QWidget *>(parent()));
     if (silentMode == true)
-     {
-      fileprogress.setWindowTitle("DLT Viewer");
-      fileprogress.setWindowModality(Qt::WindowModal);
-      fileprogress.show();
-     }
+    {
+        /* export in a thread, the GUI keeps receiving messages and shows the progress */
+        QProgressDialog fileprogress("Export ...", "Cancel", 0, stoping, qobject_cast<QWidget *>(parent()));
+        fileprogress.setWindowTitle("DLT Viewer");
+        fileprogress.setWindowModality(Qt::WindowModal);
+        fileprogress.show();
+
+        DltExporterWorker worker(this);
+        running.ref();
+        worker.start();
+        while(!worker.wait(50))
+        {
+            fileprogress.setValue(progressValue.load());
+            QApplication::processEvents();
+            if(fileprogress.wasCanceled())
+                stopFlag.storeRelease(1);
+        }
+        running.deref();
+        fileprogress.close();
+    }
+    else
+    {
+        exportLoop();
+    }
+    messages = NULL;
 
-    for(starting;starting<stoping;starting++)
+    if(stopFlag.loadAcquire())
     {
-        // Update progress dialog every 1000 lines
+        qDebug().noquote() << "Export canceled !";
+        return;
+    }
+
+
+    if (!finish())
+    {
+        startFinishError++;
+    }
+
+
+    if ( startFinishError>0 || readErrors>0 || exportErrors>0 )
+    {
+       //qDebug() << "DLT Export finish() failed";
+       if (silentMode == true ) // reversed login in this case !
+       {
+        QMessageBox::warning(NULL,"Export Errors!",QString("Exported successful: %1 / %2\n\nReadErrors:%3\nWriteErrors:%4\nStart/Finish errors:%5").arg(exportCounter).arg(size).arg(readErrors).arg(exportErrors).arg(startFinishError));
+       }
+       return;
+    }
+    if ( stoping != 0 )
+    {
+     percent=(( stoping * 100.0 ) / stoping );
+    }
+    else
+    {
+     percent = 0;
+    }
+
+    qDebug() << percent << "%" << "DLT export done for" << exportCounter << "messages with result" << startFinishError;// << __FILE__ << __LINE__;
+}
+
+void DltExporter::exportLoop()
+{
+    QDltMsg msg;
+    QByteArray buf;
+    float percent=0;
+    QString qszPercent;
+
+    for(unsigned long int starting = loopStart;starting<loopStop;starting++)
+    {
+        // Update progress every 1000 lines
 
         if( 0 == (starting%1000))
         {
-          percent=(( starting * 100.0 ) /stoping );
-          if (silentMode == true)
-             {
-              fileprogress.setValue(starting);
-             }
+          progressValue.store((int) starting);
           if( 0 == (starting%1000000))
           {
+           percent=(( starting * 100.0 ) /loopStop );
            qszPercent = QString("Exported: %1 %").arg(percent, 0, 'f',2);
            qDebug().noquote() << qszPercent;
           }
         }
 
-        if (fileprogress.wasCanceled() == true)
+        if (stopFlag.loadAcquire())
         {
-            qDebug().noquote() << "Export canceled !";
             return;
         }
 
         // get message
-        if(false == getMsg(starting,msg,buf))
+        if(false == getMsg(*messages,starting,msg,buf))
         {
-        //  finish();
         //qDebug() << "DLT Export getMsg failed on msg index" << starting;
         readErrors++;
         continue;
-        //  return;
         }
         // decode message if needed
         if(exportFormat != DltExporter::FormatDlt)
         {
-            pluginManager->decodeMsg(msg,silentMode);
+            pluginManager->decodeMsg(msg,decodeSilent);
             if (exportFormat == DltExporter::FormatDltDecoded)
             {
                 msg.setNumberOfArguments(msg.sizeArguments());
@@ -374,7 +519,6 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
         // export message
         if(!exportMsg(starting,msg,buf))
         {
-            // finish();
           //qDebug() << "DLT Export exportMsg() failed";
           exportErrors++;
           continue;
@@ -383,36 +527,4 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
      else
         exportCounter++;
     } // for loop
-
-    if (silentMode == true)
-    {
-     fileprogress.close();
-    }
-
-
-    if (!finish())
-    {
-        startFinishError++;
-    }
-
-
-    if ( startFinishError>0 || readErrors>0 || exportErrors>0 )
-    {
-       //qDebug() << "DLT Export finish() failed";
-       if (silentMode == true ) // reversed login in this case !
-       {
-        QMessageBox::warning(NULL,"Export Errors!",QString("Exported successful: %1 / %2\n\nReadErrors:%3\nWriteErrors:%4\nStart/Finish errors:%5").arg(exportCounter).arg(size).arg(readErrors).arg(exportErrors).arg(startFinishError));
-       }
-       return;
-    }
-    if ( stoping != 0 )
-    {
-     percent=(( starting * 100.0 ) / stoping );
-    }
-    else
-    {
-     percent = 0;
-    }
-
-    qDebug() << percent << "%" << "DLT export done for" << exportCounter << "messages with result" << startFinishError;// << __FILE__ << __LINE__;
 }
@@ -7,6 +7,10 @@
 #include <QTreeWidget>
 
 #include "qdlt.h"
+#include "dltcolumnarwriter.h"
+
+/* larger selections are not copied to the clipboard, but exported to a file */
+#define DLT_EXPORTER_CLIPBOARD_MAX_ROWS 100000
 
 class DltExporter : public QObject
 {
@@ -14,7 +18,7 @@ class DltExporter : public QObject
 
 public:
 
-    typedef enum { FormatDlt,FormatAscii,FormatCsv,FormatClipboard,FormatClipboardPayloadOnly,FormatDltDecoded,FormatUTF8} DltExportFormat;
+    typedef enum { FormatDlt,FormatAscii,FormatCsv,FormatClipboard,FormatClipboardPayloadOnly,FormatDltDecoded,FormatUTF8,FormatColumnar} DltExportFormat;
 
     typedef enum { SelectionAll,SelectionFiltered,SelectionSelected } DltExportSelection;
 
@@ -42,9 +46,18 @@ private:
 
     bool start();
     bool finish();
-    bool getMsg(unsigned long int num, QDltMsg &msg, QByteArray &buf);
+    bool getMsg(QDltFileIterator &messages, unsigned long int num, QDltMsg &msg, QByteArray &buf);
     bool exportMsg(unsigned long int num, QDltMsg &msg,QByteArray &buf);
 
+    void exportRows(QDltFile *from, QFile *to, QDltPluginManager *pluginManager,
+                    DltExporter::DltExportFormat exportFormat,
+                    DltExporter::DltExportSelection exportSelection);
+
+    /* Export the messages from loopStart to loopStop, runs in the worker thread in GUI mode */
+    void exportLoop();
+
+    friend class DltExporterWorker;
+
 public:
 
     /* Default QT constructor.
@@ -64,8 +77,26 @@ public:
                         DltExporter::DltExportFormat exportFormat,
                         DltExporter::DltExportSelection exportSelection, QModelIndexList *selection = 0);
 
+    /* Export selected rows of the filtered messages.
+     * Uses less memory than a selection of model indexes for large selections.
+     * The clipboard formats are written to the file, if a file is given.
+     * \param rows Sorted list of rows in the filtered messages
+     */
+    void exportMessages(QDltFile *from, QFile *to, QDltPluginManager *pluginManager,
+                        DltExporter::DltExportFormat exportFormat, const QList<int> &rows);
+
+    /* Check if an export is running in the background.
+     * The log files must not be closed while an export is running.
+     */
+    static bool isRunning() { return running.load() > 0; }
+
     void exportMessageRange(unsigned long start, unsigned long stop);
 
+    /* Write the decoded arguments as typed columns in the columnar format.
+     * \param enable True to add the argument columns, default is true
+     */
+    void setColumnarArgumentsEnabled(bool enable) { columnar.setArgumentsEnabled(enable); }
+
 signals:
 
 public slots:
@@ -77,11 +108,26 @@ private:
     QDltFile *from;
     QFile *to;
     QString clipboardString;
+    DltColumnarWriter columnar;
+    QDltTimeFormatter timeFormatter;
     QDltPluginManager *pluginManager;
     QModelIndexList *selection;
     QList<int> selectedRows;
     DltExporter::DltExportFormat exportFormat;
     DltExporter::DltExportSelection exportSelection;
+
+    /* state of the export loop */
+    QDltFileIterator *messages;
+    unsigned long int loopStart;
+    unsigned long int loopStop;
+    bool decodeSilent;
+    QAtomicInt stopFlag;    /* set by the GUI thread, read by the worker */
+    QAtomicInt progressValue;
+    int readErrors;
+    int exportErrors;
+    int exportCounter;
+
+    static QAtomicInt running;
 };
 
 #endif // DLTEXPORTER_H
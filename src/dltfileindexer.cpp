@@ -6,11 +6,15 @@
 #include <QMessageBox>
 #include <QApplication>
 #include <QTime>
+#include <QElapsedTimer>
 #include <QCryptographicHash>
 #include <QMutexLocker>
 #include <QDir>
 #include <QFileInfo>
 
+#include <cstring>
+#include <algorithm>
+
 
 extern "C" {
     #include "dlt_common.h"
@@ -47,12 +51,15 @@ DltFileIndexer::DltFileIndexer(QObject *parent) :
     multithreaded = true;
     sortByTimeEnabled = false;
     sortByTimestampEnabled = false;
+    foldRepeatsEnabled = false;
 
     maxRun = 0;
     currentRun = 0;
     msecsIndexCounter = 0;
     msecsFilterCounter = 0;
     msecsDefaultFilterCounter = 0;
+    indexBase = 0;
+    blockSummariesComplete = false;
 }
 
 DltFileIndexer::DltFileIndexer(QDltFile *dltFile, QDltPluginManager *pluginManager, QDltDefaultFilter *defaultFilter, QMainWindow *parent) :
@@ -69,6 +76,7 @@ DltFileIndexer::DltFileIndexer(QDltFile *dltFile, QDltPluginManager *pluginManag
     multithreaded = true;
     sortByTimeEnabled = 0;
     sortByTimestampEnabled = 0;
+    foldRepeatsEnabled = 0;
     errors_in_file  = 0;
 
     maxRun = 0;
@@ -76,6 +84,8 @@ DltFileIndexer::DltFileIndexer(QDltFile *dltFile, QDltPluginManager *pluginManag
     msecsIndexCounter = 0;
     msecsFilterCounter = 0;
     msecsDefaultFilterCounter = 0;
+    indexBase = 0;
+    blockSummariesComplete = false;
 }
 
 DltFileIndexer::~DltFileIndexer()
@@ -84,23 +94,28 @@ DltFileIndexer::~DltFileIndexer()
 
 bool DltFileIndexer::index(int num)
 {
-    // start performance counter
-    //QTime time(0,0,0,0);
-    // time.start();
+    QDltProfilerSpan span("indexer", QStringLiteral("Index"));
+
+    fileStatistics.clear();
+    fileRatePyramid.clear();
+    fileBlockSummaries.clear();
 
     // load filter index if enabled
     if(filterCacheEnabled && loadIndexCache(dltFile->getFileName(num)))
     {
         // loading index from filter is succesful
         qDebug() << "Successfully loaded index cache for file" << dltFile->getFileName(num);// << __LINE__;
+        mergeBlockSummaries();
+        statistics.merge(fileStatistics);
+        ratePyramid.merge(fileRatePyramid, indexBase);
         return true;
     }
 
-    // prepare indexing
-    QFile f(dltFile->getFileName(num));
+    // prepare indexing, the next segment is read while the current one is indexed
+    QDltFileReader f(DLT_FILE_INDEXER_READ_AHEAD);
 
     // open file
-    if(!f.open(QIODevice::ReadOnly))
+    if(!f.open(dltFile->getFileName(num)))
     {
         qWarning() << "Cannot open file in DltFileIndexer " << f.errorString();
         return false;
@@ -141,7 +156,13 @@ bool DltFileIndexer::index(int num)
     qint64 number=0;
     int iPercent =0;
     errors_in_file  = 0;
-    char *data = new char[DLT_FILE_INDEXER_SEG_SIZE];
+    QByteArray segment;
+    const char *data = 0;
+    f.seek(0, DLT_FILE_INDEXER_SEG_SIZE);
+
+    // first bytes of the current message, used for the statistics
+    char header[DLT_STATISTICS_HEADER_SIZE];
+    int headerSize = 0;
 
     // Initialise progress bar
     emit(progressText(QString("CI %1/%2").arg(currentRun).arg(maxRun)));
@@ -151,19 +172,27 @@ bool DltFileIndexer::index(int num)
 
     do
     {
-        pos = f.pos();
-        readresult =f.read(data,DLT_FILE_INDEXER_SEG_SIZE);
-        if (length >= 0)
+        readresult = f.read(segment,pos);
+        data = segment.constData();
+        if (readresult >= 0)
         {
            length = readresult;
         }
         else
         {
-            qDebug() << "Error reading input file" << f.fileName() << __LINE__;
+            qDebug() << "Error reading input file" << dltFile->getFileName(num) << __LINE__;
             f.close();
             return false;
         }
 
+        // complete header of a message crossing the segment border
+        if(headerSize > 0 && headerSize < DLT_STATISTICS_HEADER_SIZE)
+        {
+            int count = qMin((qint64)(DLT_STATISTICS_HEADER_SIZE - headerSize), length);
+            memcpy(header + headerSize, data, count);
+            headerSize += count;
+        }
+
         for(number=0;number < length;number++)
         {
             abspos= pos+number;
@@ -186,6 +215,7 @@ bool DltFileIndexer::index(int num)
                     {
                         // last message found in file
                         indexAllList.append(current_message_pos);
+                        addStatistics(header, headerSize, message_length);
                         break;
                     }
                     // speed up move directly to next message, if inside current buffer
@@ -218,6 +248,7 @@ bool DltFileIndexer::index(int num)
                     // very first message detected or the first message after an error occured
                     current_message_pos = pos+number-3;
                     counter_header = 1;
+                    headerSize = copyHeader(header, data + number + 1, length - number - 1);
                     if(current_message_pos!=0)
                     {
                         // first messages not at beginning or error occured before
@@ -236,9 +267,11 @@ bool DltFileIndexer::index(int num)
                 {
                     // Add message only when it is in the correct position in relationship to the last message
                     indexAllList.append(current_message_pos);
+                    addStatistics(header, headerSize, message_length);
                     msgindex++;
                     current_message_pos = pos+number-3;
                     counter_header = 1;
+                    headerSize = copyHeader(header, data + number + 1, length - number - 1);
                     // speed up move directly to message length, if inside current buffer
                     //if ( (errors_in_file > 0)  &&  ((pos%1000)) )    qDebug() << "Add index "<< msgindex << "at file position" << current_message_pos << pos << number << length;
 
@@ -259,11 +292,12 @@ bool DltFileIndexer::index(int num)
                     // Header detected after end of message
                     // start search for new message back after last header found
                     qDebug() << "At index file:" << ( pos *100 )/file_size << "% -" << "Header detected after end of message, offset:" << (pos+number-3) - next_message_pos << "bytes";
-                    f.seek(current_message_pos+4);
-                    pos = current_message_pos+4;
-                    length = f.read(data,DLT_FILE_INDEXER_SEG_SIZE);
+                    f.seek(current_message_pos+4,DLT_FILE_INDEXER_SEG_SIZE);
+                    length = qMax(f.read(segment,pos),(qint64)0);
+                    data = segment.constData();
                     number=0;
                     next_message_pos = 0;
+                    headerSize = 0;
                 }
                 lastFound = 0;
             }
@@ -279,7 +313,6 @@ bool DltFileIndexer::index(int num)
             {
                 qDebug().noquote() << "Request stoping indexing received" << __LINE__ << __FILE__;
                 emit(progress((abspos)));
-                delete[] data;
                 f.close();
                 return false;
             }
@@ -313,6 +346,11 @@ bool DltFileIndexer::index(int num)
      qDebug().noquote() << "Created" << ( pos *100 )/file_size << "% index for file" << dltFile->getFileName(num);
     }
 
+    fileRatePyramid.finish();
+    mergeBlockSummaries();
+    statistics.merge(fileStatistics);
+    ratePyramid.merge(fileRatePyramid, indexBase);
+
     // write index if enabled
     if(filterCacheEnabled)
     {
@@ -321,13 +359,12 @@ bool DltFileIndexer::index(int num)
     }
     emit(progress(pos));
 
-    // delete buffer
-    delete[] data;
-
     // close file
     f.close();
 
-    //qDebug() << "Duration:" << time.elapsed()/1000 << __LINE__;
+    // update performance counter
+    QDltProfiler::getInstance()->addCounter(QStringLiteral("Indexed messages"), indexAllList.size());
+    QDltProfiler::getInstance()->addCounter(QStringLiteral("Index errors"), errors_in_file);
 
     return true;
 }
@@ -336,22 +373,27 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
 {
     QSharedPointer<QDltMsg> msg;
     QDltFilterList filterList;
-    QTime time;
+    QElapsedTimer time;
     qint64 ix = 0;
     unsigned int iPercent = 0;
 
     // start performance counter
-    //time.start();
+    time.start();
+    QDltProfilerSpan span("indexer", QStringLiteral("Filter index"));
 
     // get filter list
     filterList = dltFile->getFilterList();
     // clear index filter
     indexFilterList.clear();
     indexFilterListSorted.clear();
+    indexFilterFolds.clear();
+    foldHashes.clear();
+    filterRatePyramid.clear();
     getLogInfoList.clear();
 
     // load filter index, if enabled and not an initial loading of file
-    if(filterCacheEnabled && mode != modeIndexAndFilter && loadFilterIndexCache(filterList,indexFilterList,filenames))
+    // the cache contains no message hashes, so it can not be used for folding
+    if(filterCacheEnabled && !foldRepeatsEnabled && mode != modeIndexAndFilter && loadFilterIndexCache(filterList,indexFilterList,filenames))
     {
         // loading filter index from filter is succesful
         qDebug() << "Loaded filter index cache for files" << filenames;
@@ -393,6 +435,8 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
                 sortByTimestampEnabled,
                 &indexFilterList,
                 &indexFilterListSorted,
+                &filterRatePyramid,
+                foldRepeatsEnabled ? &foldHashes : 0,
                 pluginManager,
                 &activeViewerPlugins,
                 silentMode
@@ -403,13 +447,35 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
         indexerThread.start(); // thread starts reading its queue
     }
 
-    // Start reading messages
+    // blocks, which cannot match any positive filter, are skipped when only filtering;
+    // when loading, all messages are needed for the plugins and control messages
+    QVector<QDltBlockSummary> blocks;
+    if(mode == modeFilter)
+        blocks = dltFile->getBlockSummaries();
+    qint64 skipped = 0;
+
+    // Start reading messages, neighbouring messages are read in blocks
+    QDltFileIterator messages(dltFile);
     for(ix=0;ix<dltFile->size();ix++)
     {
+        if(0 == (ix % QDLT_BLOCK_SUMMARY_SIZE) && ix / QDLT_BLOCK_SUMMARY_SIZE < blocks.size())
+        {
+            const QDltBlockSummary &block = blocks[ix / QDLT_BLOCK_SUMMARY_SIZE];
+            if(block.size() > 0 && !filterList.mayMatch(block, pluginsEnabled))
+            {
+                skipped += block.size();
+                ix += block.size() - 1;
+                continue;
+            }
+        }
+
         msg = QSharedPointer<QDltMsg>::create(); // create new instance to be filled by getMsg(), otherwise shared pointer would be empty or pointing to last message
 
-        if(!dltFile->getMsg(ix, *msg))
-            continue; // Skip broken messages
+        {
+            QDltProfilerSpan readSpan("indexer", QStringLiteral("Read message"), QDltProfiler::SpanAggregate);
+            if(!messages.seek(ix) || !messages.getMsg(*msg))
+                continue; // Skip broken messages
+        }
 
         if(true == useIndexerThread)
         {
@@ -456,11 +522,17 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
     }
 
     // update performance counter
-    //msecsFilterCounter = time.elapsed();
+    msecsFilterCounter = time.elapsed();
+
+    filterRatePyramid.finish();
 
-    // use sorted values if sort by time enabled
+    // use sorted values if sort by time enabled, the unsorted list keeps the positions of the fold hashes
+    QVector<qint64> foldPositions;
     if(sortByTimeEnabled || sortByTimestampEnabled)
+    {
+        foldPositions = indexFilterList;
         indexFilterList = QVector<qint64>::fromList(indexFilterListSorted.values());
+    }
 
     // write filter index if enabled
     if(filterCacheEnabled)
@@ -469,18 +541,97 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
         qDebug() << "Saved filter index cache for files" << filenames;
     }
 
+    // fold repetitions after sorting, the cache keeps the complete index
+    if(foldRepeatsEnabled)
+        foldFilterIndex(foldPositions);
+
+    QDltProfiler::getInstance()->addCounter(QStringLiteral("Filtered messages"), indexFilterList.size());
+    QDltProfiler::getInstance()->addCounter(QStringLiteral("Skipped messages"), skipped);
+
     qDebug() << "Indexed: 100.00 %";// << iPercent << __LINE__ ;
-    //qDebug() << "Dauer:" << time.elapsed()/1000 << __LINE__;
     return true;
 }
 
+void DltFileIndexer::foldFilterIndex(const QVector<qint64> &foldPositions)
+{
+    QDltProfilerSpan span("indexer", QStringLiteral("Fold repetitions"));
+
+    // the hashes are stored in file order, bring them into the order of the sorted rows
+    if(!foldPositions.isEmpty())
+    {
+        QVector<quint64> sortedHashes(indexFilterList.size());
+        for(int row = 0; row < indexFilterList.size(); row++)
+            sortedHashes[row] = foldHashes[std::lower_bound(foldPositions.constBegin(), foldPositions.constEnd(), indexFilterList[row]) - foldPositions.constBegin()];
+        foldHashes = sortedHashes;
+    }
+
+    QVector<qint64> foldedList;
+    foldedList.reserve(indexFilterList.size());
+
+    // open runs: content hash -> row in the folded list, last row in the filter index and payload of the first message
+    struct FoldRun
+    {
+        int first;
+        int last;
+        QByteArray payload;
+    };
+    QHash<quint64,FoldRun> runs;
+
+    QDltMsg msg;
+    for(int row = 0; row < indexFilterList.size(); row++)
+    {
+        qint64 pos = indexFilterList[row];
+        quint64 hash = foldHashes[row];
+
+        QHash<quint64,FoldRun>::iterator it = runs.find(hash);
+        if(it != runs.end() && (row - it.value().last) <= DLT_FILE_INDEXER_FOLD_WINDOW)
+        {
+            // equal hashes are only a hint, compare the payload before folding
+            if(it.value().payload.isNull() && dltFile->getMsg(foldedList[it.value().first], msg))
+                it.value().payload = msg.getPayload();
+            if(dltFile->getMsg(pos, msg) && msg.getPayload() == it.value().payload)
+            {
+                // repetition of a message shortly before, fold it into its row
+                indexFilterFolds[foldedList[it.value().first]].append(pos);
+                it.value().last = row;
+                continue;
+            }
+        }
+
+        FoldRun run;
+        run.first = foldedList.size();
+        run.last = row;
+        runs.insert(hash, run);
+        foldedList.append(pos);
+
+        // drop runs which can not be continued any more
+        if(runs.size() > 16 * DLT_FILE_INDEXER_FOLD_WINDOW)
+        {
+            for(it = runs.begin(); it != runs.end();)
+            {
+                if((row - it.value().last) > DLT_FILE_INDEXER_FOLD_WINDOW)
+                    it = runs.erase(it);
+                else
+                    ++it;
+            }
+        }
+    }
+
+    QDltProfiler::getInstance()->addCounter(QStringLiteral("Folded messages"), indexFilterList.size() - foldedList.size());
+
+    indexFilterList = foldedList;
+    foldHashes.clear();
+    foldHashes.squeeze();
+}
+
 bool DltFileIndexer::indexDefaultFilter()
 {
     QSharedPointer<QDltMsg> msg;
 
     // start performance counter
-    //QTime time;
-    //time.start();
+    QElapsedTimer time;
+    time.start();
+    QDltProfilerSpan span("indexer", QStringLiteral("Default filter index"));
 
     // Initialise progress bar
     emit(progressText(QString("IF %1/%2").arg(currentRun).arg(maxRun)));
@@ -510,15 +661,19 @@ bool DltFileIndexer::indexDefaultFilter()
     if(useDefaultFilterThread)
         defaultFilterThread.start();
 
-    /* run through the whole open file */
+    /* run through the whole open file, neighbouring messages are read in blocks */
+    QDltFileIterator messages(dltFile);
     for(int ix = 0; ix < dltFile->size(); ix++)
     {
         msg = QSharedPointer<QDltMsg>::create();
         /* Fill message from file */
-        if(!dltFile->getMsg(ix, *msg))
         {
-            /* Skip broken messages */
-            continue;
+            QDltProfilerSpan readSpan("indexer", QStringLiteral("Read message"), QDltProfiler::SpanAggregate);
+            if(!messages.seek(ix) || !messages.getMsg(*msg))
+            {
+                /* Skip broken messages */
+                continue;
+            }
         }
 
         if(useDefaultFilterThread)
@@ -569,8 +724,7 @@ bool DltFileIndexer::indexDefaultFilter()
     }
 
     // update performance counter
-    //msecsDefaultFilterCounter = time.elapsed();
-    //qDebug() << "Duration " << msecsDefaultFilterCounter;
+    msecsDefaultFilterCounter = time.elapsed();
 
     return true;
 }
@@ -591,6 +745,32 @@ bool DltFileIndexer::tryLock()
     return indexLock.tryLock();
 }
 
+void DltFileIndexer::releaseFilterIndex()
+{
+    // the file keeps its own copy of the filter index
+    indexFilterList.clear();
+    indexFilterList.squeeze();
+    indexFilterListSorted.clear();
+    indexFilterFolds.clear();
+}
+
+void DltFileIndexer::memoryUsage(QDltMemoryUsage &usage)
+{
+    // the indexes are changed while indexing
+    if(!indexLock.tryLock())
+        return;
+
+    usage.add(QString("Indexer"), QDltMemoryUsage::of(indexAllList) +
+                                  QDltMemoryUsage::of(indexFilterList) +
+                                  QDltMemoryUsage::of(indexFilterListSorted) +
+                                  QDltMemoryUsage::of(indexFilterFolds) +
+                                  QDltMemoryUsage::of(foldHashes));
+    if(defaultFilter)
+        usage.add(QString("Default filter indexes"), defaultFilter->memorySize());
+
+    indexLock.unlock();
+}
+
 void DltFileIndexer::appendToGetLogInfoList(int value)
 {
     getLogInfoList.append(value);
@@ -625,6 +805,13 @@ void DltFileIndexer::run()
     // index
     if(mode == modeIndexAndFilter)
     {
+        statistics.clear();
+        ratePyramid.clear();
+        blockSummaries.clear();
+        blockSummariesComplete = true;
+        indexBase = 0;
+        QElapsedTimer time;
+        time.start();
         for(int num=0;num < dltFile->getNumberOfFiles();num++)
         {
             if(!index(num))
@@ -634,8 +821,15 @@ void DltFileIndexer::run()
             }
            // qDebug() << "setDLTIndex" << num << __FILE__ << __LINE__;
             dltFile->setDltIndex(indexAllList,num);
+            indexBase += indexAllList.size();
             currentRun++;
         }
+        msecsIndexCounter = time.elapsed();
+        // the file keeps its own copy of the index
+        indexAllList.clear();
+        indexAllList.squeeze();
+        dltFile->setBlockSummaries(blockSummariesComplete ? blockSummaries : QVector<QDltBlockSummary>());
+        blockSummaries.clear();
         emit(finishIndex());
     }
     else if(mode == modeNone)
@@ -657,6 +851,8 @@ void DltFileIndexer::run()
         }
         dltFile->enableFilter(filtersEnabled);
         dltFile->setIndexFilter(indexFilterList);
+        dltFile->setIndexFilterFolds(indexFilterFolds);
+        releaseFilterIndex();
         emit(finishFilter());
     }
 
@@ -672,16 +868,14 @@ void DltFileIndexer::run()
     }
 
     //qDebug() << "Indexer run" << currentRun << "done" << __FILE__ <<  __LINE__;
-    // print performance counter
-    /*
-    QTime time;
-    time = QTime(0,0);time = time.addMSecs(msecsIndexCounter);
-    qDebug() << "Duration Indexing:" << time.toString("hh:mm:ss.zzz") << "msecs";
-    time = QTime(0,0);time = time.addMSecs(msecsFilterCounter);
-    qDebug() << "Duration Filter Indexing:" << time.toString("hh:mm:ss.zzz") << "msecs";
-    time = QTime(0,0);time = time.addMSecs(msecsDefaultFilterCounter);
-    qDebug() << "Duration Default Filter Indexing:" << time.toString("hh:mm:ss.zzz") << "msecs";
-    */
+
+    // print cost of plugins in silent mode
+    if(QDltOptManager::getInstance()->issilentMode())
+    {
+        QStringList report = pluginManager->statisticsReport();
+        for(int num = 0; num < report.size(); num++)
+            qDebug().noquote() << "Plugin" << report[num];
+    }
 }
 
 void DltFileIndexer::stop()
@@ -716,6 +910,26 @@ bool DltFileIndexer::loadIndexCache(QString filename)
         return false;
     }
 
+    // statistics are stored next to the index, index again if they are missing
+    if(!fileStatistics.load(info.dir().path() + "/index/" + filenameStatisticsCache(filenameCache)) ||
+       !fileRatePyramid.load(info.dir().path() + "/index/" + filenameRatePyramidCache(filenameCache)) ||
+       !QDltBlockSummary::load(info.dir().path() + "/index/" + filenameBlockSummaryCache(filenameCache), fileBlockSummaries))
+    {
+        qDebug() << "Statistics cache missing for" << filename;
+        return false;
+    }
+
+    // the summaries must cover all messages of the index
+    qint64 summarised = 0;
+    for(int num = 0; num < fileBlockSummaries.size(); num++)
+        summarised += fileBlockSummaries[num].size();
+    if(summarised != indexAllList.size())
+    {
+        qDebug() << "Block summary cache does not match index for" << filename;
+        fileBlockSummaries.clear();
+        return false;
+    }
+
     return true;
 }
 
@@ -741,6 +955,13 @@ bool DltFileIndexer::saveIndexCache(QString filename)
         // saving cache file failed
         return false;
     }
+    if(!fileStatistics.save(info.dir().path() + "/index/" + filenameStatisticsCache(filenameCache)) ||
+       !fileRatePyramid.save(info.dir().path() + "/index/" + filenameRatePyramidCache(filenameCache)) ||
+       !QDltBlockSummary::save(info.dir().path() + "/index/" + filenameBlockSummaryCache(filenameCache), fileBlockSummaries))
+    {
+        // saving cache file failed
+        return false;
+    }
 
     return true;
 }
@@ -770,6 +991,71 @@ QString DltFileIndexer::filenameIndexCache(QString filename)
     return filenameCache;
 }
 
+QString DltFileIndexer::filenameStatisticsCache(QString filenameCache)
+{
+    // same name as the index cache with a different extension
+    return QFileInfo(filenameCache).completeBaseName()+".dst";
+}
+
+QString DltFileIndexer::filenameRatePyramidCache(QString filenameCache)
+{
+    return QFileInfo(filenameCache).completeBaseName()+".drp";
+}
+
+QString DltFileIndexer::filenameBlockSummaryCache(QString filenameCache)
+{
+    return QFileInfo(filenameCache).completeBaseName()+".dbs";
+}
+
+void DltFileIndexer::addStatistics(const char *header, int headerSize, qint64 length)
+{
+    DltStatisticsHeader values;
+
+    // summary of the block of the message in the file, every indexed message is added
+    qint64 block = (indexAllList.size() - 1) / QDLT_BLOCK_SUMMARY_SIZE;
+    if(block >= fileBlockSummaries.size())
+        fileBlockSummaries.resize(block + 1);
+
+    if(!DltStatistics::parseHeader(header, headerSize, length, values))
+    {
+        fileBlockSummaries[block].addUnknown();
+        return;
+    }
+
+    fileBlockSummaries[block].addMessage(values.seconds, values.timestamp, values.ecu, values.apid, values.ctid, values.type, values.subtype, values.verbose);
+    fileStatistics.addMessage(values, length);
+    fileRatePyramid.addMessage(values.time(), indexAllList.size() - 1, values.level);
+}
+
+void DltFileIndexer::mergeBlockSummaries()
+{
+    // the blocks of the file are only aligned with the blocks of all files for the first file,
+    // a block of the file is merged into all blocks it overlaps
+    for(int num = 0; num < fileBlockSummaries.size(); num++)
+    {
+        qint64 first = indexBase + (qint64) num * QDLT_BLOCK_SUMMARY_SIZE;
+        qint64 end = first + fileBlockSummaries[num].size();
+        while(first < end)
+        {
+            qint64 block = first / QDLT_BLOCK_SUMMARY_SIZE;
+            qint64 last = qMin(end, (block + 1) * QDLT_BLOCK_SUMMARY_SIZE);
+            if(block >= blockSummaries.size())
+                blockSummaries.resize(block + 1);
+            blockSummaries[block].merge(fileBlockSummaries[num], (int) (last - first));
+            first = last;
+        }
+    }
+}
+
+int DltFileIndexer::copyHeader(char *header, const char *data, qint64 size)
+{
+    // the start sequence is already consumed, the rest may be in the next segment
+    memcpy(header, "DLT\x01", 4);
+    int count = qMin((qint64)(DLT_STATISTICS_HEADER_SIZE - 4), qMax(size, (qint64)0));
+    memcpy(header + 4, data, count);
+    return 4 + count;
+}
+
 // read/write index cache
 bool DltFileIndexer::loadFilterIndexCache(QDltFilterList &filterList, QVector<qint64> &index, QStringList filenames)
 {
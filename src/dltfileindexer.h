@@ -7,12 +7,19 @@
 #include <QMainWindow>
 #include <QPair>
 #include <QMutex>
+#include <QHash>
 
 #include "qdlt.h"
+#include "dltstatistics.h"
+#include "dltratepyramid.h"
 
 #define DLT_FILE_INDEXER_SEG_SIZE (1024*1024)
+#define DLT_FILE_INDEXER_READ_AHEAD 2
 #define DLT_FILE_INDEXER_FILE_VERSION 2
 
+// number of filtered rows a repetition may lag behind and still be folded
+#define DLT_FILE_INDEXER_FOLD_WINDOW 8
+
 class DltFileIndexerKey
 {
 public:
@@ -84,6 +91,9 @@ public:
     bool loadIndexCache(QString filename);
     bool saveIndexCache(QString filename);
     QString filenameIndexCache(QString filename);
+    QString filenameStatisticsCache(QString filenameCache);
+    QString filenameRatePyramidCache(QString filenameCache);
+    QString filenameBlockSummaryCache(QString filenameCache);
 
     // load/save index from/to file
     bool saveIndex(QString filename, const QVector<qint64> &index);
@@ -114,6 +124,10 @@ public:
     void setSortByTimestampEnabled(bool enable) { sortByTimestampEnabled = enable; }
     bool setSortByTimestampEnabled() { return sortByTimestampEnabled; }
 
+    // enable/disable folding of repeated messages in the filter index
+    void setFoldRepeatsEnabled(bool enable) { foldRepeatsEnabled = enable; }
+    bool getFoldRepeatsEnabled() { return foldRepeatsEnabled; }
+
     // enable/disable multithreaded
     void setMultithreaded(bool enable) { multithreaded = enable; }
     bool getMultithreaded() { return multithreaded; }
@@ -125,14 +139,25 @@ public:
     // get index of all messages
     QVector<qint64> getIndexAll() { return indexAllList; }
     QVector<qint64> getIndexFilters() { return indexFilterList; }
+    QHash<qint64,QVector<qint64> > getIndexFilterFolds() { return indexFilterFolds; }
     QList<int> getGetLogInfoList() { return getLogInfoList; }
 
+    // get message statistics of all indexed files
+    DltStatistics getStatistics() { return statistics; }
+
+    // get message rates over time of all messages and of the filtered messages
+    DltRatePyramid getRatePyramid() { return ratePyramid; }
+    DltRatePyramid getFilterRatePyramid() { return filterRatePyramid; }
+
     // let worker thread append to getLogInfoList
     void appendToGetLogInfoList(int value);
 
     // reset / clear file indexes
     void clearindex() { indexAllList.clear(); }
 
+    // add the bytes used by the indexes of the indexer and the default filters, skipped while indexing
+    void memoryUsage(QDltMemoryUsage &usage);
+
     // main thread routine
     void run();
 
@@ -140,6 +165,19 @@ protected:
 
 private:
 
+    // copy the first bytes of a message behind the start sequence
+    static int copyHeader(char *header, const char *data, qint64 size);
+
+    // add the last indexed message to the statistics
+    void addStatistics(const char *header, int headerSize, qint64 length);
+    void mergeBlockSummaries();
+
+    // fold repeated messages of the filter index into the row of their first occurence
+    void foldFilterIndex(const QVector<qint64> &foldPositions);
+
+    // release the filter index, after it was handed over to the file
+    void releaseFilterIndex();
+
     // the current set mode of indexing
     IndexingMode mode;
 
@@ -170,6 +208,27 @@ private:
     QVector<qint64> indexFilterList;
     QMap<DltFileIndexerKey,qint64> indexFilterListSorted;
 
+    // repetitions folded into the filter index and the content hash of each filtered row
+    QHash<qint64,QVector<qint64> > indexFilterFolds;
+    QVector<quint64> foldHashes;
+
+    // message statistics, collected while indexing
+    DltStatistics statistics;
+    DltStatistics fileStatistics;
+    DltRatePyramid ratePyramid;
+    DltRatePyramid fileRatePyramid;
+    DltRatePyramid filterRatePyramid;
+
+    // index of the first message of the currently indexed file
+    qint64 indexBase;
+
+    // summaries of blocks of messages of all files, incomplete if a file was not indexed completely
+    QVector<QDltBlockSummary> blockSummaries;
+    bool blockSummariesComplete;
+
+    // summaries of blocks of messages of the currently indexed file, stored with the index cache
+    QVector<QDltBlockSummary> fileBlockSummaries;
+
     // getLogInfoList
     QList<int> getLogInfoList;
 
@@ -179,6 +238,7 @@ private:
     bool multithreaded;
     bool sortByTimeEnabled;
     bool sortByTimestampEnabled;
+    bool foldRepeatsEnabled;
 
     // filter cache enabled
     bool filterCacheEnabled;
@@ -11,6 +11,8 @@ DltFileIndexerThread::DltFileIndexerThread
         bool sortByTimestampEnabled,
         QVector<qint64> *indexFilterList,
         QMap<DltFileIndexerKey,qint64> *indexFilterListSorted,
+        DltRatePyramid *filterRatePyramid,
+        QVector<quint64> *foldHashes,
         QDltPluginManager *pluginManager,
         QList<QDltPlugin*> *activeViewerPlugins,
         bool silentMode
@@ -21,6 +23,8 @@ DltFileIndexerThread::DltFileIndexerThread
       sortByTimestampEnabled(sortByTimestampEnabled),
       indexFilterList(indexFilterList),
       indexFilterListSorted(indexFilterListSorted),
+      filterRatePyramid(filterRatePyramid),
+      foldHashes(foldHashes),
       pluginManager(pluginManager),
       activeViewerPlugins(activeViewerPlugins),
       silentMode(silentMode), msgQueue(1024)
@@ -50,6 +54,23 @@ void DltFileIndexerThread::run()
         processMessage(msgPair.first, msgPair.second);
 }
 
+quint64 DltFileIndexerThread::foldHash(QDltMsg &msg)
+{
+    /* two differently seeded 32 bit hashes make collisions of different payloads unlikely */
+    QByteArray payload = msg.getPayload();
+    uint low = qHash(payload, 0x5bd1e995);
+    uint high = qHash(payload, 0x27d4eb2f);
+
+    uint header = qHash(msg.getEcuid());
+    header = header * 31 + qHash(msg.getApid());
+    header = header * 31 + qHash(msg.getCtid());
+    header = header * 31 + (uint) msg.getType();
+    header = header * 31 + (uint) msg.getSubtype();
+    header = header * 31 + (uint) msg.getMessageId();
+
+    return ((quint64) (high ^ header) << 32) | (quint64) (low ^ (header * 0x9e3779b9));
+}
+
 void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int index)
 {
     DltFileIndexer::IndexingMode mode = indexer->getMode();
@@ -109,6 +130,7 @@ void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int inde
     /* Process all viewer plugins */
     if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled)
     {
+        QDltProfilerSpan span("plugin", QStringLiteral("Viewer plugins"), QDltProfiler::SpanAggregate);
         for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
         {
             item = (QDltPlugin *) activeViewerPlugins->at(ivp);
@@ -123,7 +145,10 @@ void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int inde
      }
 
 
-    bool_result = filterList->checkFilter(*msg);
+    {
+        QDltProfilerSpan span("filter", QStringLiteral("Filter check"), QDltProfiler::SpanAggregate);
+        bool_result = filterList->checkFilter(*msg);
+    }
     if ( bool_result == true)
     {
         if(sortByTimeEnabled)
@@ -138,11 +163,27 @@ void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int inde
          {
             indexFilterList->append(index);
          }
+
+        /* message rate of the filtered messages for the timeline */
+        int level = 0;
+        if(msg->getType() == QDltMsg::DltTypeLog && msg->getSubtype() >= 1 && msg->getSubtype() < DLT_STATISTICS_LEVELS)
+            level = msg->getSubtype();
+        filterRatePyramid->addMessage((qint64) msg->getTime() * 1000000 + msg->getMicroseconds(), index, level);
+
+        /* content hash for folding repeated messages, stored per filtered row;
+           when sorting, the unsorted list keeps the position of each hash */
+        if(foldHashes)
+        {
+            foldHashes->append(foldHash(*msg));
+            if(sortByTimeEnabled || sortByTimestampEnabled)
+                indexFilterList->append(index);
+        }
     }
 
     /* Offer messages again to viewer plugins after decode */
     if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled)
     {
+        QDltProfilerSpan span("plugin", QStringLiteral("Viewer plugins"), QDltProfiler::SpanAggregate);
         for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
         {
             item = (QDltPlugin *) activeViewerPlugins->at(ivp);
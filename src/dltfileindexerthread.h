@@ -9,12 +9,15 @@ class DltFileIndexerThread :public QThread
 {
     Q_OBJECT
 public:
-    DltFileIndexerThread(DltFileIndexer *indexer, QDltFilterList *filterList, bool sortByTimeEnabled, bool sortByTimestampEnabled, QVector<qint64> *indexFilterList, QMap<DltFileIndexerKey,qint64> *indexFilterListSorted, QDltPluginManager *pluginManager, QList<QDltPlugin*> *activeViewerPlugins, bool silentMode);
+    DltFileIndexerThread(DltFileIndexer *indexer, QDltFilterList *filterList, bool sortByTimeEnabled, bool sortByTimestampEnabled, QVector<qint64> *indexFilterList, QMap<DltFileIndexerKey,qint64> *indexFilterListSorted, DltRatePyramid *filterRatePyramid, QVector<quint64> *foldHashes, QDltPluginManager *pluginManager, QList<QDltPlugin*> *activeViewerPlugins, bool silentMode);
     ~DltFileIndexerThread();
     void enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index);
     void processMessage(QSharedPointer<QDltMsg> &msg, int index);
     void requestStop();
 
+    // hash of the fields which make two messages repetitions of each other
+    static quint64 foldHash(QDltMsg &msg);
+
 protected:
     void run();
 
@@ -26,6 +29,8 @@ private:
 
     QVector<qint64> *indexFilterList;
     QMap<DltFileIndexerKey,qint64> *indexFilterListSorted;
+    DltRatePyramid *filterRatePyramid;
+    QVector<quint64> *foldHashes;
 
     QDltPluginManager *pluginManager;
     QList<QDltPlugin*> *activeViewerPlugins;
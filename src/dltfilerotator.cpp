@@ -0,0 +1,155 @@
+#include <QRunnable>
+#include <QDebug>
+
+#if defined(Q_OS_UNIX)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "dltfilerotator.h"
+
+class DltFileRotatorTask : public QRunnable
+{
+public:
+    typedef enum { Prepare, Finalise } Mode;
+
+    DltFileRotatorTask(Mode mode, const QString &fileName, qint64 size, QAtomicInt *ready)
+        : mode(mode), fileName(fileName), size(size), ready(ready) {}
+
+    void run()
+    {
+        QFile file(fileName);
+
+        if(mode == Prepare)
+        {
+            if(!file.open(QIODevice::WriteOnly|QIODevice::Truncate))
+            {
+                qDebug() << "Cannot create" << fileName;
+                return;
+            }
+#if defined(Q_OS_LINUX)
+            /* reserve the blocks, but keep the file empty */
+            if(size > 0 && fallocate(file.handle(), FALLOC_FL_KEEP_SIZE, 0, size) != 0)
+                qDebug() << "Cannot preallocate" << fileName;
+#endif
+            file.close();
+            ready->storeRelease(1);
+        }
+        else
+        {
+            if(!file.open(QIODevice::ReadWrite))
+            {
+                qDebug() << "Cannot finalise" << fileName;
+                return;
+            }
+            /* the current file may be written again after stopping, keep its blocks then */
+            if(size >= 0 && file.size() != size)
+            {
+                file.close();
+                return;
+            }
+            /* release the preallocated blocks behind the end of the file */
+            file.resize(file.size());
+#if defined(Q_OS_UNIX)
+            fsync(file.handle());
+#endif
+            file.close();
+        }
+    }
+
+private:
+    Mode mode;
+    QString fileName;
+    qint64 size;
+    QAtomicInt *ready;
+};
+
+DltFileRotator::DltFileRotator()
+{
+    file = 0;
+    maxSize = 0;
+    size = 0;
+
+    /* one thread, the tasks are done in order */
+    pool.setMaxThreadCount(1);
+}
+
+DltFileRotator::~DltFileRotator()
+{
+    stop();
+    pool.waitForDone();
+}
+
+void DltFileRotator::start(QFile *file, qint64 maxSize)
+{
+    if(this->file == file && fileName == file->fileName() && this->maxSize == maxSize)
+        return;
+
+    stop();
+
+    this->file = file;
+    this->maxSize = maxSize;
+    fileName = file->fileName();
+    spareName = fileName + DLT_FILE_ROTATOR_SPARE_SUFFIX;
+    size = file->size();
+
+    prepare();
+}
+
+void DltFileRotator::stop()
+{
+    if(!file)
+        return;
+
+    pool.waitForDone();
+    if(spareReady.loadAcquire())
+        QFile::remove(spareName);
+    spareReady.storeRelease(0);
+
+    /* the current file keeps its preallocated blocks until it is finalised */
+    if(file->isOpen())
+        file->flush();
+    pool.start(new DltFileRotatorTask(DltFileRotatorTask::Finalise, fileName, file->size(), 0));
+
+    file = 0;
+    fileName.clear();
+    spareName.clear();
+    size = 0;
+}
+
+void DltFileRotator::prepare()
+{
+    spareReady.storeRelease(0);
+    pool.start(new DltFileRotatorTask(DltFileRotatorTask::Prepare, spareName, maxSize, &spareReady));
+}
+
+bool DltFileRotator::rotate(const QString &archiveName)
+{
+    if(!file)
+        return false;
+
+    file->flush();
+    file->close();
+
+    if(!QFile::rename(fileName, archiveName))
+    {
+        qDebug() << "ERROR renaming" << fileName << "to" << archiveName;
+        file->open(QIODevice::WriteOnly|QIODevice::Append);
+        return false;
+    }
+
+    /* continue with the prepared file, create a new one if it is not ready yet */
+    if(!spareReady.loadAcquire() || !QFile::rename(spareName, fileName))
+        qDebug() << "Prepared file not ready" << spareName;
+
+    /* append keeps the preallocated blocks, truncating would release them */
+    file->setFileName(fileName);
+    if(!file->open(QIODevice::WriteOnly|QIODevice::Append))
+        qDebug() << "ERROR opening" << fileName;
+    size = 0;
+
+    pool.start(new DltFileRotatorTask(DltFileRotatorTask::Finalise, archiveName, -1, 0));
+    prepare();
+
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef DLTFILEROTATOR_H
+#define DLTFILEROTATOR_H
+
+#include <QFile>
+#include <QString>
+#include <QAtomicInt>
+#include <QThreadPool>
+
+#define DLT_FILE_ROTATOR_SPARE_SUFFIX ".next"
+
+//! Rotates the log file without stalling the receiver
+/*!
+  The next log file is created and preallocated in the background,
+  as soon as the current file was started. A rotation then only
+  closes the current file, renames it to the archive name and renames
+  the prepared file to the log file name. Unused preallocated space of
+  the archived file is released and the file is synced to disk in the
+  background, the same is done for the current file when stopping.
+  The written size is counted, so the size limit can be checked for
+  every message without querying the file system.
+*/
+class DltFileRotator
+{
+public:
+    DltFileRotator();
+    ~DltFileRotator();
+
+    //! Start rotating the open file, nothing is done if already started for this file
+    void start(QFile *file, qint64 maxSize);
+
+    //! Stop rotating, remove the prepared file and release the unused space of the current file in the background
+    void stop();
+
+    bool isActive() const { return file != 0; }
+
+    //! Check if writing the given number of bytes exceeds the size limit
+    bool isFull(qint64 bytes) const { return file && maxSize > 0 && size > 0 && size + bytes > maxSize; }
+
+    //! Count bytes written to the file
+    void addWritten(qint64 bytes) { size += bytes; }
+
+    //! Take the size from the file again, after writing to it without counting the bytes
+    void resync() { if(file) size = file->size(); }
+
+    //! Rename the current file to the archive name and continue with the prepared file
+    /*!
+      \return false if the current file could not be renamed, it is open again in this case
+    */
+    bool rotate(const QString &archiveName);
+
+private:
+    void prepare();
+
+    QFile *file;
+    QString fileName;
+    QString spareName;
+    qint64 maxSize;
+    qint64 size;
+    QAtomicInt spareReady;
+    QThreadPool pool;
+};
+
+#endif // DLTFILEROTATOR_H
@@ -0,0 +1,305 @@
+#include <QFile>
+#include <QDataStream>
+#include <QtDebug>
+
+#include <algorithm>
+
+#include "dltratepyramid.h"
+
+#define DLT_RATE_PYRAMID_FILE_MAGIC 0x444c5452 /* "DLTR" */
+
+static const qint64 levelWidths[DLT_RATE_PYRAMID_LEVELS] =
+{
+    1000LL,         /* 1 ms */
+    10000LL,        /* 10 ms */
+    100000LL,       /* 100 ms */
+    1000000LL,      /* 1 s */
+    10000000LL,     /* 10 s */
+    60000000LL,     /* 1 min */
+    600000000LL,    /* 10 min */
+    3600000000LL,   /* 1 h */
+    21600000000LL,  /* 6 h */
+    86400000000LL   /* 1 day */
+};
+
+static bool bucketLessThan(const DltRateBucket &a, const DltRateBucket &b)
+{
+    return a.number < b.number;
+}
+
+DltRateBucket::DltRateBucket()
+{
+    number = 0;
+    firstMessage = 0;
+    for(int num = 0; num < DLT_STATISTICS_LEVELS; num++)
+        counts[num] = 0;
+}
+
+DltRateBucket::DltRateBucket(qint64 number, qint64 firstMessage)
+    : number(number)
+    , firstMessage(firstMessage)
+{
+    for(int num = 0; num < DLT_STATISTICS_LEVELS; num++)
+        counts[num] = 0;
+}
+
+quint32 DltRateBucket::total() const
+{
+    quint32 sum = 0;
+    for(int num = 0; num < DLT_STATISTICS_LEVELS; num++)
+        sum += counts[num];
+    return sum;
+}
+
+DltRatePyramid::DltRatePyramid()
+{
+    clear();
+}
+
+void DltRatePyramid::clear()
+{
+    for(int level = 0; level < DLT_RATE_PYRAMID_LEVELS; level++)
+    {
+        buckets[level].clear();
+        unsorted[level] = false;
+        dropped[level] = false;
+    }
+    messages = 0;
+    start = 0;
+    end = 0;
+}
+
+qint64 DltRatePyramid::levelWidth(int level)
+{
+    return levelWidths[level];
+}
+
+void DltRatePyramid::addMessage(qint64 usecs, qint64 index, int level)
+{
+    if(usecs < 0)
+        usecs = 0;
+
+    if(messages == 0 || usecs < start)
+        start = usecs;
+    if(messages == 0 || usecs >= end)
+        end = usecs + 1;
+    messages++;
+
+    for(int num = 0; num < DLT_RATE_PYRAMID_LEVELS; num++)
+    {
+        if(dropped[num])
+            continue;
+
+        QVector<DltRateBucket> &list = buckets[num];
+        qint64 number = usecs / levelWidths[num];
+
+        /* messages are mostly in time order, so only the last bucket is checked */
+        if(list.isEmpty() || list.last().number != number)
+        {
+            if(list.size() >= DLT_RATE_PYRAMID_MAX_BUCKETS)
+            {
+                dropped[num] = true;
+                list.clear();
+                list.squeeze();
+                continue;
+            }
+            if(!list.isEmpty() && number < list.last().number)
+                unsorted[num] = true;
+            list.append(DltRateBucket(number, index));
+        }
+
+        DltRateBucket &bucket = list.last();
+        bucket.counts[level]++;
+        if(index < bucket.firstMessage)
+            bucket.firstMessage = index;
+    }
+}
+
+void DltRatePyramid::finish()
+{
+    for(int num = 0; num < DLT_RATE_PYRAMID_LEVELS; num++)
+    {
+        if(!unsorted[num])
+            continue;
+
+        QVector<DltRateBucket> &list = buckets[num];
+        std::stable_sort(list.begin(), list.end(), bucketLessThan);
+
+        /* combine buckets of the same time */
+        int last = 0;
+        for(int pos = 1; pos < list.size(); pos++)
+        {
+            if(list[pos].number == list[last].number)
+            {
+                for(int level = 0; level < DLT_STATISTICS_LEVELS; level++)
+                    list[last].counts[level] += list[pos].counts[level];
+                list[last].firstMessage = qMin(list[last].firstMessage, list[pos].firstMessage);
+            }
+            else
+            {
+                list[++last] = list[pos];
+            }
+        }
+        if(!list.isEmpty())
+            list.resize(last + 1);
+
+        unsorted[num] = false;
+    }
+}
+
+void DltRatePyramid::merge(const DltRatePyramid &other, qint64 indexOffset)
+{
+    if(other.isEmpty())
+        return;
+
+    for(int num = 0; num < DLT_RATE_PYRAMID_LEVELS; num++)
+    {
+        if(dropped[num] || other.dropped[num])
+        {
+            dropped[num] = true;
+            buckets[num].clear();
+            continue;
+        }
+
+        const QVector<DltRateBucket> &a = buckets[num];
+        const QVector<DltRateBucket> &b = other.buckets[num];
+        QVector<DltRateBucket> result;
+        result.reserve(a.size() + b.size());
+
+        int posA = 0, posB = 0;
+        while(posA < a.size() || posB < b.size())
+        {
+            if(posB >= b.size() || (posA < a.size() && a[posA].number < b[posB].number))
+            {
+                result.append(a[posA++]);
+            }
+            else
+            {
+                DltRateBucket bucket = b[posB++];
+                bucket.firstMessage += indexOffset;
+                if(posA < a.size() && a[posA].number == bucket.number)
+                {
+                    for(int level = 0; level < DLT_STATISTICS_LEVELS; level++)
+                        bucket.counts[level] += a[posA].counts[level];
+                    bucket.firstMessage = qMin(bucket.firstMessage, a[posA].firstMessage);
+                    posA++;
+                }
+                result.append(bucket);
+            }
+        }
+
+        if(result.size() > DLT_RATE_PYRAMID_MAX_BUCKETS)
+        {
+            dropped[num] = true;
+            result.clear();
+        }
+        buckets[num] = result;
+    }
+
+    if(messages == 0 || other.start < start)
+        start = other.start;
+    if(messages == 0 || other.end > end)
+        end = other.end;
+    messages += other.messages;
+}
+
+int DltRatePyramid::levelForResolution(qint64 usecs) const
+{
+    int coarsest = -1;
+
+    for(int num = 0; num < DLT_RATE_PYRAMID_LEVELS; num++)
+    {
+        if(dropped[num])
+            continue;
+        if(levelWidths[num] >= usecs)
+            return num;
+        coarsest = num;
+    }
+
+    return coarsest;
+}
+
+int DltRatePyramid::findBucket(int level, qint64 usecs) const
+{
+    const QVector<DltRateBucket> &list = buckets[level];
+    qint64 number = usecs / levelWidths[level];
+
+    /* binary search, so a view only touches the buckets it shows */
+    DltRateBucket key(number, 0);
+    return std::lower_bound(list.constBegin(), list.constEnd(), key, bucketLessThan) - list.constBegin();
+}
+
+bool DltRatePyramid::save(const QString &filename) const
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream stream(&file);
+    stream << (quint32) DLT_RATE_PYRAMID_FILE_MAGIC << (quint32) DLT_RATE_PYRAMID_FILE_VERSION;
+    stream << messages << start << end;
+
+    for(int num = 0; num < DLT_RATE_PYRAMID_LEVELS; num++)
+    {
+        const QVector<DltRateBucket> &list = buckets[num];
+        stream << dropped[num] << (quint32) list.size();
+        for(int pos = 0; pos < list.size(); pos++)
+        {
+            stream << list[pos].number << list[pos].firstMessage;
+            for(int level = 0; level < DLT_STATISTICS_LEVELS; level++)
+                stream << list[pos].counts[level];
+        }
+    }
+
+    file.close();
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool DltRatePyramid::load(const QString &filename)
+{
+    clear();
+
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if(magic != DLT_RATE_PYRAMID_FILE_MAGIC || version != DLT_RATE_PYRAMID_FILE_VERSION)
+    {
+        qDebug() << "Rate cache" << filename << "has wrong version";
+        return false;
+    }
+
+    stream >> messages >> start >> end;
+
+    for(int num = 0; num < DLT_RATE_PYRAMID_LEVELS && stream.status() == QDataStream::Ok; num++)
+    {
+        quint32 count = 0;
+        stream >> dropped[num] >> count;
+        if(count > DLT_RATE_PYRAMID_MAX_BUCKETS)
+        {
+            clear();
+            return false;
+        }
+
+        QVector<DltRateBucket> &list = buckets[num];
+        list.resize(count);
+        for(quint32 pos = 0; pos < count && stream.status() == QDataStream::Ok; pos++)
+        {
+            stream >> list[pos].number >> list[pos].firstMessage;
+            for(int level = 0; level < DLT_STATISTICS_LEVELS; level++)
+                stream >> list[pos].counts[level];
+        }
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        clear();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,88 @@
+#ifndef DLTRATEPYRAMID_H
+#define DLTRATEPYRAMID_H
+
+#include <QString>
+#include <QVector>
+
+#include "dltstatistics.h"
+
+#define DLT_RATE_PYRAMID_FILE_VERSION 1
+
+/* number of resolutions, from 1 ms to 1 day per bucket */
+#define DLT_RATE_PYRAMID_LEVELS 10
+
+/* a resolution is dropped when it needs more buckets,
+   the timeline then stops zooming at the next coarser resolution */
+#define DLT_RATE_PYRAMID_MAX_BUCKETS (1024*1024)
+
+class DltRateBucket
+{
+public:
+    DltRateBucket();
+    DltRateBucket(qint64 number, qint64 firstMessage);
+
+    quint32 total() const;
+
+    qint64 number;       /* start time divided by the bucket width */
+    qint64 firstMessage; /* index of the first message within the bucket */
+    quint32 counts[DLT_STATISTICS_LEVELS];
+};
+
+//! Message counts per time bucket at several resolutions
+/*!
+  Each resolution is a vector of non empty buckets sorted by time,
+  so a view only needs to read the buckets it shows. The counts
+  are split by log level like in DltStatistics.
+*/
+class DltRatePyramid
+{
+public:
+    DltRatePyramid();
+
+    void clear();
+    bool isEmpty() const { return messages == 0; }
+
+    //! Add a message
+    /*!
+      \param usecs Storage header time in microseconds since epoch
+      \param index Index of the message in the file
+      \param level Log level 1 fatal .. 6 verbose, 0 for other messages
+    */
+    void addMessage(qint64 usecs, qint64 index, int level);
+
+    //! Sort the buckets after messages were added out of time order
+    void finish();
+
+    //! Add the buckets of another file, both must be finished
+    void merge(const DltRatePyramid &other, qint64 indexOffset);
+
+    // resolutions
+    static qint64 levelWidth(int level);
+    bool isLevelAvailable(int level) const { return !dropped[level]; }
+    const QVector<DltRateBucket> &getBuckets(int level) const { return buckets[level]; }
+
+    //! Finest available resolution with buckets not smaller than usecs
+    int levelForResolution(qint64 usecs) const;
+
+    //! Index of the first bucket ending after the time usecs
+    int findBucket(int level, qint64 usecs) const;
+
+    qint64 getMessages() const { return messages; }
+    qint64 getStart() const { return start; }
+    qint64 getEnd() const { return end; }
+
+    // load/save from/to cache file
+    bool save(const QString &filename) const;
+    bool load(const QString &filename);
+
+private:
+    QVector<DltRateBucket> buckets[DLT_RATE_PYRAMID_LEVELS];
+    bool unsorted[DLT_RATE_PYRAMID_LEVELS];
+    bool dropped[DLT_RATE_PYRAMID_LEVELS];
+
+    qint64 messages;
+    qint64 start;
+    qint64 end;
+};
+
+#endif // DLTRATEPYRAMID_H
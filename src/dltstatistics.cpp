@@ -0,0 +1,328 @@
+#include <QFile>
+#include <QDataStream>
+#include <QTextStream>
+#include <QDateTime>
+#include <QList>
+#include <QtDebug>
+
+#include <algorithm>
+
+#include "dltstatistics.h"
+#include "dlt_protocol.h"
+
+#define DLT_STATISTICS_FILE_MAGIC 0x444c5453 /* "DLTS" */
+
+DltStatisticsEntry::DltStatisticsEntry()
+{
+    messages = 0;
+    bytes = 0;
+    peakRate = 0;
+    peakSecond = 0;
+    for(int num = 0; num < DLT_STATISTICS_LEVELS; num++)
+        levels[num] = 0;
+    currentSecond = 0;
+    currentCount = 0;
+}
+
+void DltStatisticsEntry::add(quint32 seconds, qint64 size, int level)
+{
+    messages++;
+    bytes += size;
+    levels[level]++;
+
+    /* rate of messages stored within the same second */
+    if(seconds != currentSecond)
+    {
+        currentSecond = seconds;
+        currentCount = 0;
+    }
+    currentCount++;
+    if(currentCount > peakRate)
+    {
+        peakRate = currentCount;
+        peakSecond = seconds;
+    }
+}
+
+void DltStatisticsEntry::merge(const DltStatisticsEntry &other)
+{
+    messages += other.messages;
+    bytes += other.bytes;
+    for(int num = 0; num < DLT_STATISTICS_LEVELS; num++)
+        levels[num] += other.levels[num];
+    if(other.peakRate > peakRate)
+    {
+        peakRate = other.peakRate;
+        peakSecond = other.peakSecond;
+    }
+}
+
+DltStatistics::DltStatistics()
+{
+}
+
+void DltStatistics::clear()
+{
+    for(int group = 0; group < GroupCount; group++)
+        entries[group].clear();
+}
+
+bool DltStatistics::isEmpty() const
+{
+    return entries[GroupEcu].isEmpty();
+}
+
+void DltStatistics::addEntry(Group group, const DltStatisticsKey &key, quint32 seconds, qint64 size, int level)
+{
+    entries[group][key].add(seconds, size, level);
+}
+
+bool DltStatistics::parseHeader(const char *data, int size, qint64 length, DltStatisticsHeader &header)
+{
+    const unsigned char *buf = (const unsigned char *) data;
+
+    if(size > length)
+        size = length;
+
+    /* storage header and standard header are needed at least */
+    if(size < 20)
+        return false;
+
+    header = DltStatisticsHeader();
+    header.seconds = buf[4] | (buf[5] << 8) | (buf[6] << 16) | ((quint32) buf[7] << 24);
+    header.microseconds = buf[8] | (buf[9] << 8) | (buf[10] << 16) | ((quint32) buf[11] << 24);
+    header.ecu = idKey(data + 12);
+
+    quint8 htyp = buf[16];
+    int offset = 20;
+    bool verbose = false;
+
+    if(DLT_IS_HTYP_WEID(htyp))
+    {
+        if(size >= offset + 4)
+            header.ecu = idKey(data + offset);
+        offset += 4;
+    }
+    if(DLT_IS_HTYP_WSID(htyp))
+        offset += 4;
+    if(DLT_IS_HTYP_WTMS(htyp))
+    {
+        if(size >= offset + 4)
+            header.timestamp = ((quint32) buf[offset] << 24) | (buf[offset + 1] << 16) | (buf[offset + 2] << 8) | buf[offset + 3];
+        offset += 4;
+    }
+
+    if(DLT_IS_HTYP_UEH(htyp) && size >= offset + 10)
+    {
+        quint8 msin = buf[offset];
+        header.apid = idKey(data + offset + 2);
+        header.ctid = idKey(data + offset + 6);
+        header.extended = true;
+        header.type = DLT_GET_MSIN_MSTP(msin);
+        header.subtype = DLT_GET_MSIN_MTIN(msin);
+        verbose = DLT_IS_MSIN_VERB(msin);
+        header.verbose = verbose;
+        if(DLT_GET_MSIN_MSTP(msin) == DLT_TYPE_LOG && DLT_GET_MSIN_MTIN(msin) >= 1 && DLT_GET_MSIN_MTIN(msin) < DLT_STATISTICS_LEVELS)
+            header.level = DLT_GET_MSIN_MTIN(msin);
+        offset += 10;
+    }
+    else if(DLT_IS_HTYP_UEH(htyp))
+    {
+        /* extended header expected but message too short */
+        offset = size;
+    }
+
+    /* non verbose messages start with the message id */
+    if(!verbose && size >= offset + 4)
+    {
+        const unsigned char *id = buf + offset;
+        if(DLT_IS_HTYP_MSBF(htyp))
+            header.messageId = ((quint32) id[0] << 24) | (id[1] << 16) | (id[2] << 8) | id[3];
+        else
+            header.messageId = ((quint32) id[3] << 24) | (id[2] << 16) | (id[1] << 8) | id[0];
+        header.hasMessageId = true;
+    }
+
+    return true;
+}
+
+void DltStatistics::addMessage(const DltStatisticsHeader &header, qint64 length)
+{
+    addEntry(GroupEcu, DltStatisticsKey(header.ecu, 0, 0), header.seconds, length, header.level);
+    if(header.extended)
+    {
+        addEntry(GroupApplication, DltStatisticsKey(header.ecu, header.apid, 0), header.seconds, length, header.level);
+        addEntry(GroupContext, DltStatisticsKey(header.ecu, header.apid, header.ctid), header.seconds, length, header.level);
+    }
+    if(header.hasMessageId)
+        addEntry(GroupMessageId, DltStatisticsKey(header.ecu, header.apid, header.messageId), header.seconds, length, header.level);
+}
+
+void DltStatistics::merge(const DltStatistics &other)
+{
+    for(int group = 0; group < GroupCount; group++)
+    {
+        const QHash<DltStatisticsKey,DltStatisticsEntry> &source = other.entries[group];
+        for(QHash<DltStatisticsKey,DltStatisticsEntry>::const_iterator it = source.constBegin(); it != source.constEnd(); ++it)
+            entries[group][it.key()].merge(it.value());
+    }
+}
+
+const DltStatisticsEntry *DltStatistics::find(Group group, const QString &ecuid, const QString &apid, const QString &ctid) const
+{
+    QHash<DltStatisticsKey,DltStatisticsEntry>::const_iterator it = entries[group].constFind(DltStatisticsKey(idKey(ecuid), idKey(apid), idKey(ctid)));
+
+    if(it == entries[group].constEnd())
+        return 0;
+
+    return &it.value();
+}
+
+bool DltStatistics::save(const QString &filename) const
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QDataStream stream(&file);
+    stream << (quint32) DLT_STATISTICS_FILE_MAGIC << (quint32) DLT_STATISTICS_FILE_VERSION;
+
+    for(int group = 0; group < GroupCount; group++)
+    {
+        const QHash<DltStatisticsKey,DltStatisticsEntry> &list = entries[group];
+        stream << (quint32) list.size();
+        for(QHash<DltStatisticsKey,DltStatisticsEntry>::const_iterator it = list.constBegin(); it != list.constEnd(); ++it)
+        {
+            const DltStatisticsEntry &entry = it.value();
+            stream << it.key().ecu << it.key().apid << it.key().id;
+            stream << entry.messages << entry.bytes << entry.peakRate << entry.peakSecond;
+            for(int num = 0; num < DLT_STATISTICS_LEVELS; num++)
+                stream << entry.levels[num];
+        }
+    }
+
+    file.close();
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool DltStatistics::load(const QString &filename)
+{
+    clear();
+
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if(magic != DLT_STATISTICS_FILE_MAGIC || version != DLT_STATISTICS_FILE_VERSION)
+    {
+        qDebug() << "Statistics cache" << filename << "has wrong version";
+        return false;
+    }
+
+    for(int group = 0; group < GroupCount && stream.status() == QDataStream::Ok; group++)
+    {
+        quint32 count = 0;
+        stream >> count;
+        for(quint32 num = 0; num < count && stream.status() == QDataStream::Ok; num++)
+        {
+            DltStatisticsKey key;
+            DltStatisticsEntry entry;
+            stream >> key.ecu >> key.apid >> key.id;
+            stream >> entry.messages >> entry.bytes >> entry.peakRate >> entry.peakSecond;
+            for(int level = 0; level < DLT_STATISTICS_LEVELS; level++)
+                stream >> entry.levels[level];
+            entries[group].insert(key, entry);
+        }
+    }
+
+    if(stream.status() != QDataStream::Ok)
+    {
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool DltStatistics::exportCsv(QIODevice *device) const
+{
+    static const char *groupNames[GroupCount] = { "ECU", "Application", "Context", "MessageId" };
+
+    QTextStream stream(device);
+
+    stream << "Group;ECU;Apid;Ctid/MessageId;Messages;Bytes;Peak msg/s;Peak time;Fatal;Error;Warn;Info;Debug;Verbose;Other\n";
+
+    for(int group = 0; group < GroupCount; group++)
+    {
+        /* sorted output is easier to compare */
+        QList<DltStatisticsKey> keys = entries[group].keys();
+        std::sort(keys.begin(), keys.end(), [](const DltStatisticsKey &a, const DltStatisticsKey &b) {
+            if(a.ecu != b.ecu)
+                return a.ecu < b.ecu;
+            if(a.apid != b.apid)
+                return a.apid < b.apid;
+            return a.id < b.id;
+        });
+
+        for(int num = 0; num < keys.size(); num++)
+        {
+            const DltStatisticsKey &key = keys[num];
+            const DltStatisticsEntry &entry = entries[group][key];
+
+            stream << groupNames[group] << ";" << idString(key.ecu) << ";";
+            stream << (group >= GroupApplication ? idString(key.apid) : QString()) << ";";
+            if(group == GroupContext)
+                stream << idString(key.id);
+            else if(group == GroupMessageId)
+                stream << key.id;
+            stream << ";" << entry.messages << ";" << entry.bytes << ";" << entry.peakRate << ";";
+            stream << QDateTime::fromTime_t(entry.peakSecond).toString("yyyy/MM/dd hh:mm:ss");
+            for(int level = 1; level < DLT_STATISTICS_LEVELS; level++)
+                stream << ";" << entry.levels[level];
+            stream << ";" << entry.levels[0] << "\n";
+        }
+    }
+
+    stream.flush();
+
+    return stream.status() == QTextStream::Ok;
+}
+
+quint32 DltStatistics::idKey(const char *id)
+{
+    /* same packing as dltIdKey(), ids shorter than four characters end with zero */
+    quint32 key = 0;
+    bool end = false;
+    for(int num = 0; num < 4; num++)
+    {
+        if(id[num] == 0)
+            end = true;
+        key = (key << 8) | (end ? 0 : (quint8) id[num]);
+    }
+    return key;
+}
+
+quint32 DltStatistics::idKey(const QString &id)
+{
+    quint32 key = 0;
+    for(int num = 0; num < 4; num++)
+        key = (key << 8) | ((num < id.size()) ? (quint8) id.at(num).toLatin1() : 0);
+    return key;
+}
+
+QString DltStatistics::idString(quint32 key)
+{
+    QString id;
+    for(int shift = 24; shift >= 0; shift -= 8)
+    {
+        char c = (key >> shift) & 0xff;
+        if(c == 0)
+            break;
+        id.append(QLatin1Char(c));
+    }
+    return id;
+}
@@ -0,0 +1,139 @@
+#ifndef DLTSTATISTICS_H
+#define DLTSTATISTICS_H
+
+#include <QString>
+#include <QHash>
+#include <QIODevice>
+
+#define DLT_STATISTICS_FILE_VERSION 1
+
+/* bytes of a message needed to get all statistics values:
+   storage header, standard header with all extra fields,
+   extended header and message id */
+#define DLT_STATISTICS_HEADER_SIZE (16+4+12+10+4)
+
+/* log levels fatal to verbose, index 0 counts all other message types */
+#define DLT_STATISTICS_LEVELS 7
+
+class DltStatisticsKey
+{
+public:
+    DltStatisticsKey() : ecu(0), apid(0), id(0) {}
+    DltStatisticsKey(quint32 ecu, quint32 apid, quint32 id) : ecu(ecu), apid(apid), id(id) {}
+
+    bool operator==(const DltStatisticsKey &other) const
+    {
+        return ecu == other.ecu && apid == other.apid && id == other.id;
+    }
+
+    quint32 ecu;
+    quint32 apid;
+    quint32 id; /* context id or message id */
+};
+
+inline uint qHash(const DltStatisticsKey &key, uint seed = 0)
+{
+    return qHash(key.ecu, seed) ^ (qHash(key.apid, seed) * 31) ^ (qHash(key.id, seed) * 961);
+}
+
+//! Values of the message header used for statistics
+class DltStatisticsHeader
+{
+public:
+    DltStatisticsHeader() : seconds(0), microseconds(0), timestamp(0), ecu(0), apid(0), ctid(0), messageId(0), level(0), type(-1), subtype(0), extended(false), verbose(false), hasMessageId(false) {}
+
+    //! Storage header time in microseconds since epoch
+    qint64 time() const { return (qint64) seconds * 1000000 + microseconds; }
+
+    quint32 seconds;
+    qint32 microseconds;
+    quint32 timestamp;  /* 0.1 milliseconds, 0 if not available */
+    quint32 ecu;
+    quint32 apid;
+    quint32 ctid;
+    quint32 messageId;
+    int level;          /* 1 fatal .. 6 verbose, 0 for other messages */
+    int type;           /* message type of the extended header, -1 without extended header */
+    int subtype;        /* message type info of the extended header */
+    bool extended;
+    bool verbose;
+    bool hasMessageId;
+};
+
+class DltStatisticsEntry
+{
+public:
+    DltStatisticsEntry();
+
+    void add(quint32 seconds, qint64 size, int level);
+    void merge(const DltStatisticsEntry &other);
+
+    qint64 messages;
+    qint64 bytes;
+    qint64 peakRate;     /* maximum number of messages within one second */
+    quint32 peakSecond;  /* storage header time of the peak */
+    qint64 levels[DLT_STATISTICS_LEVELS];
+
+private:
+    quint32 currentSecond;
+    qint64 currentCount;
+};
+
+//! Message counts, volumes and rates of a trace
+/*!
+  The statistics are collected from the raw message headers while
+  the file index is created, so no additional pass over the data is needed.
+*/
+class DltStatistics
+{
+public:
+    typedef enum { GroupEcu = 0, GroupApplication, GroupContext, GroupMessageId, GroupCount } Group;
+
+    DltStatistics();
+
+    void clear();
+    bool isEmpty() const;
+
+    //! Parse the header values of a message from the raw data
+    /*!
+      \param data Start of the message including storage header
+      \param size Number of valid bytes in data, up to DLT_STATISTICS_HEADER_SIZE are used
+      \param length Complete length of the message including storage header
+      \param header The parsed values
+      \return false if not even the standard header is available
+    */
+    static bool parseHeader(const char *data, int size, qint64 length, DltStatisticsHeader &header);
+
+    //! Add a message with its parsed header values
+    void addMessage(const DltStatisticsHeader &header, qint64 length);
+
+    //! Add the statistics of another file
+    void merge(const DltStatistics &other);
+
+    //! Find the entry of an ECU, application, context or message id
+    /*!
+      \return the entry or zero if no message was found
+    */
+    const DltStatisticsEntry *find(Group group, const QString &ecuid, const QString &apid = QString(), const QString &ctid = QString()) const;
+
+    const QHash<DltStatisticsKey,DltStatisticsEntry> &getEntries(Group group) const { return entries[group]; }
+
+    // load/save from/to cache file
+    bool save(const QString &filename) const;
+    bool load(const QString &filename);
+
+    //! Write all entries as semicolon separated values
+    bool exportCsv(QIODevice *device) const;
+
+    // conversion between DLT ids and keys
+    static quint32 idKey(const char *id);
+    static quint32 idKey(const QString &id);
+    static QString idString(quint32 key);
+
+private:
+    void addEntry(Group group, const DltStatisticsKey &key, quint32 seconds, qint64 size, int level);
+
+    QHash<DltStatisticsKey,DltStatisticsEntry> entries[GroupCount];
+};
+
+#endif // DLTSTATISTICS_H
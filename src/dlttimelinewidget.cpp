@@ -0,0 +1,376 @@
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QDateTime>
+
+#include <cmath>
+
+#include "dlttimelinewidget.h"
+
+/* tick distances of the time axis in microseconds */
+static const qint64 tickSteps[] =
+{
+    1000LL, 2000LL, 5000LL, 10000LL, 20000LL, 50000LL, 100000LL, 200000LL, 500000LL,
+    1000000LL, 2000000LL, 5000000LL, 10000000LL, 30000000LL,
+    60000000LL, 120000000LL, 300000000LL, 600000000LL, 1800000000LL,
+    3600000000LL, 7200000000LL, 10800000000LL, 21600000000LL, 43200000000LL,
+    86400000000LL, 172800000000LL, 604800000000LL
+};
+
+/* shortest visible range */
+#define DLT_TIMELINE_MIN_SPAN 10000LL
+
+static QString durationString(qint64 usecs)
+{
+    if(usecs >= 86400000000LL)
+        return QString("%1 d").arg(usecs / 86400000000LL);
+    if(usecs >= 3600000000LL)
+        return QString("%1 h").arg(usecs / 3600000000LL);
+    if(usecs >= 60000000LL)
+        return QString("%1 min").arg(usecs / 60000000LL);
+    if(usecs >= 1000000LL)
+        return QString("%1 s").arg(usecs / 1000000LL);
+    return QString("%1 ms").arg(usecs / 1000LL);
+}
+
+DltTimelineWidget::DltTimelineWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    showFiltered = false;
+    viewStart = 0;
+    viewEnd = 0;
+    dragging = false;
+    dragMoved = false;
+    dragX = 0;
+    dragViewStart = 0;
+
+    setMinimumHeight(40);
+}
+
+QSize DltTimelineWidget::sizeHint() const
+{
+    return QSize(400, 80);
+}
+
+void DltTimelineWidget::setRatePyramids(const DltRatePyramid &all, const DltRatePyramid &filtered)
+{
+    bool reset = (viewEnd <= viewStart) || all.getStart() != this->all.getStart() || all.getEnd() != this->all.getEnd();
+
+    this->all = all;
+    this->filtered = filtered;
+
+    /* without active filters all messages pass, no need to draw them twice */
+    showFiltered = !filtered.isEmpty() && filtered.getMessages() != all.getMessages();
+
+    if(reset)
+        zoomToAll();
+    else
+        update();
+}
+
+void DltTimelineWidget::clear()
+{
+    all.clear();
+    filtered.clear();
+    showFiltered = false;
+    viewStart = 0;
+    viewEnd = 0;
+    update();
+}
+
+void DltTimelineWidget::zoomToAll()
+{
+    if(all.isEmpty())
+    {
+        viewStart = 0;
+        viewEnd = 0;
+    }
+    else
+    {
+        viewStart = all.getStart();
+        viewEnd = qMax(all.getEnd(), viewStart + DLT_TIMELINE_MIN_SPAN);
+    }
+    update();
+}
+
+void DltTimelineWidget::setView(qint64 start, qint64 end)
+{
+    qint64 span = end - start;
+    qint64 maxSpan = (all.getEnd() - all.getStart()) * 2 + 1000000LL;
+
+    if(span < DLT_TIMELINE_MIN_SPAN)
+    {
+        start -= (DLT_TIMELINE_MIN_SPAN - span) / 2;
+        span = DLT_TIMELINE_MIN_SPAN;
+    }
+    if(span > maxSpan)
+    {
+        start += (span - maxSpan) / 2;
+        span = maxSpan;
+    }
+
+    /* keep at least half of the view on the trace */
+    start = qBound(all.getStart() - span / 2, start, all.getEnd() - span / 2);
+
+    viewStart = start;
+    viewEnd = start + span;
+    update();
+}
+
+int DltTimelineWidget::currentLevel() const
+{
+    if(viewEnd <= viewStart)
+        return -1;
+
+    /* at least one pixel per bucket */
+    return all.levelForResolution((viewEnd - viewStart) / qMax(width(), 1));
+}
+
+qint64 DltTimelineWidget::timeAt(int x) const
+{
+    return viewStart + (viewEnd - viewStart) * x / qMax(width(), 1);
+}
+
+int DltTimelineWidget::positionOf(qint64 usecs) const
+{
+    return (usecs - viewStart) * width() / qMax(viewEnd - viewStart, (qint64)1);
+}
+
+const DltRateBucket *DltTimelineWidget::bucketAt(int x, int &level) const
+{
+    level = currentLevel();
+    if(level < 0)
+        return 0;
+
+    const QVector<DltRateBucket> &buckets = all.getBuckets(level);
+    int pos = all.findBucket(level, timeAt(x));
+    if(pos >= buckets.size())
+        return 0;
+
+    /* the bucket must start within the pixel */
+    if(buckets[pos].number * DltRatePyramid::levelWidth(level) > timeAt(x + 1))
+        return 0;
+
+    return &buckets[pos];
+}
+
+QString DltTimelineWidget::timeString(qint64 usecs, qint64 span) const
+{
+    QDateTime time = QDateTime::fromMSecsSinceEpoch(usecs / 1000);
+
+    if(span >= 86400000000LL)
+        return time.toString("yyyy/MM/dd");
+    if(span >= 60000000LL)
+        return time.toString("MM/dd hh:mm");
+    if(span >= 1000000LL)
+        return time.toString("hh:mm:ss");
+    return time.toString("hh:mm:ss.zzz");
+}
+
+void DltTimelineWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    int level = currentLevel();
+    if(all.isEmpty() || level < 0)
+    {
+        painter.setPen(palette().color(QPalette::Disabled, QPalette::Text));
+        painter.drawText(rect(), Qt::AlignCenter, tr("No messages"));
+        return;
+    }
+
+    int axisHeight = fontMetrics().height() + 2;
+    int bottom = height() - 1;
+    int barHeight = qMax(height() - axisHeight - 1, 1);
+    qint64 bucketWidth = DltRatePyramid::levelWidth(level);
+
+    const QVector<DltRateBucket> &buckets = all.getBuckets(level);
+    int first = all.findBucket(level, viewStart);
+
+    /* scale to the highest visible bucket */
+    quint32 maxCount = 1;
+    int last;
+    for(last = first; last < buckets.size() && buckets[last].number * bucketWidth < viewEnd; last++)
+        maxCount = qMax(maxCount, buckets[last].total());
+
+    /* time axis */
+    qint64 span = viewEnd - viewStart;
+    qint64 step = tickSteps[sizeof(tickSteps) / sizeof(tickSteps[0]) - 1];
+    for(unsigned int num = 0; num < sizeof(tickSteps) / sizeof(tickSteps[0]); num++)
+    {
+        if(tickSteps[num] * width() >= span * 120)
+        {
+            step = tickSteps[num];
+            break;
+        }
+    }
+    painter.setPen(palette().color(QPalette::Mid));
+    for(qint64 tick = (viewStart / step + 1) * step; tick < viewEnd; tick += step)
+    {
+        int x = positionOf(tick);
+        painter.drawLine(x, axisHeight, x, bottom);
+        painter.drawText(x + 2, fontMetrics().ascent() + 1, timeString(tick, step));
+    }
+
+    /* bars, errors at the bottom, so they stay visible */
+    for(int pos = first; pos < last; pos++)
+    {
+        const DltRateBucket &bucket = buckets[pos];
+        int x0 = positionOf(bucket.number * bucketWidth);
+        int x1 = qMax(positionOf((bucket.number + 1) * bucketWidth), x0 + 1);
+
+        quint32 errors = bucket.counts[1] + bucket.counts[2];
+        quint32 warnings = bucket.counts[3];
+        quint32 total = bucket.total();
+
+        int hTotal = qMax((int)((qint64) total * barHeight / maxCount), 1);
+        int hErrors = (qint64) errors * barHeight / maxCount;
+        int hWarnings = (qint64) (errors + warnings) * barHeight / maxCount;
+        if(errors > 0)
+            hErrors = qMax(hErrors, 1);
+        if(warnings > 0)
+            hWarnings = qMax(hWarnings, hErrors + 1);
+
+        painter.fillRect(x0, bottom - hTotal + 1, x1 - x0, hTotal, QColor(150, 150, 150));
+        if(warnings > 0)
+            painter.fillRect(x0, bottom - hWarnings + 1, x1 - x0, hWarnings, QColor(255, 165, 0));
+        if(errors > 0)
+            painter.fillRect(x0, bottom - hErrors + 1, x1 - x0, hErrors, QColor(220, 0, 0));
+    }
+
+    /* filtered messages as outline on top */
+    if(showFiltered && filtered.isLevelAvailable(level))
+    {
+        const QVector<DltRateBucket> &filteredBuckets = filtered.getBuckets(level);
+        painter.setPen(QColor(0, 0, 200));
+        for(int pos = filtered.findBucket(level, viewStart); pos < filteredBuckets.size() && filteredBuckets[pos].number * bucketWidth < viewEnd; pos++)
+        {
+            const DltRateBucket &bucket = filteredBuckets[pos];
+            int x0 = positionOf(bucket.number * bucketWidth);
+            int x1 = qMax(positionOf((bucket.number + 1) * bucketWidth), x0 + 1);
+            int y = bottom - qMax((int)((qint64) bucket.total() * barHeight / maxCount), 1) + 1;
+            painter.drawLine(x0, y, x1 - 1, y);
+        }
+    }
+
+    /* resolution and scale */
+    painter.setPen(palette().color(QPalette::Text));
+    painter.drawText(rect().adjusted(0, 0, -2, 0), Qt::AlignRight | Qt::AlignTop,
+                     tr("%1 per bar, max %2").arg(durationString(bucketWidth)).arg(maxCount));
+}
+
+void DltTimelineWidget::wheelEvent(QWheelEvent *event)
+{
+    if(all.isEmpty())
+        return;
+
+    double steps = event->angleDelta().y() / 120.0;
+    double factor = std::pow(0.8, steps);
+    qint64 anchor = timeAt(event->pos().x());
+
+    qint64 start = anchor - (qint64)((anchor - viewStart) * factor);
+    qint64 end = anchor + (qint64)((viewEnd - anchor) * factor);
+    setView(start, end);
+
+    event->accept();
+}
+
+void DltTimelineWidget::mousePressEvent(QMouseEvent *event)
+{
+    if(event->button() != Qt::LeftButton)
+        return;
+
+    dragging = true;
+    dragMoved = false;
+    dragX = event->pos().x();
+    dragViewStart = viewStart;
+}
+
+void DltTimelineWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if(!dragging)
+        return;
+
+    int dx = event->pos().x() - dragX;
+    if(qAbs(dx) > 3)
+        dragMoved = true;
+
+    if(dragMoved)
+    {
+        qint64 span = viewEnd - viewStart;
+        qint64 start = dragViewStart - span * dx / qMax(width(), 1);
+        setView(start, start + span);
+    }
+}
+
+void DltTimelineWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if(event->button() != Qt::LeftButton || !dragging)
+        return;
+
+    dragging = false;
+    if(dragMoved)
+        return;
+
+    /* click, jump to the first message at or after the clicked time */
+    int level = currentLevel();
+    if(level < 0)
+        return;
+
+    const QVector<DltRateBucket> &buckets = all.getBuckets(level);
+    int pos = all.findBucket(level, timeAt(event->pos().x()));
+    if(pos < buckets.size())
+        emit jumpToMessage(buckets[pos].firstMessage);
+}
+
+void DltTimelineWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    Q_UNUSED(event);
+
+    zoomToAll();
+}
+
+bool DltTimelineWidget::event(QEvent *event)
+{
+    if(event->type() == QEvent::ToolTip)
+    {
+        QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        int level;
+        const DltRateBucket *bucket = bucketAt(helpEvent->pos().x(), level);
+
+        if(!bucket)
+        {
+            QToolTip::hideText();
+            event->ignore();
+            return true;
+        }
+
+        qint64 bucketWidth = DltRatePyramid::levelWidth(level);
+        qint64 start = bucket->number * bucketWidth;
+        QString text = tr("%1 (%2)\nMessages: %3\nFatal/Error: %4\nWarn: %5")
+                .arg(timeString(start, bucketWidth < 1000000LL ? 0 : bucketWidth))
+                .arg(durationString(bucketWidth))
+                .arg(bucket->total())
+                .arg(bucket->counts[1] + bucket->counts[2])
+                .arg(bucket->counts[3]);
+
+        if(showFiltered && filtered.isLevelAvailable(level))
+        {
+            const QVector<DltRateBucket> &filteredBuckets = filtered.getBuckets(level);
+            int pos = filtered.findBucket(level, start);
+            quint32 count = (pos < filteredBuckets.size() && filteredBuckets[pos].number == bucket->number) ? filteredBuckets[pos].total() : 0;
+            text += tr("\nFiltered: %1").arg(count);
+        }
+
+        QToolTip::showText(helpEvent->globalPos(), text, this);
+        return true;
+    }
+
+    return QWidget::event(event);
+}
@@ -0,0 +1,70 @@
+#ifndef DLTTIMELINEWIDGET_H
+#define DLTTIMELINEWIDGET_H
+
+#include <QWidget>
+
+#include "dltratepyramid.h"
+
+//! Zoomable overview of the message rate over time
+/*!
+  Draws the buckets of a DltRatePyramid for the visible time range,
+  choosing the resolution so that a bucket is at least one pixel wide.
+  Errors and warnings are drawn on top of the other messages, the
+  filtered messages are drawn as outline.
+  Wheel zooms around the mouse, dragging moves the view, a click
+  jumps to the first message of the bucket and a double click shows
+  the whole trace again.
+*/
+class DltTimelineWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DltTimelineWidget(QWidget *parent = 0);
+
+    //! Set the message rates, the view is reset if the trace time range changed
+    void setRatePyramids(const DltRatePyramid &all, const DltRatePyramid &filtered);
+
+    void clear();
+
+    QSize sizeHint() const;
+
+public slots:
+    void zoomToAll();
+
+signals:
+    void jumpToMessage(int index);
+
+protected:
+    void paintEvent(QPaintEvent *event);
+    void wheelEvent(QWheelEvent *event);
+    void mousePressEvent(QMouseEvent *event);
+    void mouseMoveEvent(QMouseEvent *event);
+    void mouseReleaseEvent(QMouseEvent *event);
+    void mouseDoubleClickEvent(QMouseEvent *event);
+    bool event(QEvent *event);
+
+private:
+    int currentLevel() const;
+    qint64 timeAt(int x) const;
+    int positionOf(qint64 usecs) const;
+    const DltRateBucket *bucketAt(int x, int &level) const;
+    QString timeString(qint64 usecs, qint64 span) const;
+    void setView(qint64 start, qint64 end);
+
+    DltRatePyramid all;
+    DltRatePyramid filtered;
+    bool showFiltered;
+
+    // visible range in microseconds
+    qint64 viewStart;
+    qint64 viewEnd;
+
+    // mouse dragging
+    bool dragging;
+    bool dragMoved;
+    int dragX;
+    qint64 dragViewStart;
+};
+
+#endif // DLTTIMELINEWIDGET_H
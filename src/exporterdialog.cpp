@@ -26,6 +26,8 @@ void ExporterDialog::setFormat(DltExporter::DltExportFormat exportFormat)
         ui->radioButtonCsv->setChecked(true);
     else if(exportFormat == DltExporter::FormatDltDecoded)
         ui->radioButtonDltDecoded->setChecked(true);
+    else if(exportFormat == DltExporter::FormatColumnar)
+        ui->radioButtonColumnar->setChecked(true);
 }
 
 DltExporter::DltExportFormat ExporterDialog::getFormat()
@@ -40,6 +42,8 @@ DltExporter::DltExportFormat ExporterDialog::getFormat()
         return DltExporter::FormatCsv;
     if(ui->radioButtonDltDecoded->isChecked())
         return DltExporter::FormatDltDecoded;
+    if(ui->radioButtonColumnar->isChecked())
+        return DltExporter::FormatColumnar;
     return DltExporter::FormatDlt;
 }
 
@@ -281,6 +281,107 @@ void FilterDialog::setMessageId_max(unsigned int max)
     ui->lineEdit_msgIdMax->setText(QString("%1").arg(max));
 }
 
+void FilterDialog::setEnableTime(bool state)
+{
+    ui->checkBoxTime->setCheckState(state?Qt::Checked:Qt::Unchecked);
+}
+
+bool FilterDialog::getEnableTime()
+{
+    return (ui->checkBoxTime->checkState() == Qt::Checked);
+}
+
+qint64 FilterDialog::getTimeMin()
+{
+    return ui->dateTimeEditTimeMin->dateTime().toMSecsSinceEpoch() * 1000;
+}
+
+qint64 FilterDialog::getTimeMax()
+{
+    /* the whole millisecond shown in the dialog is included */
+    return ui->dateTimeEditTimeMax->dateTime().toMSecsSinceEpoch() * 1000 + 999;
+}
+
+void FilterDialog::setTimeMin(qint64 time)
+{
+    ui->dateTimeEditTimeMin->setDateTime(QDateTime::fromMSecsSinceEpoch(time / 1000));
+}
+
+void FilterDialog::setTimeMax(qint64 time)
+{
+    ui->dateTimeEditTimeMax->setDateTime(QDateTime::fromMSecsSinceEpoch(time / 1000));
+}
+
+void FilterDialog::setEnableTimestamp(bool state)
+{
+    ui->checkBoxTimestamp->setCheckState(state?Qt::Checked:Qt::Unchecked);
+}
+
+bool FilterDialog::getEnableTimestamp()
+{
+    return (ui->checkBoxTimestamp->checkState() == Qt::Checked);
+}
+
+unsigned int FilterDialog::getTimestampMin()
+{
+    return (unsigned int) qRound64(ui->doubleSpinBoxTimestampMin->value() * 10000);
+}
+
+unsigned int FilterDialog::getTimestampMax()
+{
+    return (unsigned int) qRound64(ui->doubleSpinBoxTimestampMax->value() * 10000);
+}
+
+void FilterDialog::setTimestampMin(unsigned int timestamp)
+{
+    ui->doubleSpinBoxTimestampMin->setValue(timestamp / 10000.0);
+}
+
+void FilterDialog::setTimestampMax(unsigned int timestamp)
+{
+    ui->doubleSpinBoxTimestampMax->setValue(timestamp / 10000.0);
+}
+
+void FilterDialog::setEnableArgument(bool state)
+{
+    ui->checkBoxArgument->setCheckState(state?Qt::Checked:Qt::Unchecked);
+}
+
+bool FilterDialog::getEnableArgument()
+{
+    return (ui->checkBoxArgument->checkState() == Qt::Checked);
+}
+
+void FilterDialog::setArgument(QString indexOrName)
+{
+    ui->lineEditArgument->setText(indexOrName);
+}
+
+QString FilterDialog::getArgument()
+{
+    return ui->lineEditArgument->text();
+}
+
+void FilterDialog::setArgumentComparison(int comparison)
+{
+    ui->comboBoxArgumentComparison->setCurrentIndex(comparison);
+}
+
+int FilterDialog::getArgumentComparison()
+{
+    return ui->comboBoxArgumentComparison->currentIndex();
+}
+
+void FilterDialog::setArgumentValue(QString value)
+{
+    ui->lineEditArgumentValue->setText(value);
+}
+
+QString FilterDialog::getArgumentValue()
+{
+    return ui->lineEditArgumentValue->text();
+}
+
 void FilterDialog::setFilterColour(QColor color)
 {
    QPalette palette = ui->labelSelectedColor->palette();
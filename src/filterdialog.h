@@ -98,6 +98,29 @@ public:
     void setMessageId_min(unsigned int min);
     void setMessageId_max(unsigned int max);
 
+    void setEnableTime(bool state);
+    bool getEnableTime();
+    qint64 getTimeMin();
+    qint64 getTimeMax();
+    void setTimeMin(qint64 time);
+    void setTimeMax(qint64 time);
+
+    void setEnableTimestamp(bool state);
+    bool getEnableTimestamp();
+    unsigned int getTimestampMin();
+    unsigned int getTimestampMax();
+    void setTimestampMin(unsigned int timestamp);
+    void setTimestampMax(unsigned int timestamp);
+
+    void setEnableArgument(bool state);
+    bool getEnableArgument();
+    void setArgument(QString indexOrName);
+    QString getArgument();
+    void setArgumentComparison(int comparison);
+    int getArgumentComparison();
+    void setArgumentValue(QString value);
+    QString getArgumentValue();
+
     void setFilterColour(QColor color);
     QString getFilterColour();
 
@@ -90,7 +90,8 @@ MainWindow::MainWindow(QWidget *parent) :
     timer(this),
     qcontrol(this),
     pulseButtonColor(255, 40, 40),
-    isSearchOngoing(false)
+    isSearchOngoing(false),
+    signalExtractor(&qfile, &pluginManager)
 {
     dltIndexer = NULL;
     settings = QDltSettingsManager::getInstance();
@@ -140,6 +141,7 @@ MainWindow::MainWindow(QWidget *parent) :
     ui->actionSort_By_Timestamp->setChecked(ui->checkBoxSortByTimestamp->isChecked());
     ui->actionProject->setChecked(ui->dockWidgetContents->isVisible());
     ui->actionSearch_Results->setChecked(ui->dockWidgetSearchIndex->isVisible());
+    ui->actionTimeline->setChecked(ui->dockWidgetTimeline->isVisible());
 
     newCompleter = new QCompleter(&m_CompleterModel,this);
 
@@ -147,6 +149,8 @@ MainWindow::MainWindow(QWidget *parent) :
     draw_timer.setSingleShot (true);
     connect(&draw_timer, SIGNAL(timeout()), this, SLOT(draw_timeout()));
 
+    connect(&performance_timer, SIGNAL(timeout()), this, SLOT(performance_timeout()));
+
     if ( true == (bool) settings->StartupMinimized )
     {
         qDebug() << "Start minimzed as defined in the settings";
@@ -189,6 +193,8 @@ MainWindow::~MainWindow()
         QFileInfo infoNew(info.absolutePath(),newFilename);
 
         // rename old file
+        stopCapture();
+        signalExtractor.stop();
         qfile.close();
         outputfile.flush();
         outputfile.close();
@@ -269,6 +275,7 @@ void MainWindow::initState()
     tableModel->qfile = &qfile;
     tableModel->project = &project;
     tableModel->pluginManager = &pluginManager;
+    tableModel->regexSearchReplace = &regexSearchReplace;
 
     /* initialise project configuration */
     project.ecu = ui->configWidget;
@@ -356,6 +363,9 @@ void MainWindow::initView()
     ui->filterWidget->setHeaderHidden(false);
     ui->pluginWidget->setHeaderHidden(false);
 
+    /* jump to the messages clicked in the timeline */
+    connect(ui->timelineWidget, SIGNAL(jumpToMessage(int)), this, SLOT(jumpToMsgSignal(int)));
+
     /* Start pulsing the apply changes button, when filters draged&dropped */
     connect(ui->filterWidget, SIGNAL(filterItemDropped()), this, SLOT(filterOrderChanged()));
     connect(ui->filterWidget, SIGNAL(filterCountChanged()), this, SLOT(filterCountChanged()));
@@ -391,6 +401,8 @@ void MainWindow::initView()
     statusBytesReceived = new QLabel("Recv: 0");
     statusByteErrorsReceived = new QLabel("Recv Errors: 0");
     statusSyncFoundReceived = new QLabel("Sync found: 0");
+    statusPerformance = new QLabel();
+    statusPerformance->setVisible(false);
     statusProgressBar = new QProgressBar();
 
     statusBar()->addWidget(statusFilename,1);
@@ -399,6 +411,7 @@ void MainWindow::initView()
     statusBar()->addWidget(statusBytesReceived, 0);
     statusBar()->addWidget(statusByteErrorsReceived);
     statusBar()->addWidget(statusSyncFoundReceived);
+    statusBar()->addWidget(statusPerformance);
     statusBar()->addWidget(statusProgressBar);
 
     /* Create search text box */
@@ -499,6 +512,7 @@ void MainWindow::initSearchTable()
     m_searchtableModel->qfile = &qfile;
     m_searchtableModel->project = &project;
     m_searchtableModel->pluginManager = &pluginManager;
+    m_searchtableModel->regexSearchReplace = &regexSearchReplace;
 
     searchDlg->registerSearchTableModel(m_searchtableModel);
 
@@ -526,6 +540,7 @@ void MainWindow::initFileHandling()
 {
     /* Initialize dlt-file indexer  */
     dltIndexer = new DltFileIndexer(&qfile,&pluginManager,&defaultFilter, this);
+    splitPending = false;
 
     /* connect signals */
     connect(dltIndexer, SIGNAL(progressMax(int)), this, SLOT(reloadLogFileProgressMax(int)));
@@ -535,6 +550,7 @@ void MainWindow::initFileHandling()
     connect(dltIndexer, SIGNAL(finishIndex()), this, SLOT(reloadLogFileFinishIndex()));
     connect(dltIndexer, SIGNAL(finishFilter()), this, SLOT(reloadLogFileFinishFilter()));
     connect(dltIndexer, SIGNAL(finishDefaultFilter()), this, SLOT(reloadLogFileFinishDefaultFilter()));
+    connect(dltIndexer, SIGNAL(finished()), this, SLOT(indexerFinished()));
     connect(dltIndexer, SIGNAL(timezone(int,unsigned char)), this, SLOT(controlMessage_Timezone(int,unsigned char)));
     connect(dltIndexer, SIGNAL(unregisterContext(QString,QString,QString)), this, SLOT(controlMessage_UnregisterContext(QString,QString,QString)));
     connect(dltIndexer, SIGNAL(finished()), this, SLOT(indexDone()));
@@ -550,6 +566,8 @@ void MainWindow::initFileHandling()
     ui->checkBoxSortByTime->setChecked(QDltSettingsManager::getInstance()->value("startup/sortByTimeEnabled", false).toBool());
     ui->checkBoxSortByTimestamp->setEnabled(ui->filtersEnabled->isChecked());
     ui->checkBoxSortByTimestamp->setChecked(QDltSettingsManager::getInstance()->value("startup/sortByTimestampEnabled", false).toBool());
+    ui->checkBoxFoldRepeats->setEnabled(ui->filtersEnabled->isChecked());
+    ui->checkBoxFoldRepeats->setChecked(QDltSettingsManager::getInstance()->value("startup/foldRepeatsEnabled", false).toBool());
 
     /* Process Project */
     if(QDltOptManager::getInstance()->isProjectFile())
@@ -672,10 +690,21 @@ void MainWindow::initFileHandling()
         case e_DDLT:
              commandLineConvertToDLTDecoded();
             break;
+        case e_COL:
+             commandLineConvertToColumnar();
+            break;
         default:
              commandLineConvertToASCII();
             break;
         }
+
+        /* cost of the decoder plugins used for the conversion */
+        if(QDltOptManager::getInstance()->issilentMode())
+        {
+            QStringList report = pluginManager.statisticsReport();
+            for(int num = 0; num < report.size(); num++)
+                qDebug().noquote() << "Plugin" << report[num];
+        }
     }
 
 }
@@ -767,6 +796,22 @@ void MainWindow::commandLineConvertToDLTDecoded()
     qDebug() << "DLT export DLT decoded done";
 }
 
+void MainWindow::commandLineConvertToColumnar()
+{
+    qfile.enableFilter(true);
+    openDltFile(QStringList(QDltOptManager::getInstance()->getConvertSourceFile()));
+    outputfileIsFromCLI = false;
+    outputfileIsTemporary = false;
+
+    QFile columnarFile(QDltOptManager::getInstance()->getConvertDestFile());
+
+    /* start exporter */
+    DltExporter exporter;
+    qDebug() << "Commandline columnar convert to " << columnarFile.fileName();
+    exporter.exportMessages(&qfile,&columnarFile,&pluginManager,DltExporter::FormatColumnar,DltExporter::SelectionFiltered);
+    qDebug() << "DLT export columnar done";
+}
+
 
 void MainWindow::ErrorMessage(QMessageBox::Icon level, QString title, QString message){
 
@@ -827,6 +872,9 @@ void MainWindow::deleteactualFile()
     if(outputfileIsTemporary && !outputfileIsFromCLI)
     {
         // Delete created temp file
+        stopCapture();
+        rotator.stop();
+        signalExtractor.stop();
         qfile.close();
         outputfile.close();
         if(outputfile.exists() && !outputfile.remove())
@@ -906,6 +954,8 @@ void MainWindow::onNewTriggered(QString fileName)
     // close existing file
     if(outputfile.isOpen())
     {
+        stopCapture();
+        rotator.stop();
         if (outputfile.size() == 0)
         {
             deleteactualFile();
@@ -1025,6 +1075,8 @@ bool MainWindow::openDltFile(QStringList fileNames)
 
     if(outputfile.isOpen())
     {
+        stopCapture();
+        rotator.stop();
         if (outputfile.size() == 0)
         {
             deleteactualFile();
@@ -1157,6 +1209,7 @@ void MainWindow::appendDltFile(const QString &fileName)
         outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
     }
     outputfile.flush();
+    rotator.resync();
 
     dlt_file_free(&importfile,0);
 
@@ -1195,6 +1248,7 @@ void MainWindow::on_action_menuFile_Import_DLT_Stream_triggered()
         outputfile.flush();
 
     }
+    rotator.resync();
 
     dlt_file_free(&importfile,0);
 
@@ -1239,6 +1293,7 @@ void MainWindow::on_action_menuFile_Import_DLT_Stream_with_Serial_Header_trigger
         outputfile.flush();
 
     }
+    rotator.resync();
 
     dlt_file_free(&importfile,0);
 
@@ -1301,31 +1356,85 @@ void MainWindow::unmark_all_lines()
     model->setManualMarker(selectedMarkerRows, settings->markercolor); //used in mainwindow
 }
 
+void MainWindow::expand_folded_lines()
+{
+    QModelIndexList rows = ui->tableView->selectionModel()->selectedRows();
+    QList<int> lines;
+    for(int num = 0; num < rows.size(); num++)
+        lines.append(rows.at(num).row());
+
+    /* expand from the bottom, so the rows above keep their position */
+    std::sort(lines.begin(), lines.end());
+    int inserted = 0;
+    for(int num = lines.size() - 1; num >= 0; num--)
+        inserted += qfile.expandFold(lines.at(num));
+
+    if(inserted > 0)
+        tableModel->modelChanged();
+}
+
+/* Sorted rows of a selection, each row only once.
+ * Uses the selection ranges, which is much faster than the list of all selected cells. */
+static QList<int> selectedRowsOf(const QItemSelection &selection)
+{
+    QList<int> rows;
+    for(int num = 0; num < selection.size(); num++)
+    {
+        const QItemSelectionRange &range = selection.at(num);
+        for(int row = range.top(); row <= range.bottom(); row++)
+            rows.append(row);
+    }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    return rows;
+}
+
+void MainWindow::exportRowsToClipboard(const QList<int> &rows, bool payload_only)
+{
+    DltExporter::DltExportFormat exportFormat = (payload_only ? DltExporter::FormatClipboardPayloadOnly : DltExporter::FormatClipboard);
+
+    DltExporter exporter(this);
+
+    if(rows.size() <= DLT_EXPORTER_CLIPBOARD_MAX_ROWS)
+    {
+        exporter.exportMessages(&qfile,0,&pluginManager,exportFormat,rows);
+        return;
+    }
+
+    /* too large for the clipboard, stream the text to a file */
+    if(QMessageBox::question(this, QString("DLT Viewer"),
+                             QString("%1 messages are selected, which is too much for the clipboard.\n\nExport the selection to a text file?").arg(rows.size()),
+                             QMessageBox::Yes|QMessageBox::No) != QMessageBox::Yes)
+        return;
+
+    QString fileName = QFileDialog::getSaveFileName(this, tr("Export selection to file"),
+                                                    workingDirectory.getExportDirectory(),
+                                                    tr("UTF8 Text Files (*.txt);;All files (*.*)"));
+    if(fileName.isEmpty())
+        return;
+
+    workingDirectory.setExportDirectory(QFileInfo(fileName).absolutePath());
+    QFile outfile(fileName);
+    exporter.exportMessages(&qfile,&outfile,&pluginManager,exportFormat,rows);
+}
 
 void MainWindow::exportSelection(bool ascii = true,bool file = false,bool payload_only = false)
 {
     Q_UNUSED(ascii);
     Q_UNUSED(file);
 
-    QModelIndexList list = ui->tableView->selectionModel()->selection().indexes();
-
-    DltExporter::DltExportFormat exportFormat = (payload_only ? DltExporter::FormatClipboardPayloadOnly : DltExporter::FormatClipboard);
-
-    DltExporter exporter;
-    exporter.exportMessages(&qfile,0,&pluginManager,exportFormat,DltExporter::SelectionSelected,&list);
+    exportRowsToClipboard(selectedRowsOf(ui->tableView->selectionModel()->selection()), payload_only);
 }
 
 void MainWindow::exportSelection_searchTable(bool payload_only = false)
 {
-    const QModelIndexList list = ui->tableView_SearchIndex->selectionModel()->selectedRows();
-
-    // Clear the selection from main table.
-    ui->tableView->selectionModel()->clear();
+    const QList<int> list = selectedRowsOf(ui->tableView_SearchIndex->selectionModel()->selection());
 
     // Convert the index from search table to main table entry...
-    foreach(QModelIndex index,list)
+    QList<int> rows;
+    rows.reserve(list.size());
+    foreach(int position,list)
     {
-        int position = index.row();
         unsigned long entry;
 
         if (! m_searchtableModel->get_SearchResultEntry(position, entry) )
@@ -1336,19 +1445,27 @@ void MainWindow::exportSelection_searchTable(bool payload_only = false)
         if (0 > row)
             return;
 
-        QModelIndex newIndex = tableModel->index(row, 0, QModelIndex());
-        // Select the row in main table mapping to the search table row
-        ui->tableView->blockSignals(true);
-        ui->tableView->selectionModel()->select(newIndex, QItemSelectionModel::Select|QItemSelectionModel::Rows);
-        ui->tableView->blockSignals(false);
+        rows.append(row);
     }
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
 
-    QModelIndexList finallist = ui->tableView->selectionModel()->selection().indexes();
-
-    DltExporter::DltExportFormat exportFormat = (payload_only ? DltExporter::FormatClipboardPayloadOnly : DltExporter::FormatClipboard);
+    // Select the rows in main table mapping to the search table rows, consecutive rows as one range
+    QItemSelection selection;
+    for(int num = 0; num < rows.size(); )
+    {
+        int first = num;
+        while(num + 1 < rows.size() && rows.at(num + 1) == rows.at(num) + 1)
+            num++;
+        selection.select(tableModel->index(rows.at(first), 0, QModelIndex()),
+                         tableModel->index(rows.at(num), 0, QModelIndex()));
+        num++;
+    }
+    ui->tableView->blockSignals(true);
+    ui->tableView->selectionModel()->select(selection, QItemSelectionModel::ClearAndSelect|QItemSelectionModel::Rows);
+    ui->tableView->blockSignals(false);
 
-    DltExporter exporter;
-    exporter.exportMessages(&qfile,0,&pluginManager,exportFormat,DltExporter::SelectionSelected,&finallist);
+    exportRowsToClipboard(rows, payload_only);
 }
 
 void MainWindow::on_actionExport_triggered()
@@ -1362,7 +1479,6 @@ void MainWindow::on_actionExport_triggered()
 
     DltExporter::DltExportFormat exportFormat = exporterDialog.getFormat();
     DltExporter::DltExportSelection exportSelection = exporterDialog.getSelection();
-    QModelIndexList list = ui->tableView->selectionModel()->selection().indexes();
 
     /* check plausibility */
     if(exportSelection == DltExporter::SelectionAll)
@@ -1387,8 +1503,8 @@ void MainWindow::on_actionExport_triggered()
     }
     else if(exportSelection == DltExporter::SelectionSelected)
     {
-        qDebug() << "DLT Export of selected" << list.count() << "messages";
-        if(list.count() <= 0)
+        qDebug() << "DLT Export of selected messages";
+        if(!ui->tableView->selectionModel()->hasSelection())
         {
             QMessageBox::critical(this, QString("DLT Viewer"),
                                   QString("No messages selected. Select something from the main view."));
@@ -1428,6 +1544,13 @@ void MainWindow::on_actionExport_triggered()
         dialog.setWindowTitle("Export to CSV file");
         qDebug() << "DLT Export to CSV";
     }
+    else if(exportFormat == DltExporter::FormatColumnar)
+    {
+        filters << "Columnar Files (*.dltc)" <<"All files (*.*)";
+        dialog.setDefaultSuffix("dltc");
+        dialog.setWindowTitle("Export to columnar file");
+        qDebug() << "DLT Export to columnar";
+    }
 
     dialog.setAcceptMode(QFileDialog::AcceptSave);
     dialog.setDirectory(workingDirectory.getExportDirectory());
@@ -1454,7 +1577,7 @@ void MainWindow::on_actionExport_triggered()
     if(exportSelection == DltExporter::SelectionSelected) // marked messages
     {
         //qDebug() << "Selection" << __LINE__;
-        exporter.exportMessages(&qfile, &outfile, &pluginManager,exportFormat,exportSelection,&list);
+        exporter.exportMessages(&qfile, &outfile, &pluginManager,exportFormat,selectedRowsOf(ui->tableView->selectionModel()->selection()));
     }
     else
     {
@@ -1517,6 +1640,9 @@ void MainWindow::onSaveAsTriggered(QString fileName)
     /* change DLT file working directory */
     workingDirectory.setDltDirectory(QFileInfo(fileName).absolutePath());
 
+    stopCapture();
+    rotator.stop();
+    signalExtractor.stop();
     qfile.close();
     outputfile.close();
 
@@ -1589,6 +1715,8 @@ void MainWindow::on_action_menuFile_Clear_triggered()
 
     if(outputfile.isOpen())
     {
+        stopCapture();
+        rotator.stop();
         if (outputfile.size() == 0)
         {
             deleteactualFile();
@@ -1645,16 +1773,7 @@ void MainWindow::contextLoadingFile(QDltMsg &msg)
     if ( (msg.getType()==QDltMsg::DltTypeControl) && (msg.getSubtype()==QDltMsg::DltControlResponse))
     {
         /* find ecu item */
-        EcuItem *ecuitemFound = 0;
-        for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
-        {
-            EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-            if(ecuitem->id == msg.getEcuid())
-            {
-                ecuitemFound = ecuitem;
-                break;
-            }
-        }
+        EcuItem *ecuitemFound = project.findEcu(msg.getEcuid());
 
         if(!ecuitemFound)
         {
@@ -1750,6 +1869,13 @@ void MainWindow::reloadLogFileFinishFilter()
         }
     }
 
+    // show cost of the plugins
+    for(int num = 0; num < project.plugin->topLevelItemCount(); num++)
+    {
+        PluginItem *item = (PluginItem*)project.plugin->topLevelItem(num);
+        item->update();
+    }
+
     // enable filter if requested
     qfile.enableFilter(QDltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool());
     qfile.enableSortByTime(QDltSettingsManager::getInstance()->value("startup/sortByTimeEnabled", false).toBool());
@@ -1771,13 +1897,29 @@ void MainWindow::reloadLogFileFinishFilter()
         QList<int> list = dltIndexer->getGetLogInfoList();
         QDltMsg msg;
 
+        /* the messages are spread over the file, they are read at once */
+        QVector<qint64> indexes;
+        QVector<QByteArray> data;
         for(int num=0;num<list.size();num++)
+            indexes.append(list[num]);
+        qfile.getMsgs(indexes,data);
+
+        project.beginEcuUpdate();
+        for(int num=0;num<data.size();num++)
         {
-            if(qfile.getMsg(list[num],msg))
+            if(msg.setMsg(data[num]))
                 contextLoadingFile(msg);
         }
+        project.endEcuUpdate();
     }
 
+    // show message statistics of the loaded files
+    if(dltIndexer->getMode() == DltFileIndexer::modeIndexAndFilter)
+        project.updateStatistics(dltIndexer->getStatistics());
+
+    // show message rate of all and of the filtered messages
+    ui->timelineWidget->setRatePyramids(dltIndexer->getRatePyramid(), dltIndexer->getFilterRatePyramid());
+
     // reconnect ecus again
     //connectPreviouslyConnectedECUs();
 
@@ -1788,6 +1930,7 @@ void MainWindow::reloadLogFileFinishFilter()
     statusProgressBar->reset();
     statusProgressBar->hide();
 
+    checkMemoryBudget();
 }
 
 void MainWindow::reloadLogFileFinishDefaultFilter()
@@ -1795,6 +1938,60 @@ void MainWindow::reloadLogFileFinishDefaultFilter()
     // hide progress bar when finished
     statusProgressBar->reset();
     statusProgressBar->hide();
+
+    checkMemoryBudget();
+}
+
+void MainWindow::indexerFinished()
+{
+    // split the log file, which became full while the indexer was running
+    if(splitPending)
+    {
+        splitPending = false;
+        if(outputfile.isOpen() && !qfile.getCapture() && settings->splitlogfile != 0 && !DltExporter::isRunning())
+            createsplitfile();
+    }
+}
+
+void MainWindow::memoryUsage(QDltMemoryUsage &usage)
+{
+    qfile.memoryUsage(usage);
+    if(dltIndexer)
+        dltIndexer->memoryUsage(usage);
+    searchDlg->memoryUsage(usage);
+    signalExtractor.memoryUsage(usage);
+}
+
+void MainWindow::checkMemoryBudget()
+{
+    QDltMemoryUsage usage;
+    memoryUsage(usage);
+
+    if(QDltOptManager::getInstance()->issilentMode())
+    {
+        QStringList report = usage.report();
+        for(int num = 0; num < report.size(); num++)
+            qDebug().noquote() << "Memory" << report[num];
+    }
+
+    if(!settings->memoryBudget)
+        return;
+
+    qint64 budget = (qint64) settings->memoryBudgetMB * 1024 * 1024;
+    if(usage.total() <= budget)
+        return;
+
+    /* release the caches, which are rebuilt on demand */
+    qDebug() << "Memory budget of" << settings->memoryBudgetMB << "MB exceeded, releasing caches";
+    searchDlg->clearCacheHistory();
+    signalExtractor.clear();
+    if(usage.bytes(QString("Default filter indexes")) > 0 && dltIndexer && !dltIndexer->isRunning())
+        resetDefaultFilter();
+
+    usage = QDltMemoryUsage();
+    memoryUsage(usage);
+    if(usage.total() > budget)
+        qDebug() << "Memory budget still exceeded:" << QDltMemoryUsage::toString(usage.total());
 }
 
 void MainWindow::reloadLogFile(bool update, bool multithreaded)
@@ -1816,6 +2013,7 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
         autoloadPluginsVersionEcus.clear();
         autoloadPluginsVersionStrings.clear();
         statusFileVersion->setText("Version: <n.a.>");
+        pluginManager.clearStatistics();
     }
 
     // update indexFilter only if index already generated
@@ -1836,6 +2034,7 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
     }
     else // no update
     {
+        stopCapture();
         dltIndexer->setMode(DltFileIndexer::modeIndexAndFilter);
         clearSelection();
     }
@@ -1854,8 +2053,9 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
     tableModel->setForceEmpty(true);
     tableModel->modelChanged();
 
-    // stop last indexing process, if any
+    // stop last indexing process and signal extraction, if any
     dltIndexer->stop();
+    signalExtractor.stop();
 
     // open qfile
     if( false == update)
@@ -1899,8 +2099,11 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
     dltIndexer->setFiltersEnabled(QDltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool());
     dltIndexer->setSortByTimeEnabled(QDltSettingsManager::getInstance()->value("startup/sortByTimeEnabled", false).toBool());
     dltIndexer->setSortByTimestampEnabled(QDltSettingsManager::getInstance()->value("startup/sortByTimestampEnabled", false).toBool());
+    dltIndexer->setFoldRepeatsEnabled(QDltSettingsManager::getInstance()->value("startup/foldRepeatsEnabled", false).toBool());
     dltIndexer->setMultithreaded(multithreaded);
     dltIndexer->setFilterCacheEnabled(settings->filterCache);
+    signalExtractor.setPluginsEnabled(pluginsEnabled);
+    signalExtractor.setCacheEnabled(settings->filterCache);
 
     // run through all viewer plugins
     // must be run in the UI thread, if some gui actions are performed
@@ -1950,6 +2153,7 @@ void MainWindow::reloadLogFileDefaultFilter()
     dltIndexer->setFiltersEnabled(QDltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool());
     dltIndexer->setSortByTimeEnabled(QDltSettingsManager::getInstance()->value("startup/sortByTimeEnabled", false).toBool());
     dltIndexer->setSortByTimestampEnabled(QDltSettingsManager::getInstance()->value("startup/sortByTimestampEnabled", false).toBool());
+    dltIndexer->setFoldRepeatsEnabled(QDltSettingsManager::getInstance()->value("startup/foldRepeatsEnabled", false).toBool());
 
     // start indexing
     dltIndexer->start();
@@ -2001,6 +2205,16 @@ void MainWindow::applySettings()
     // disable or enable filter cache
     if(dltIndexer)
         dltIndexer->setFilterCacheEnabled(settings->filterCache);
+
+    // stop preparing log files, when the file size limit is disabled
+    if(settings->splitlogfile == 0)
+        rotator.stop();
+
+    // stop or resize the memory capture, the spill file is kept until the capture is restarted
+    if(!settings->captureMemory)
+        stopCapture();
+    else
+        capture.setMaxSize((qint64) settings->captureMemoryMB * 1024 * 1024);
 }
 
 
@@ -2468,7 +2682,8 @@ void MainWindow::on_action_menuConfig_Delete_All_Contexts_triggered()
         /* delete all applications from ECU from configuration */
         EcuItem* ecuitem = (EcuItem*) list.at(0);
 
-        (ecuitem->takeChildren()).clear();
+        qDeleteAll(ecuitem->takeChildren());
+        ecuitem->invalidateIndex();
     }
 }
 
@@ -2492,7 +2707,7 @@ void MainWindow::on_action_menuConfig_Application_Add_triggered()
             appitem->update();
 
             /* add new application to ECU */
-            ecuitem->addChild(appitem);
+            ecuitem->addApplication(appitem);
         }
     }
 }
@@ -2514,6 +2729,9 @@ void MainWindow::on_action_menuConfig_Application_Edit_triggered()
 
             /* update application item */
             appitem->update();
+
+            /* id may have changed */
+            ((EcuItem*) appitem->parent())->invalidateIndex();
         }
     }
 
@@ -2527,8 +2745,8 @@ void MainWindow::on_action_menuConfig_Application_Delete_triggered()
     {
         ApplicationItem* appitem = (ApplicationItem*) list.at(0);
 
-        /* remove application */
-        delete appitem->parent()->takeChild(appitem->parent()->indexOfChild(appitem));
+        /* remove application, destructor updates the index of the ECU */
+        delete appitem;
     }
 
 }
@@ -2555,7 +2773,7 @@ void MainWindow::on_action_menuConfig_Context_Add_triggered()
             conitem->update();
 
             /* add new context to application */
-            appitem->addChild(conitem);
+            appitem->addContext(conitem);
 
             /* send new default log level to ECU, if connected and if selected in dlg */
             if(dlg.update())
@@ -2594,6 +2812,9 @@ void MainWindow::on_action_menuConfig_Context_Edit_triggered()
             /* update context item */
             conitem->update();
 
+            /* id may have changed */
+            ((ApplicationItem*) conitem->parent())->invalidateIndex();
+
             /* send new log level to ECU, if connected and if selected in dlg */
             if(dlg.update())
             {
@@ -2709,8 +2930,8 @@ void MainWindow::on_action_menuConfig_Context_Delete_triggered()
     {
         ContextItem* conitem = (ContextItem*) list.at(0);
 
-        /* delete context from application */
-        delete conitem->parent()->takeChild(conitem->parent()->indexOfChild(conitem));
+        /* delete context from application, destructor updates the index of the application */
+        delete conitem;
     }
 
 }
@@ -2777,6 +2998,10 @@ void MainWindow::on_configWidget_customContextMenuRequested(QPoint pos)
         connect(action, SIGNAL(triggered()), this, SLOT(on_action_menuConfig_Save_All_ECUs_triggered()));
         menu.addAction(action);
 
+        action = new QAction("Save Statistics as csv", this);
+        connect(action, SIGNAL(triggered()), this, SLOT(onActionMenuConfigSaveStatisticsTriggered()));
+        menu.addAction(action);
+
         menu.addSeparator();
 
         action = new QAction("ECU Connect", this);
@@ -2916,6 +3141,10 @@ void MainWindow::on_configWidget_customContextMenuRequested(QPoint pos)
         connect(action, SIGNAL(triggered()), this, SLOT(on_action_menuConfig_ECU_Add_triggered()));
         menu.addAction(action);
 
+        action = new QAction("Save Statistics as csv", this);
+        connect(action, SIGNAL(triggered()), this, SLOT(onActionMenuConfigSaveStatisticsTriggered()));
+        menu.addAction(action);
+
     }
 
     /* show popup menu */
@@ -3544,28 +3773,17 @@ void MainWindow::readyRead()
 {
     /* signal emited when socket received data */
     //qDebug() << "readyRead" << __LINE__ << __FILE__;
-    /* Delay reading, if indexer is working on the dlt file */
-    if(true == dltIndexer->tryLock())
+    /* Reading does not wait for the indexer, the indexer and the views work on
+       snapshots of the indexes and the new messages are indexed when it is finished */
+    /* find socket which emited signal */
+    for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
     {
-        /* find socket which emited signal */
-        for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
+        EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
+        if( ecuitem && (ecuitem->socket == sender() || ecuitem->m_serialport == sender() || dltIndexer == sender() ) && ( true == ecuitem->connected || (ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP ) ) )
         {
-            EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-            if( ecuitem && (ecuitem->socket == sender() || ecuitem->m_serialport == sender() || dltIndexer == sender() ) && ( true == ecuitem->connected || (ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP ) ) )
-            {
-                read(ecuitem);
-            }
+            read(ecuitem);
         }
-        dltIndexer->unlock();
-    }
-    /*
-    else
-    {
-      qDebug() << "Fail locking indexer in readyRead" << __LINE__ << __FILE__;
-      //tbd: have a look why this one is called in commandline / mode File open
     }
-    */
-
 }
 
 void MainWindow::read(EcuItem* ecuitem)
@@ -3624,6 +3842,18 @@ void MainWindow::read(EcuItem* ecuitem)
     /* reading data; new data is added to the current buffer */
      ecuitem->totalBytesRcvd += bytesRcvd;
 
+     /* keep received messages in memory, when enabled in the settings */
+     if(settings->captureMemory && outputfile.isOpen() && !qfile.getCapture())
+     {
+         startCapture();
+     }
+
+     /* prepare the next log file, when the file size limit is active */
+     if(settings->splitlogfile != 0 && outputfile.isOpen() && !qfile.getCapture())
+     {
+         rotator.start(&outputfile, (qint64) settings->fmaxFileSizeMB * 1000 * 1000);
+     }
+
      while(((ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP ||
                 ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP) &&
                 ecuitem->ipcon.parseDlt(qmsg)) ||
@@ -3687,20 +3917,34 @@ void MainWindow::read(EcuItem* ecuitem)
                         startLoggingDateTime = QDateTime::currentDateTime();
                         }
 
-                    if( settings->splitlogfile != 0) // only in case the file size limit checking is active ...
-                     {
-                     // check if files size limit reached ( see Settings->Project Other->Maximum File Size )
-                     if( ( ((outputfile.size()+sizeof(DltStorageHeader)+bufferHeader.size()+bufferPayload.size())) > settings->fmaxFileSizeMB *1000*1000) )
-                      {
-                        createsplitfile();
-                      }
+                    if(qfile.getCapture())
+                    {
+                        // keep the message in memory, the capture writes the oldest messages in large blocks
+                        capture.addMessage(QByteArray::fromRawData((const char*)&str,sizeof(DltStorageHeader)),bufferHeader,bufferPayload);
                     }
+                    else
+                    {
+                        qint64 msgSize = sizeof(DltStorageHeader)+bufferHeader.size()+bufferPayload.size();
+                        if( settings->splitlogfile != 0) // only in case the file size limit checking is active ...
+                         {
+                         // check if files size limit reached ( see Settings->Project Other->Maximum File Size )
+                         if( rotator.isFull(msgSize) && !DltExporter::isRunning() )
+                          {
+                            // splitting reloads the file, do not abort a running index or filter run
+                            if(dltIndexer->isRunning())
+                                splitPending = true;
+                            else
+                                createsplitfile();
+                          }
+                        }
 
-                    // write data into file
-                    outputfile.write((char*)&str,sizeof(DltStorageHeader));
-                    outputfile.write(bufferHeader);
-                    outputfile.write(bufferPayload);
-                    outputfile.flush();
+                        // write data into file
+                        outputfile.write((char*)&str,sizeof(DltStorageHeader));
+                        outputfile.write(bufferHeader);
+                        outputfile.write(bufferPayload);
+                        outputfile.flush();
+                        rotator.addWritten(msgSize);
+                    }
                  }
             }
 
@@ -3756,12 +4000,23 @@ void MainWindow::createsplitfile()
     QFileInfo infoNew(info.absolutePath(),newFilename);
     qDebug() << "Split to" <<  outputfile.fileName() << "to" << infoNew.absoluteFilePath();
 
-    // rename old file
-    outputfile.copy(outputfile.fileName(),infoNew.absoluteFilePath());
-
     // set new start time
     startLoggingDateTime = QDateTime::currentDateTime();
 
+    // rename old file and continue with the prepared file
+    signalExtractor.stop();
+    qfile.close();
+    if(rotator.rotate(infoNew.absoluteFilePath()))
+    {
+        openFileNames = QStringList(info.absoluteFilePath());
+        reloadLogFile(false,true);
+        return;
+    }
+
+    // copy old file, if it could not be renamed
+    rotator.stop();
+    outputfile.copy(outputfile.fileName(),infoNew.absoluteFilePath());
+
     SplitTriggered(info.absoluteFilePath());
 
 }
@@ -3776,6 +4031,8 @@ void MainWindow::SplitTriggered(QString fileName)
     if(outputfile.isOpen())
     {
         //qDebug() << "isOpen" << fileName << __FILE__ << __LINE__;
+        stopCapture();
+        rotator.stop();
         if (outputfile.size() == 0)
         {
             deleteactualFile();
@@ -3816,6 +4073,34 @@ void MainWindow::SplitTriggered(QString fileName)
  }
 
 
+void MainWindow::startCapture()
+{
+    /* index the messages already written to the log file */
+    if(false == dltIndexer->isRunning())
+    {
+        updateIndex();
+    }
+
+    capture.clear();
+    capture.setMaxSize((qint64) settings->captureMemoryMB * 1024 * 1024);
+    capture.setSpillFile(settings->captureSpill ? &outputfile : 0);
+    qfile.setCapture(&capture);
+}
+
+void MainWindow::stopCapture()
+{
+    if(!qfile.getCapture())
+        return;
+
+    /* write all captured messages to the log file and index them again */
+    capture.setSpillFile(outputfile.isOpen() ? &outputfile : 0);
+    capture.flush();
+    rotator.stop();
+    qfile.setCapture(0);
+    capture.clear();
+    qfile.updateIndex();
+}
+
 void MainWindow::updateIndex()
 {
     QList<QDltPlugin*> activeViewerPlugins;
@@ -3832,6 +4117,9 @@ void MainWindow::updateIndex()
     int oldsize = qfile.size();
     qfile.updateIndex();
 
+    /* messages dropped by the capture are removed from the front */
+    oldsize = qMax(0, oldsize - qfile.getCaptureDropped());
+
     bool silentMode = !QDltOptManager::getInstance()->issilentMode();
 
     if(oldsize!=qfile.size())
@@ -3844,9 +4132,12 @@ void MainWindow::updateIndex()
         }
     }
 
+    QDltFileIterator messages(&qfile);
+    QVector<int> filterIndexes;
     for(int num=oldsize;num<qfile.size();num++)
     {
-     qmsg.setMsg(qfile.getMsg(num));
+     messages.seek(num);
+     qmsg.setMsg(messages.data());
 
      if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
      {
@@ -3864,7 +4155,7 @@ void MainWindow::updateIndex()
 
      if(qfile.checkFilter(qmsg))
       {
-            qfile.addFilterIndex(num);
+            filterIndexes.append(num);
       }
 
      if ( true == pluginsEnabled ) // we check the general plugin enabled/disabled switch
@@ -3877,6 +4168,9 @@ void MainWindow::updateIndex()
      }
     }
 
+    /* publish the new filter index once */
+    qfile.addFilterIndexes(filterIndexes);
+
     if (!draw_timer.isActive())
         draw_timer.start(draw_interval);
 
@@ -3897,6 +4191,13 @@ void MainWindow::draw_timeout()
     drawUpdatedView();
 }
 
+void MainWindow::performance_timeout()
+{
+    QString summary = QDltProfiler::getInstance()->summary();
+
+    statusPerformance->setText(summary.isEmpty() ? QString("Perf: no data") : QString("Perf: %1").arg(summary));
+}
+
 
 void MainWindow::drawUpdatedView()
 {
@@ -4045,6 +4346,9 @@ void MainWindow::controlMessage_ReceiveControlMessage(EcuItem *ecuitem, QDltMsg
         /* Support for status=6 and status=7 */
         if ((status==6) || (status==7))
         {
+            /* a single response can register thousands of contexts */
+            project.beginEcuUpdate();
+
             uint16_t count_app_ids=0,count_app_ids_tmp=0;
             DLT_MSG_READ_VALUE(count_app_ids_tmp,ptr,length,uint16_t);
             count_app_ids=DLT_ENDIAN_GET_16(((msg.getEndianness()==QDltMsg::DltEndiannessBigEndian)?DLT_HTYP_MSBF:0), count_app_ids_tmp);
@@ -4105,6 +4409,8 @@ void MainWindow::controlMessage_ReceiveControlMessage(EcuItem *ecuitem, QDltMsg
                     ptr+=application_description_length;
                 }
             }
+
+            project.endEcuUpdate();
         }
 
         char com_interface[DLT_ID_SIZE];
@@ -4307,13 +4613,21 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
         /* store ctrl message in log file */
         if (outputfile.isOpen())
         {
-            if (settings->writeControl)
+            if (settings->writeControl && qfile.getCapture())
+            {
+                // keep the message in memory in order with the received messages
+                capture.addMessage(QByteArray::fromRawData((const char*)msg.headerbuffer,sizeof(DltStorageHeader)),
+                                   QByteArray::fromRawData((const char*)msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader)),
+                                   QByteArray::fromRawData((const char*)msg.databuffer,msg.datasize));
+            }
+            else if (settings->writeControl)
             {
                 // https://bugreports.qt-project.org/browse/QTBUG-26069
                 outputfile.seek(outputfile.size());
                 outputfile.write((const char*)msg.headerbuffer,msg.headersize);
                 outputfile.write((const char*)msg.databuffer,msg.datasize);
                 outputfile.flush();
+                rotator.addWritten(msg.headersize+msg.datasize);
             }
         }
 
@@ -4383,13 +4697,21 @@ void MainWindow::controlMessage_WriteControlMessage(DltMessage &msg, QString app
         /* store ctrl message in log file */
         if (outputfile.isOpen())
         {
-            if (settings->writeControl)
+            if (settings->writeControl && qfile.getCapture())
+            {
+                // keep the message in memory in order with the received messages
+                capture.addMessage(QByteArray::fromRawData((const char*)msg.headerbuffer,sizeof(DltStorageHeader)),
+                                   QByteArray::fromRawData((const char*)msg.headerbuffer+sizeof(DltStorageHeader),msg.headersize-sizeof(DltStorageHeader)),
+                                   QByteArray::fromRawData((const char*)msg.databuffer,msg.datasize));
+            }
+            else if (settings->writeControl)
             {
                 // https://bugreports.qt-project.org/browse/QTBUG-26069
                 outputfile.seek(outputfile.size());
                 outputfile.write((const char*)msg.headerbuffer,msg.headersize);
                 outputfile.write((const char*)msg.databuffer,msg.datasize);
                 outputfile.flush();
+                rotator.addWritten(msg.headersize+msg.datasize);
             }
         }
 
@@ -5082,24 +5404,21 @@ void MainWindow::on_action_menuDLT_Send_Injection_triggered()
 void MainWindow::controlMessage_SetApplication(EcuItem *ecuitem, QString apid, QString appdescription)
 {
     /* Try to find App */
-    for(int numapp = 0; numapp < ecuitem->childCount(); numapp++)
-    {
-        ApplicationItem * appitem = (ApplicationItem *) ecuitem->child(numapp);
+    ApplicationItem *appitem = ecuitem->findApplication(apid);
 
-        if(appitem->id == apid)
-        {
-            appitem->description = appdescription;
-            appitem->update();
-            return;
-        }
+    if(appitem)
+    {
+        appitem->description = appdescription;
+        appitem->update();
+        return;
     }
 
     /* No app and no con found */
-    ApplicationItem* appitem = new ApplicationItem(ecuitem);
+    appitem = new ApplicationItem(ecuitem);
     appitem->id = apid;
     appitem->description = appdescription;
     appitem->update();
-    ecuitem->addChild(appitem);
+    ecuitem->addApplication(appitem);
 
 }
 
@@ -5108,62 +5427,39 @@ void MainWindow::controlMessage_SetContext(EcuItem *ecuitem, QString apid, QStri
     /* First try to find existing context */
     //qDebug() << "New CTX for" << apid << ctid << ctdescription;
 
-    for(int numapp = 0; numapp < ecuitem->childCount(); numapp++)
-    {
-        ApplicationItem * appitem = (ApplicationItem *) ecuitem->child(numapp);
-
-        for(int numcontext = 0; numcontext < appitem->childCount(); numcontext++)
-        {
-            ContextItem * conitem = (ContextItem *) appitem->child(numcontext);
+    ApplicationItem *appitem = ecuitem->findApplication(apid);
+    ContextItem *conitem = appitem ? appitem->findContext(ctid) : 0;
 
-            if(appitem->id == apid && conitem->id == ctid)
-            {
-                /* set new log level and trace status */
-                conitem->loglevel = log_level;
-                conitem->tracestatus = trace_status;
-                conitem->description = ctdescription;
-                conitem->status = ContextItem::valid;
-                conitem->update();
-                return;
-            }
-        }
+    if(conitem)
+    {
+        /* set new log level and trace status */
+        conitem->loglevel = log_level;
+        conitem->tracestatus = trace_status;
+        conitem->description = ctdescription;
+        conitem->status = ContextItem::valid;
+        conitem->update();
+        return;
     }
 
-    /* Try to find App */
-    for(int numapp = 0; numapp < ecuitem->childCount(); numapp++)
+    if(!appitem)
     {
-        ApplicationItem * appitem = (ApplicationItem *) ecuitem->child(numapp);
-
-        if(appitem->id == apid)
-        {
-            /* Add new context */
-            ContextItem* conitem = new ContextItem(appitem);
-            conitem->id = ctid;
-            conitem->loglevel = log_level;
-            conitem->tracestatus = trace_status;
-            conitem->description = ctdescription;
-            conitem->status = ContextItem::valid;
-            conitem->update();
-            appitem->addChild(conitem);
-
-            return;
-        }
+        /* No app and no con found */
+        appitem = new ApplicationItem(ecuitem);
+        appitem->id = apid;
+        appitem->description = QString("");
+        appitem->update();
+        ecuitem->addApplication(appitem);
     }
 
-    /* No app and no con found */
-    ApplicationItem* appitem = new ApplicationItem(ecuitem);
-    appitem->id = apid;
-    appitem->description = QString("");
-    appitem->update();
-    ecuitem->addChild(appitem);
-    ContextItem* conitem = new ContextItem(appitem);
+    /* Add new context */
+    conitem = new ContextItem(appitem);
     conitem->id = ctid;
     conitem->loglevel = log_level;
     conitem->tracestatus = trace_status;
     conitem->description = ctdescription;
     conitem->status = ContextItem::valid;
     conitem->update();
-    appitem->addChild(conitem);
+    appitem->addContext(conitem);
 }
 
 void MainWindow::controlMessage_Timezone(int timezone, unsigned char dst)
@@ -5181,36 +5477,19 @@ void MainWindow::controlMessage_UnregisterContext(QString ecuId,QString appId,QS
         return;
 
     /* find ecu item */
-    EcuItem *ecuitemFound = 0;
-    for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
-    {
-        EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-        if(ecuitem->id == ecuId)
-        {
-            ecuitemFound = ecuitem;
-            break;
-        }
-    }
+    EcuItem *ecuitemFound = project.findEcu(ecuId);
 
     if(!ecuitemFound)
         return;
 
     /* First try to find existing context */
-    for(int numapp = 0; numapp < ecuitemFound->childCount(); numapp++)
-    {
-        ApplicationItem * appitem = (ApplicationItem *) ecuitemFound->child(numapp);
+    ApplicationItem *appitem = ecuitemFound->findApplication(appId);
+    ContextItem *conitem = appitem ? appitem->findContext(ctId) : 0;
 
-        for(int numcontext = 0; numcontext < appitem->childCount(); numcontext++)
-        {
-            ContextItem * conitem = (ContextItem *) appitem->child(numcontext);
-
-            if(appitem->id == appId && conitem->id == ctId)
-            {
-                /* remove context */
-                delete conitem->parent()->takeChild(conitem->parent()->indexOfChild(conitem));
-                return;
-            }
-        }
+    if(conitem)
+    {
+        /* remove context, destructor updates the index of the application */
+        delete conitem;
     }
 }
 
@@ -5291,12 +5570,64 @@ void MainWindow::on_action_menuHelp_Command_Line_triggered()
                              QString(" -csv \t\t\tExport logfile to csv ( Excel ) instead\n")+
                              QString(" -d \t\t\tExport logfile to DLT format\n")+
                              QString(" -dd \t\t\tExport logfile to  decoded DLT format\n")+
+                             QString(" -col \t\t\tExport logfile to typed columns for analysis tools\n")+
                              QString(" -s \t\t\tEnable silent mode - no message boxes\n")+
                              QString("\n")+
                              QString(" -e <pluginname>|command|param1|..|param<n> \n\t\t\tExecute a command plugin with <n> parameters")
                              );
 }
 
+void MainWindow::on_action_menuHelp_Performance_Trace_toggled(bool checked)
+{
+    QDltProfiler::getInstance()->setEnabled(checked);
+
+    ui->action_menuHelp_Save_Performance_Trace->setEnabled(checked);
+    statusPerformance->setVisible(checked);
+
+    if(checked)
+    {
+        performance_timeout();
+        performance_timer.start(1000);
+    }
+    else
+    {
+        performance_timer.stop();
+    }
+}
+
+void MainWindow::on_action_menuHelp_Save_Performance_Trace_triggered()
+{
+    QString fileName = QFileDialog::getSaveFileName(this,
+        tr("Save Performance Trace"), workingDirectory.getExportDirectory(), tr("Chrome Trace (*.json);;All files (*.*)"));
+
+    if(fileName.isEmpty())
+    {
+        return;
+    }
+
+    workingDirectory.setExportDirectory(QFileInfo(fileName).absolutePath());
+
+    if(!QDltProfiler::getInstance()->writeChromeTrace(fileName))
+    {
+        QMessageBox::critical(0, QString("DLT Viewer"),
+                              QString("Cannot write performance trace \"%1\"").arg(fileName));
+    }
+}
+
+void MainWindow::on_action_menuHelp_Memory_Usage_triggered()
+{
+    QDltMemoryUsage usage;
+    memoryUsage(usage);
+
+    QString text = usage.report().join("\n");
+    if(settings->memoryBudget)
+        text += QString("\n\nBudget: %1").arg(QDltMemoryUsage::toString((qint64) settings->memoryBudgetMB * 1024 * 1024));
+    if(dltIndexer && dltIndexer->isRunning())
+        text += QString("\n\nIndexer is running, its indexes are not included.");
+
+    QMessageBox::information(this, QString("Memory Usage"), text);
+}
+
 void MainWindow::on_pluginWidget_itemSelectionChanged()
 {
     QList<QTreeWidgetItem *> list = project.plugin->selectedItems();
@@ -5786,6 +6117,7 @@ void MainWindow::loadPlugins()
       QDltPlugin* plugin = plugins[idx];
 
       plugin->initMainTableView( ui->tableView );
+      plugin->initSignalExtractor( &signalExtractor );
 
       PluginItem* item = new PluginItem(0,plugin);
 
@@ -6368,6 +6700,16 @@ void MainWindow::filterDialogWrite(FilterDialog &dlg,FilterItem* item)
     dlg.setMessageId_max(item->filter.messageIdMax);
     dlg.setMessageId_min(item->filter.messageIdMin);
 
+    dlg.setEnableTime(item->filter.enableTime);
+    dlg.setTimeMin(item->filter.timeMin);
+    dlg.setTimeMax(item->filter.timeMax);
+    dlg.setEnableTimestamp(item->filter.enableTimestamp);
+    dlg.setTimestampMin(item->filter.timestampMin);
+    dlg.setTimestampMax(item->filter.timestampMax);
+    dlg.setEnableArgument(item->filter.enableArgument);
+    dlg.setArgument(item->filter.argumentFilter.getArgument());
+    dlg.setArgumentComparison((int)(item->filter.argumentFilter.getComparison()));
+    dlg.setArgumentValue(item->filter.argumentFilter.getValue());
 }
 
 void MainWindow::filterDialogRead(FilterDialog &dlg,FilterItem* item)
@@ -6408,6 +6750,16 @@ void MainWindow::filterDialogRead(FilterDialog &dlg,FilterItem* item)
     item->filter.logLevelMin = dlg.getLogLevelMin();
     item->filter.messageIdMax=dlg.getMessageId_max();
     item->filter.messageIdMin=dlg.getMessageId_min();
+    item->filter.enableTime = dlg.getEnableTime();
+    item->filter.timeMin = dlg.getTimeMin();
+    item->filter.timeMax = dlg.getTimeMax();
+    item->filter.enableTimestamp = dlg.getEnableTimestamp();
+    item->filter.timestampMin = dlg.getTimestampMin();
+    item->filter.timestampMax = dlg.getTimestampMax();
+    item->filter.enableArgument = dlg.getEnableArgument();
+    item->filter.argumentFilter.setArgument(dlg.getArgument());
+    item->filter.argumentFilter.setComparison((QDltArgumentFilter::Comparison)(dlg.getArgumentComparison()));
+    item->filter.argumentFilter.setValue(dlg.getArgumentValue());
 
     /* update filter item */
     item->update();
@@ -6620,6 +6972,13 @@ void MainWindow::filterUpdate()
         qfile.addFilter(filter);
     }
     qfile.updateSortedFilter();
+
+    updateRegexSearchReplace();
+}
+
+void MainWindow::updateRegexSearchReplace()
+{
+    regexSearchReplace.update(&project, QDltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool());
 }
 
 
@@ -6681,6 +7040,19 @@ void MainWindow::on_tableView_customContextMenuRequested(QPoint pos)
     connect(action, SIGNAL(triggered()), this, SLOT(unmark_all_lines()));
     menu.addAction(action);
 
+    menu.addSeparator();
+
+    action = new QAction("Expand folded messages", this);
+    if(qfile.getIndexFilterFoldCount() == 0)
+    {
+        action->setEnabled(false);
+    }
+    else
+    {
+        connect(action, SIGNAL(triggered()), this, SLOT(expand_folded_lines()));
+    }
+    menu.addAction(action);
+
     /* show popup menu */
     menu.exec(globalPos);
 }
@@ -7109,7 +7481,22 @@ void MainWindow::on_action_menuConfig_Save_All_ECUs_triggered()
     asciiFile.close();
 }
 
+void MainWindow::onActionMenuConfigSaveStatisticsTriggered()
+{
+    QString filename = QFileDialog::getSaveFileName(this, tr("Save Statistics"), workingDirectory.getExportDirectory(), tr("Message statistics (*.csv);;All files (*.*)"));
+    if(filename.isEmpty())
+        return;
 
+    QFile csvFile(filename);
+    if(!csvFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || !dltIndexer->getStatistics().exportCsv(&csvFile))
+    {
+        QMessageBox::critical(0, QString("DLT Viewer"), QString("Cannot write statistics file %1").arg(filename));
+        return;
+    }
+    csvFile.close();
+
+    workingDirectory.setExportDirectory(QFileInfo(filename).absolutePath());
+}
 
 
 void MainWindow::on_action_menuConfig_Expand_All_ECUs_triggered()
@@ -7337,6 +7724,7 @@ void MainWindow::on_filtersEnabled_toggled(bool checked)
     QDltSettingsManager::getInstance()->setValue("startup/filtersEnabled", checked);
     ui->checkBoxSortByTime->setEnabled(checked);
     ui->checkBoxSortByTimestamp->setEnabled(checked);
+    ui->checkBoxFoldRepeats->setEnabled(checked);
     applyConfigEnabled(true);
 }
 
@@ -7366,6 +7754,12 @@ void MainWindow::on_checkBoxSortByTimestamp_toggled(bool checked)
     applyConfigEnabled(true);
 }
 
+void MainWindow::on_checkBoxFoldRepeats_toggled(bool checked)
+{
+    QDltSettingsManager::getInstance()->setValue("startup/foldRepeatsEnabled", checked);
+    applyConfigEnabled(true);
+}
+
 void MainWindow::syncCheckBoxesAndMenu()
 {
     auto pluginList = pluginManager.getPlugins();
@@ -7627,6 +8021,9 @@ void MainWindow::applyConfigEnabled(bool enabled)
 
         /* reset default filter selection and default filter index */
         resetDefaultFilter();
+
+        /* checked filters are shown without applying the configuration */
+        updateRegexSearchReplace();
     }
     else
     {
@@ -38,6 +38,7 @@
 #include "searchdialog.h"
 #include "filterdialog.h"
 #include "dltfileindexer.h"
+#include "dltfilerotator.h"
 #include "workingdirectory.h"
 #include "exporterdialog.h"
 #include "searchtablemodel.h"
@@ -125,8 +126,15 @@ private:
     QTimer draw_timer;
     int draw_interval;
 
+    /* Timer for performance trace summary */
+    QTimer performance_timer;
+
     QDltControl qcontrol;
     QFile outputfile;
+    QDltCaptureBuffer capture;
+    DltFileRotator rotator;
+    bool splitPending;  /* split file is full, split when the indexer is finished */
+    RegexSearchReplace regexSearchReplace;
     bool outputfileIsTemporary;
     bool outputfileIsFromCLI;
     TableModel *tableModel;
@@ -140,6 +148,7 @@ private:
     QLabel *statusBytesReceived;
     QLabel *statusByteErrorsReceived;
     QLabel *statusSyncFoundReceived;
+    QLabel *statusPerformance;
     QProgressBar *statusProgressBar;
 
     unsigned long totalBytesRcvd;
@@ -263,6 +272,14 @@ private:
 
     void exportSelection(bool ascii,bool file,bool payload_only);
     void exportSelection_searchTable(bool payload_only);
+    void exportRowsToClipboard(const QList<int> &rows, bool payload_only);
+
+    /* bytes used by the indexes and caches, caches are released when the budget is exceeded */
+    void memoryUsage(QDltMemoryUsage &usage);
+    void checkMemoryBudget();
+
+    /* compile the search and replace rules of the checked filters for the displayed payloads */
+    void updateRegexSearchReplace();
 
     void ControlServiceRequest(EcuItem* ecuitem, int service_id );
     void SendInjection(EcuItem* ecuitem);
@@ -299,6 +316,8 @@ private:
     void checkConnectionState();
     void read(EcuItem *ecuitem);
     void updateIndex();
+    void startCapture();
+    void stopCapture();
     void drawUpdatedView();
 
     void syncCheckBoxesAndMenu();
@@ -337,6 +356,7 @@ private:
     void commandLineConvertToASCII();
     void commandLineConvertToDLT();
     void commandLineConvertToUTF8();
+    void commandLineConvertToColumnar();
     void commandLineConvertToCSV();
     void commandLineConvertToDLTDecoded();
 
@@ -397,6 +417,7 @@ private slots:
     void reloadLogFileFinishIndex();
     void reloadLogFileFinishFilter();
     void reloadLogFileFinishDefaultFilter();
+    void indexerFinished();
     void triggerPluginsAutoload();
 
     void onTableViewSelectionChanged(const QItemSelection & selected, const QItemSelection & deselected);
@@ -441,6 +462,7 @@ public slots:
     void on_actionFindNext();
     void mark_unmark_lines();
     void unmark_all_lines();
+    void expand_folded_lines();
 
 
 private slots:
@@ -460,6 +482,9 @@ private slots:
     void on_action_menuHelp_Support_triggered();
     void on_action_menuHelp_Info_triggered();
     void on_action_menuHelp_Command_Line_triggered();
+    void on_action_menuHelp_Performance_Trace_toggled(bool checked);
+    void on_action_menuHelp_Save_Performance_Trace_triggered();
+    void on_action_menuHelp_Memory_Usage_triggered();
 
     // Config methods
     void on_action_menuConfig_Context_Delete_triggered();
@@ -481,6 +506,7 @@ private slots:
     void onActionMenuConfigSearchTableCopyToClipboardTriggered();
     void onActionMenuConfigSearchTableCopyPayloadToClipboardTriggered();
     void on_action_menuConfig_Save_All_ECUs_triggered();
+    void onActionMenuConfigSaveStatisticsTriggered();
 
     // DLT methods
     void on_action_menuDLT_Send_Injection_triggered();
@@ -525,6 +551,7 @@ private slots:
     void readyRead();
     void timeout();
     void draw_timeout();
+    void performance_timeout();
     void connectAll();
     void disconnectAll();
     void applySettings();
@@ -557,6 +584,7 @@ private slots:
 
     void on_checkBoxSortByTime_toggled(bool checked);
     void on_checkBoxSortByTimestamp_toggled(bool checked);
+    void on_checkBoxFoldRepeats_toggled(bool checked);
 
     void on_actionMarker_triggered();
 
@@ -605,6 +633,9 @@ public:
 
     QDltDefaultFilter defaultFilter;
 
+    /* Numeric signals of the log file, requested by plugins */
+    QDltSignalExtractor signalExtractor;
+
     QStringList openFileNames;
     QStringList list;
 
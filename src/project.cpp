@@ -36,6 +36,7 @@ EcuItem::EcuItem(QTreeWidgetItem *parent)
 , socket(0)
 {
     /* initialise receive buffer and message*/
+    applicationIndexValid = false;
     id = default_id;
     description = "A new ECU";
     interfacetype = INTERFACETYPE_TCP; /* default TCP */
@@ -176,6 +177,70 @@ void EcuItem::InvalidAll()
 
 }
 
+ApplicationItem *EcuItem::findApplication(const QString &apid)
+{
+    if(!applicationIndexValid)
+        rebuildIndex();
+
+    QMultiHash<quint32,ApplicationItem*>::iterator it = applicationIndex.find(dltIdKey(apid));
+    while(it != applicationIndex.end() && it.key() == dltIdKey(apid))
+    {
+        if(it.value()->id == apid)
+            return it.value();
+        ++it;
+    }
+
+    return 0;
+}
+
+void EcuItem::addApplication(ApplicationItem *appitem)
+{
+    /* the item may already be a child, if it was created with this parent */
+    if(appitem->parent() != this)
+        addChild(appitem);
+    if(applicationIndexValid)
+        applicationIndex.insert(dltIdKey(appitem->id), appitem);
+}
+
+void EcuItem::invalidateIndex()
+{
+    /* rebuilt with the next lookup */
+    applicationIndex.clear();
+    applicationIndexValid = false;
+}
+
+void EcuItem::removeFromIndex(ApplicationItem *appitem)
+{
+    QMultiHash<quint32,ApplicationItem*>::iterator it = applicationIndex.find(dltIdKey(appitem->id), appitem);
+    if(it != applicationIndex.end())
+    {
+        applicationIndex.erase(it);
+        return;
+    }
+
+    /* still stored under a previous id */
+    for(it = applicationIndex.begin(); it != applicationIndex.end(); ++it)
+    {
+        if(it.value() == appitem)
+        {
+            applicationIndex.erase(it);
+            return;
+        }
+    }
+}
+
+void EcuItem::rebuildIndex()
+{
+    applicationIndex.clear();
+    applicationIndex.reserve(childCount());
+    for(int numapp = 0; numapp < childCount(); numapp++)
+    {
+        ApplicationItem *appitem = (ApplicationItem *) child(numapp);
+        applicationIndex.insert(dltIdKey(appitem->id), appitem);
+    }
+    applicationIndexValid = true;
+}
+
 bool EcuItem::operator< ( const QTreeWidgetItem & other ) const {
 
     int column = treeWidget()->header()->sortIndicatorSection();
@@ -220,12 +285,14 @@ void EcuItem::updateAutoReconnectTimestamp()
 ApplicationItem::ApplicationItem(QTreeWidgetItem *parent)
     : QTreeWidgetItem(parent,application_type)
 {
-
+    contextIndexValid = false;
 }
 
 ApplicationItem::~ApplicationItem()
 {
-
+    /* parent is already reset when the whole ECU is deleted */
+    if(parent() && parent()->type() == ecu_type)
+        ((EcuItem *) parent())->removeFromIndex(this);
 }
 
 void ApplicationItem::update()
@@ -234,6 +301,70 @@ void ApplicationItem::update()
     setData(1,0,description);
 }
 
+ContextItem *ApplicationItem::findContext(const QString &ctid)
+{
+    if(!contextIndexValid)
+        rebuildIndex();
+
+    QMultiHash<quint32,ContextItem*>::iterator it = contextIndex.find(dltIdKey(ctid));
+    while(it != contextIndex.end() && it.key() == dltIdKey(ctid))
+    {
+        if(it.value()->id == ctid)
+            return it.value();
+        ++it;
+    }
+
+    return 0;
+}
+
+void ApplicationItem::addContext(ContextItem *conitem)
+{
+    /* the item may already be a child, if it was created with this parent */
+    if(conitem->parent() != this)
+        addChild(conitem);
+    if(contextIndexValid)
+        contextIndex.insert(dltIdKey(conitem->id), conitem);
+}
+
+void ApplicationItem::invalidateIndex()
+{
+    /* rebuilt with the next lookup */
+    contextIndex.clear();
+    contextIndexValid = false;
+}
+
+void ApplicationItem::removeFromIndex(ContextItem *conitem)
+{
+    QMultiHash<quint32,ContextItem*>::iterator it = contextIndex.find(dltIdKey(conitem->id), conitem);
+    if(it != contextIndex.end())
+    {
+        contextIndex.erase(it);
+        return;
+    }
+
+    /* still stored under a previous id */
+    for(it = contextIndex.begin(); it != contextIndex.end(); ++it)
+    {
+        if(it.value() == conitem)
+        {
+            contextIndex.erase(it);
+            return;
+        }
+    }
+}
+
+void ApplicationItem::rebuildIndex()
+{
+    contextIndex.clear();
+    contextIndex.reserve(childCount());
+    for(int numcontext = 0; numcontext < childCount(); numcontext++)
+    {
+        ContextItem *conitem = (ContextItem *) child(numcontext);
+        contextIndex.insert(dltIdKey(conitem->id), conitem);
+    }
+    contextIndexValid = true;
+}
+
 bool ApplicationItem::operator< ( const QTreeWidgetItem & other ) const {
 
     int column = treeWidget()->header()->sortIndicatorSection();
@@ -264,7 +395,9 @@ ContextItem::ContextItem(QTreeWidgetItem *parent)
 
 ContextItem::~ContextItem()
 {
-
+    /* parent is already reset when the whole application is deleted */
+    if(parent() && parent()->type() == application_type)
+        ((ApplicationItem *) parent())->removeFromIndex(this);
 }
 
 void ContextItem::update()
@@ -334,6 +467,9 @@ FilterItem::FilterItem(QTreeWidgetItem *parent)
     filter.enableCtrlMsgs = false;
     filter.enableMarker = false;
     filter.enableMessageId = false;
+    filter.enableTime = false;
+    filter.enableTimestamp = false;
+    filter.enableArgument = false;
 
     filter.filterColour = "#000000";  // default constructor for QColor initialized at RGB 0,0,0
 
@@ -410,6 +546,19 @@ void FilterItem::update()
             if (filter.messageIdMax>0)
                 text += QString(".. %1 ").arg(filter.messageIdMax);
     }
+    if(filter.enableTime ) {
+        text += QString("%1 .. %2 ")
+                .arg(QDateTime::fromMSecsSinceEpoch(filter.timeMin / 1000).toString("yyyy/MM/dd hh:mm:ss.zzz"))
+                .arg(QDateTime::fromMSecsSinceEpoch(filter.timeMax / 1000).toString("yyyy/MM/dd hh:mm:ss.zzz"));
+    }
+    if(filter.enableTimestamp ) {
+        text += QString("%1 .. %2 ").arg(QDltTimeFormatter::timestamp(filter.timestampMin)).arg(QDltTimeFormatter::timestamp(filter.timestampMax));
+    }
+    if(filter.enableArgument ) {
+        text += QString("%1 %2 %3 ").arg(filter.argumentFilter.getArgument())
+                .arg(QDltArgumentFilter::comparisonText(filter.argumentFilter.getComparison()))
+                .arg(filter.argumentFilter.getValue());
+    }
     if(filter.enableCtrlMsgs ) {
         text += QString("CtrlMsgs ");
     }
@@ -582,6 +731,8 @@ void PluginItem::update()
     setData(1,0,QString("%1").arg(*modeString));
     //setData(3,0,QString("%1").arg(list.size()));
     setData(2,0,QString("%1").arg(this->getFilename()));
+    setData(3,0,plugin->statisticsText());
+    setToolTip(3,QString("Time spent in the plugin since the last file was loaded"));
 
     delete modeString;
 }
@@ -635,6 +786,7 @@ Project::Project()
     filter = NULL;
     plugin = NULL;
     settings = NULL;
+    ecuUpdateDepth = 0;
 }
 
 Project::~Project()
@@ -648,6 +800,89 @@ void Project::Clear()
     filter->clear();
 }
 
+EcuItem *Project::findEcu(const QString &ecuid)
+{
+    /* only a handful of ECUs, linear search is sufficient */
+    for(int num = 0; num < ecu->topLevelItemCount(); num++)
+    {
+        EcuItem *ecuitem = (EcuItem*)ecu->topLevelItem(num);
+        if(ecuitem->id == ecuid)
+            return ecuitem;
+    }
+
+    return 0;
+}
+
+void Project::beginEcuUpdate()
+{
+    if(ecuUpdateDepth++ == 0)
+    {
+        ecu->setUpdatesEnabled(false);
+        ecu->setSortingEnabled(false);
+    }
+}
+
+void Project::endEcuUpdate()
+{
+    if(ecuUpdateDepth > 0 && --ecuUpdateDepth == 0)
+    {
+        /* sorts the tree once instead of on every added item */
+        ecu->setSortingEnabled(true);
+        ecu->setUpdatesEnabled(true);
+    }
+}
+
+static void setStatisticsData(QTreeWidgetItem *item, const DltStatisticsEntry *entry)
+{
+    if(!entry)
+    {
+        for(int column = 4; column < 7; column++)
+        {
+            item->setData(column,Qt::DisplayRole,QVariant());
+            item->setToolTip(column,QString());
+        }
+        return;
+    }
+
+    /* numbers instead of strings, so the columns sort numerically */
+    item->setData(4,Qt::DisplayRole,entry->messages);
+    item->setData(5,Qt::DisplayRole,entry->bytes);
+    item->setData(6,Qt::DisplayRole,entry->peakRate);
+
+    QString levels = QString("Messages: %1\nFatal: %2\nError: %3\nWarn: %4\nInfo: %5\nDebug: %6\nVerbose: %7\nOther: %8")
+            .arg(entry->messages).arg(entry->levels[1]).arg(entry->levels[2]).arg(entry->levels[3])
+            .arg(entry->levels[4]).arg(entry->levels[5]).arg(entry->levels[6]).arg(entry->levels[0]);
+    item->setToolTip(4,levels);
+    item->setToolTip(5,QString("Bytes: %1").arg(entry->bytes));
+    item->setToolTip(6,QString("Peak: %1 msg/s at %2").arg(entry->peakRate)
+                     .arg(QDateTime::fromTime_t(entry->peakSecond).toString("yyyy/MM/dd hh:mm:ss")));
+}
+
+void Project::updateStatistics(const DltStatistics &statistics)
+{
+    beginEcuUpdate();
+
+    for(int num = 0; num < ecu->topLevelItemCount(); num++)
+    {
+        EcuItem *ecuitem = (EcuItem*)ecu->topLevelItem(num);
+        setStatisticsData(ecuitem, statistics.find(DltStatistics::GroupEcu, ecuitem->id));
+
+        for(int numapp = 0; numapp < ecuitem->childCount(); numapp++)
+        {
+            ApplicationItem *appitem = (ApplicationItem*)ecuitem->child(numapp);
+            setStatisticsData(appitem, statistics.find(DltStatistics::GroupApplication, ecuitem->id, appitem->id));
+
+            for(int numcon = 0; numcon < appitem->childCount(); numcon++)
+            {
+                ContextItem *conitem = (ContextItem*)appitem->child(numcon);
+                setStatisticsData(conitem, statistics.find(DltStatistics::GroupContext, ecuitem->id, appitem->id, conitem->id));
+            }
+        }
+    }
+
+    endEcuUpdate();
+}
+
 bool Project::Load(QString filename)
 {
     QFile file(filename);
@@ -907,7 +1142,7 @@ bool Project::Load(QString filename)
               {
                   if(ecuitem)
                   {
-                      ecuitem->addChild(applicationitem);
+                      ecuitem->addApplication(applicationitem);
                       applicationitem->update();
                   }
                   applicationitem = 0;
@@ -917,7 +1152,7 @@ bool Project::Load(QString filename)
               {
                   if(applicationitem)
                   {
-                      applicationitem->addChild(contextitem);
+                      applicationitem->addContext(contextitem);
                       contextitem->update();
                   }
                   contextitem = 0;
@@ -31,6 +31,7 @@
 #include <QDateTime>
 #include <QSerialPort>
 #include <QPluginLoader>
+#include <QHash>
 
 #if defined(_MSC_VER)
 #include <cstdint>
@@ -40,6 +41,7 @@
 
 #include "settingsdialog.h"
 #include "mcudpsocket.h"
+#include "dltstatistics.h"
 
 extern "C"
 {
@@ -57,6 +59,18 @@ extern "C"
 
 enum dlt_item_type { ecu_type = QTreeWidgetItem::UserType, application_type, context_type, filter_type, plugin_type };
 
+/* Pack a DLT id of up to four characters into a hash key */
+inline quint32 dltIdKey(const QString &id)
+{
+    quint32 key = 0;
+    for(int num = 0; num < 4; num++)
+        key = (key << 8) | ((num < id.size()) ? (quint8) id.at(num).toLatin1() : 0);
+    return key;
+}
+
+class ApplicationItem;
+class ContextItem;
+
 class EcuItem  : public QTreeWidgetItem
 {
 public:
@@ -72,6 +86,14 @@ public:
 
     void InvalidAll();
 
+    /* hashed lookup of applications, replaces linear search over children */
+    /* applications are added with addApplication(), other changes of the children
+       or of their ids must call invalidateIndex() */
+    ApplicationItem *findApplication(const QString &apid);
+    void addApplication(ApplicationItem *appitem);
+    void removeFromIndex(ApplicationItem *appitem);
+    void invalidateIndex();
+
     /* configuration all */
     QString id;
     QString default_id = "ECU";
@@ -118,6 +140,11 @@ private:
     QDateTime autoReconnectTimestamp;
     bool operator< ( const QTreeWidgetItem & other ) const;
 
+    void rebuildIndex();
+
+    QMultiHash<quint32,ApplicationItem*> applicationIndex;
+    bool applicationIndexValid;
+
     /* configuration TCP / UDP */
      QString hostname;
      QString mcastIP;
@@ -183,8 +210,20 @@ public:
 
     void update();
 
+    /* hashed lookup of contexts, replaces linear search over children */
+    /* contexts are added with addContext(), other changes of the children
+       or of their ids must call invalidateIndex() */
+    ContextItem *findContext(const QString &ctid);
+    void addContext(ContextItem *conitem);
+    void removeFromIndex(ContextItem *conitem);
+    void invalidateIndex();
+
 private:
     bool operator< ( const QTreeWidgetItem & other ) const;
+    void rebuildIndex();
+
+    QMultiHash<quint32,ContextItem*> contextIndex;
+    bool contextIndexValid;
 };
 
 class ContextItem  : public QTreeWidgetItem
@@ -301,6 +340,16 @@ public:
     bool SaveFilter(QString filename);
     bool LoadFilter(QString filename,bool replace);
 
+    /* find ECU item by id, returns 0 if not found */
+    EcuItem *findEcu(const QString &ecuid);
+
+    /* suspend sorting and repainting of the ECU tree while adding many items */
+    void beginEcuUpdate();
+    void endEcuUpdate();
+
+    /* show message counts, volumes and rates of the loaded file in the ECU tree */
+    void updateStatistics(const DltStatistics &statistics);
+
     QTreeWidget *ecu;
     QTreeWidget *filter;
     QTreeWidget *plugin;
@@ -308,7 +357,7 @@ public:
     QDltSettingsManager *settings;
 
 private:
-
+    int ecuUpdateDepth;
 
 };
 
@@ -0,0 +1,188 @@
+#include <QDebug>
+
+#include "regex_search_replace.h"
+
+RegexSearchReplace::RegexSearchReplace()
+{
+    cache.setMaxCost(DLT_REGEX_SEARCH_REPLACE_CACHE_SIZE);
+}
+
+void RegexSearchReplace::update(Project *project, bool filtersEnabled)
+{
+    clear();
+
+    if(!filtersEnabled)
+        return;
+
+    for(int num = 0; num < project->filter->topLevelItemCount(); num++)
+    {
+        FilterItem *item = (FilterItem*)project->filter->topLevelItem(num);
+        if(item->checkState(0) == Qt::Checked && item->filter.enableRegexSearchReplace)
+            addRule(item->filter.regex_search, item->filter.regex_replace);
+    }
+}
+
+void RegexSearchReplace::clear()
+{
+    rules.clear();
+    cache.clear();
+}
+
+bool RegexSearchReplace::addRule(const QString &search, const QString &replace)
+{
+    Rule rule;
+    rule.regex.setPattern(search);
+    if(!rule.regex.isValid())
+    {
+        qDebug() << "Invalid search and replace regular expression" << search << rule.regex.errorString();
+        return false;
+    }
+    rule.regex.optimize();
+    rule.replace = parseReplace(replace, rule.regex.captureCount());
+
+    rules.append(rule);
+    cache.clear();
+    return true;
+}
+
+QVector<RegexSearchReplace::Part> RegexSearchReplace::parseReplace(const QString &replace, int captureCount)
+{
+    QVector<Part> parts;
+    Part text;
+    text.group = Part::Text;
+
+    for(int pos = 0; pos < replace.size(); pos++)
+    {
+        QChar c = replace.at(pos);
+        QChar next = (pos + 1 < replace.size()) ? replace.at(pos + 1) : QChar();
+        Part part;
+        part.group = Part::Text;
+
+        if(c != QLatin1Char('$') || next.isNull())
+        {
+            text.text += c;
+            continue;
+        }
+
+        if(next == QLatin1Char('$'))
+        {
+            text.text += c;
+            pos++;
+            continue;
+        }
+        else if(next == QLatin1Char('&'))
+        {
+            part.group = 0;
+            pos++;
+        }
+        else if(next == QLatin1Char('`'))
+        {
+            part.group = Part::Prefix;
+            pos++;
+        }
+        else if(next == QLatin1Char('\''))
+        {
+            part.group = Part::Suffix;
+            pos++;
+        }
+        else if(next.isDigit())
+        {
+            /* two digits, if there are enough groups */
+            int start = pos;
+            int group = next.digitValue();
+            pos++;
+            if(pos + 1 < replace.size() && replace.at(pos + 1).isDigit() &&
+               group * 10 + replace.at(pos + 1).digitValue() <= captureCount)
+            {
+                group = group * 10 + replace.at(pos + 1).digitValue();
+                pos++;
+            }
+            if(group == 0 || group > captureCount)
+            {
+                /* not a group, keep the text */
+                text.text += replace.mid(start, pos - start + 1);
+                continue;
+            }
+            part.group = group;
+        }
+        else
+        {
+            text.text += c;
+            continue;
+        }
+
+        if(!text.text.isEmpty())
+        {
+            parts.append(text);
+            text.text.clear();
+        }
+        parts.append(part);
+    }
+
+    if(!text.text.isEmpty())
+        parts.append(text);
+
+    return parts;
+}
+
+void RegexSearchReplace::applyRule(const Rule &rule, QString &data)
+{
+    QRegularExpressionMatchIterator it = rule.regex.globalMatch(data);
+    if(!it.hasNext())
+        return;
+
+    QString result;
+    result.reserve(data.size());
+    int last = 0;
+    while(it.hasNext())
+    {
+        QRegularExpressionMatch match = it.next();
+        result += data.midRef(last, match.capturedStart() - last);
+
+        for(int num = 0; num < rule.replace.size(); num++)
+        {
+            const Part &part = rule.replace.at(num);
+            if(part.group == Part::Text)
+                result += part.text;
+            else if(part.group == Part::Prefix)
+                result += data.leftRef(match.capturedStart());
+            else if(part.group == Part::Suffix)
+                result += data.midRef(match.capturedEnd());
+            else
+                result += match.capturedRef(part.group);
+        }
+
+        last = match.capturedEnd();
+    }
+    result += data.midRef(last);
+
+    data = result;
+}
+
+void RegexSearchReplace::apply(QString &data, qint64 key) const
+{
+    if(rules.isEmpty())
+        return;
+
+    if(key >= 0)
+    {
+        Result *result = cache.object(key);
+        if(result && result->source == data)
+        {
+            data = result->text;
+            return;
+        }
+    }
+
+    QString source = data;
+    for(int num = 0; num < rules.size(); num++)
+        applyRule(rules.at(num), data);
+
+    if(key >= 0)
+    {
+        Result *result = new Result;
+        result->source = source;
+        result->text = data;
+        cache.insert(key, result);
+    }
+}
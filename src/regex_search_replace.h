@@ -1,18 +1,80 @@
 #ifndef REGEX_SEARCH_REPLACE_H
 #define REGEX_SEARCH_REPLACE_H
 
+#include <QString>
+#include <QVector>
+#include <QCache>
+#include <QRegularExpression>
+
 #include "project.h"
-#include <regex>
-#include <stdlib.h>
 
+/* number of displayed payloads, for which the replaced text is kept */
+#define DLT_REGEX_SEARCH_REPLACE_CACHE_SIZE 2000
+
+//! Search and replace rules of the active filters, applied to the displayed payload
+/*!
+  The rules are compiled once when the filters change and kept in a
+  flat list, so painting a cell does not walk the filter tree. Each rule
+  replaces all matches in one pass on the QString, the replacement
+  is parsed in advance. The replacement uses the ECMAScript format:
+  $& is the match, $1 to $99 are the captured groups, $` and $' are
+  the text before and after the match and $$ is a dollar sign.
 
-static void apply_regex_string(QString &data, const QString& regex_search, const QString& regex_replace)
+  The result of the last displayed payloads is kept, keyed by the
+  position of the message. Only used in the GUI thread.
+*/
+class RegexSearchReplace
 {
-    std::regex regex(regex_search.toStdString());
+public:
+    RegexSearchReplace();
+
+    //! Collect the rules of the checked filters, nothing if the filters are disabled
+    void update(Project *project, bool filtersEnabled);
+
+    //! Delete all rules
+    void clear();
+
+    //! Add a rule, invalid regular expressions are skipped
+    bool addRule(const QString &search, const QString &replace);
+
+    bool isEmpty() const { return rules.isEmpty(); }
+
+    //! Apply all rules in order
+    /*!
+      \param data Text to be changed
+      \param key Position of the message, to reuse the result of the same text, -1 to not use the cache
+    */
+    void apply(QString &data, qint64 key = -1) const;
+
+private:
+    class Part
+    {
+    public:
+        typedef enum { Text = -1, Prefix = -2, Suffix = -3 } Type;
+
+        int group;      /* captured group or type */
+        QString text;
+    };
+
+    class Rule
+    {
+    public:
+        QRegularExpression regex;
+        QVector<Part> replace;
+    };
+
+    class Result
+    {
+    public:
+        QString source;
+        QString text;
+    };
 
-    std::string payload_str = std::regex_replace(data.toStdString(), regex, regex_replace.toStdString());
+    static QVector<Part> parseReplace(const QString &replace, int captureCount);
+    static void applyRule(const Rule &rule, QString &data);
 
-    data = QString::fromStdString(payload_str);
-}
+    QVector<Rule> rules;
+    mutable QCache<qint64,Result> cache;
+};
 
 #endif // REGEX_SEARCH_REPLACE_H
@@ -38,6 +38,7 @@ SearchDialog::SearchDialog(QWidget *parent) :
     match = false;
     onceClicked = false;
     startLine = -1;
+    m_searchtablemodel = NULL;
     is_PayloadStartFound = false;
     is_PayloadEndFound = false;
     is_PayLoadRangeValid = false;
@@ -386,11 +387,13 @@ void SearchDialog::findMessages(long int searchLine, long int searchBorder, QReg
 {
 
     QDltMsg msg;
+    QDltTimeFormatter timeFormatter;
     QByteArray buf;
     QString text;
     QString headerText;
     int ctr = 0;
     Qt::CaseSensitivity is_Case_Sensitive = Qt::CaseInsensitive;
+    QDltProfilerSpan span("search", QStringLiteral("Search"));
 
     starttime();
 
@@ -416,6 +419,25 @@ void SearchDialog::findMessages(long int searchLine, long int searchBorder, QReg
     bool msgIdEnabled=QDltSettingsManager::getInstance()->value("startup/showMsgId", true).toBool();
     QString msgIdFormat=QDltSettingsManager::getInstance()->value("startup/msgIdFormat", "0x%x").toString();
 
+    QDltFileIterator messages(file, QDltFileIterator::FilteredMessages);
+
+    /* blocks of messages, which cannot match the application, context or timestamp, are skipped */
+    QVector<QDltBlockSummary> blocks;
+    QVector<bool> blockMayMatch;
+    if(fIs_APID_CTID_requested || is_TimeStampSearchSelected)
+    {
+        bool decoded = QDltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool();
+        blocks = file->getBlockSummaries();
+        blockMayMatch.resize(blocks.size());
+        for(int num = 0; num < blocks.size(); num++)
+        {
+            blockMayMatch[num] = (!fIs_APID_CTID_requested || blocks[num].mayMatchIds(stApid, stCtid, decoded)) &&
+                                 (!is_TimeStampSearchSelected || blocks[num].mayMatchTimestamp(dTimeStampStart, dTimeStampStop));
+        }
+    }
+    QDltFileSnapshot snapshot;
+    bool filtered = file->isFilter();
+
     do
     {
         ctr++; // for file progress indication
@@ -450,8 +472,22 @@ void SearchDialog::findMessages(long int searchLine, long int searchBorder, QReg
             QApplication::processEvents();
         }
 
-        /* get the message with the selected item id */
-        buf = file->getMsgFilter(searchLine);
+        if(!blocks.isEmpty())
+        {
+            /* take the snapshot of the indexes once per block of rows, not for every row */
+            if(!snapshot || searchLine % QDLT_BLOCK_SUMMARY_SIZE == 0 || (filtered && searchLine >= snapshot->indexFilter.size()))
+                snapshot = file->snapshot();
+            qint64 pos = searchLine;
+            if(filtered)
+                pos = (searchLine < snapshot->indexFilter.size()) ? snapshot->indexFilter[searchLine] : -1;
+            qint64 block = pos / QDLT_BLOCK_SUMMARY_SIZE;
+            if(pos >= 0 && block < blocks.size() && pos - block * QDLT_BLOCK_SUMMARY_SIZE < blocks[block].size() && !blockMayMatch[block])
+                continue;
+        }
+
+        /* get the message with the selected item id, searching in both directions reads blocks of messages */
+        messages.seek(searchLine);
+        buf = messages.data();
         msg.setMsg(buf);
 
         /* decode the message if desired - could this call be avoided as the message is already decoded elsewhere ? */
@@ -466,7 +502,7 @@ void SearchDialog::findMessages(long int searchLine, long int searchBorder, QReg
         /* search header */
         if( text.isEmpty() )
         {
-            text += msg.toStringHeader();
+            text += msg.toStringHeader(timeFormatter);
             if ( msgIdEnabled==true )
             {
                 text += " "+QString().sprintf(msgIdFormat.toLatin1(),msg.getMessageId());
@@ -899,6 +935,20 @@ void SearchDialog::clearCacheHistory()
 {
     // obtaining the list of keys stored in cache
     cachedHistoryKey.clear();
+    // the history shares the lists with the cache, release them too
+    m_searchHistory.clear();
+}
+
+void SearchDialog::memoryUsage(QDltMemoryUsage &usage)
+{
+    if(m_searchtablemodel)
+        usage.add(QString("Search results"), QDltMemoryUsage::of(m_searchtablemodel->m_searchResultList));
+
+    // lists of the history are shared with the cache, count them once
+    qint64 bytes = QDltMemoryUsage::of(cachedHistoryKey) + QDltMemoryUsage::of(m_searchHistory);
+    for(int num = 0; num < m_searchHistory.size(); num++)
+        bytes += QDltMemoryUsage::of(m_searchHistory[num]);
+    usage.add(QString("Search history"), bytes);
 }
 
 void SearchDialog::on_checkBoxHeader_toggled(bool checked)
@@ -61,6 +61,7 @@ public:
     void appendLineEdit(QLineEdit *lineEdit);
     void cacheSearchHistory();
     void clearCacheHistory();
+    void memoryUsage(QDltMemoryUsage &usage);
     QString getText();
 
     void registerSearchTableModel(SearchTableModel *model);
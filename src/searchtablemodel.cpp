@@ -28,6 +28,7 @@ SearchTableModel::SearchTableModel(const QString &,QObject *parent) :
 {
     qfile = NULL;
     project = NULL;
+    regexSearchReplace = NULL;
     pluginManager = NULL;
 }
 
@@ -74,11 +75,12 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
             return QString("%L1").arg((m_searchResultList.at(index.row())));
         case FieldNames::Time:
             if( project->settings->automaticTimeSettings == 0 )
-               return QString("%1.%2").arg(msg.getGmTimeWithOffsetString(project->settings->utcOffset,project->settings->dst)).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
+               timeFormatter.setUtcOffset(project->settings->utcOffset,project->settings->dst);
             else
-               return QString("%1.%2").arg(msg.getTimeString()).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
+               timeFormatter.setLocalTime();
+            return timeFormatter.time(msg.getTime(),msg.getMicroseconds());
         case FieldNames::TimeStamp:
-            return QString("%1.%2").arg(msg.getTimestamp()/10000).arg(msg.getTimestamp()%10000,4,10,QLatin1Char('0'));
+            return QDltTimeFormatter::timestamp(msg.getTimestamp());
         case FieldNames::Counter:
             return QString("%1").arg(msg.getMessageCounter());
         case FieldNames::EcuId:
@@ -161,15 +163,9 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
         case FieldNames::Payload:
             /* display payload */
             visu_data = msg.toStringPayload().trimmed();
-            if((QDltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool()))
-            {
-                for(int num = 0; num < project->filter->topLevelItemCount (); num++) {
-                    FilterItem *item = (FilterItem*)project->filter->topLevelItem(num);
-                    if(item->checkState(0) == Qt::Checked && item->filter.enableRegexSearchReplace) {
-                        apply_regex_string(visu_data, item->filter.regex_search, item->filter.regex_replace);
-                    }
-                }
-            }
+            /* search and replace rules of the active filters */
+            if(regexSearchReplace)
+                regexSearchReplace->apply(visu_data, m_searchResultList.at(index.row()));
             return visu_data;
         case FieldNames::MessageId:
             return QString().sprintf(project->settings->msgIdFormat.toLatin1(),msg.getMessageId());
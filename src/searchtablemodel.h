@@ -24,6 +24,7 @@
 
 #include "project.h"
 #include "qdlt.h"
+#include "regex_search_replace.h"
 
 #define DLT_VIEWER_SEARCHCOLUMN_COUNT FieldNames::Arg0
 
@@ -57,6 +58,7 @@ public:
     QDltFile *qfile;
     Project *project;
     QDltPluginManager *pluginManager;
+    RegexSearchReplace *regexSearchReplace;
     
 signals:
     
@@ -65,6 +67,9 @@ public slots:
 
 public:
     QList <unsigned long> m_searchResultList;
+
+private:
+    mutable QDltTimeFormatter timeFormatter;
     
 };
 
@@ -244,6 +244,11 @@ void SettingsDialog::writeDlg()
     ui->groupBoxMaxFileSizeMB->setChecked(settings->splitlogfile?Qt::Checked:Qt::Unchecked);
     ui->lineEditMaxFileSizeMB->setText(QString("%1").arg(settings->fmaxFileSizeMB));
     ui->checkBoxAppendDateTime->setCheckState(settings->appendDateTime?Qt::Checked:Qt::Unchecked);
+    ui->groupBoxCaptureMemory->setChecked(settings->captureMemory);
+    ui->spinBoxCaptureMemoryMB->setValue(settings->captureMemoryMB);
+    ui->checkBoxCaptureSpill->setCheckState(settings->captureSpill?Qt::Checked:Qt::Unchecked);
+    ui->groupBoxMemoryBudget->setChecked(settings->memoryBudget);
+    ui->spinBoxMemoryBudgetMB->setValue(settings->memoryBudgetMB);
 
     /* table */
     ui->spinBoxSectionSize->setValue(settings->sectionSize);
@@ -421,6 +426,11 @@ void SettingsDialog::readDlg()
      }
 
     settings->appendDateTime = (ui->checkBoxAppendDateTime->checkState() == Qt::Checked);
+    settings->captureMemory = ui->groupBoxCaptureMemory->isChecked();
+    settings->captureMemoryMB = ui->spinBoxCaptureMemoryMB->value();
+    settings->captureSpill = (ui->checkBoxCaptureSpill->checkState() == Qt::Checked);
+    settings->memoryBudget = ui->groupBoxMemoryBudget->isChecked();
+    settings->memoryBudgetMB = ui->spinBoxMemoryBudgetMB->value();
 
     /* table */
     settings->sectionSize = ui->spinBoxSectionSize->value();
@@ -133,11 +133,14 @@ SOURCES += main.cpp \
     multiplecontextdialog.cpp \
     sortfilterproxymodel.cpp \
     tablemodel.cpp \
+    regex_search_replace.cpp \
     filtertreewidget.cpp \
     dltfileutils.cpp \
     dltfileindexer.cpp \
     dlttableview.cpp \
     dltexporter.cpp \
+    dltcolumnarwriter.cpp \
+    dltfilerotator.cpp \
     fieldnames.cpp \
     dltuiutils.cpp \
     workingdirectory.cpp \
@@ -149,6 +152,9 @@ SOURCES += main.cpp \
     dltmsgqueue.cpp \
     dltfileindexerthread.cpp \
     dltfileindexerdefaultfilterthread.cpp \
+    dltstatistics.cpp \
+    dltratepyramid.cpp \
+    dlttimelinewidget.cpp \
     mcudpsocket.cpp \
 
 # Show these headers in the project
@@ -171,6 +177,8 @@ HEADERS += mainwindow.h \
     dltfileindexer.h \
     dlttableview.h \
     dltexporter.h \
+    dltcolumnarwriter.h \
+    dltfilerotator.h \
     fieldnames.h \
     workingdirectory.h \
     dltuiutils.h \
@@ -182,6 +190,9 @@ HEADERS += mainwindow.h \
     dltmsgqueue.h \
     dltfileindexerthread.h \
     dltfileindexerdefaultfilterthread.h \
+    dltstatistics.h \
+    dltratepyramid.h \
+    dlttimelinewidget.h \
     mcudpsocket.h \
     regex_search_replace.h
 
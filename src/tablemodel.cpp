@@ -60,6 +60,7 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
      qfile = NULL;
      project = NULL;
      pluginManager = NULL;
+     regexSearchReplace = NULL;
      lastSearchIndex = -1;
      emptyForceFlag = false;
      loggingOnlyMode = false;
@@ -101,6 +102,8 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
          return QVariant();
      }
 
+     QDltProfilerSpan span("view", QStringLiteral("Table data"), QDltProfiler::SpanAggregate);
+
      filterposindex = qfile->getMsgFilterPos(index.row());
 
      if (role == Qt::DisplayRole)
@@ -145,6 +148,7 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
          }
 
          QString visu_data;
+         int foldCount;
          switch(index.column())
          {
          case FieldNames::Index:
@@ -152,11 +156,12 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
              return QString("%L1").arg(qfile->getMsgFilterPos(index.row()));
          case FieldNames::Time:
              if( project->settings->automaticTimeSettings == 0 )
-                return QString("%1.%2").arg(msg.getGmTimeWithOffsetString(project->settings->utcOffset,project->settings->dst)).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
+                timeFormatter.setUtcOffset(project->settings->utcOffset,project->settings->dst);
              else
-                return QString("%1.%2").arg(msg.getTimeString()).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
+                timeFormatter.setLocalTime();
+             return timeFormatter.time(msg.getTime(),msg.getMicroseconds());
          case FieldNames::TimeStamp:
-             return QString("%1.%2").arg(msg.getTimestamp()/10000).arg(msg.getTimestamp()%10000,4,10,QLatin1Char('0'));
+             return QDltTimeFormatter::timestamp(msg.getTimestamp());
          case FieldNames::Counter:
              return QString("%1").arg(msg.getMessageCounter());
          case FieldNames::EcuId:
@@ -249,16 +254,17 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
              /* display payload */
              visu_data = msg.toStringPayload().trimmed().replace('\n', ' ');
 
-             if((QDltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool()))
+             /* row stands for several repetitions of the message */
+             foldCount = qfile->getFoldCount(index.row());
+             if(foldCount > 1)
              {
-                 for(int num = 0; num < project->filter->topLevelItemCount (); num++) {
-                     FilterItem *item = (FilterItem*)project->filter->topLevelItem(num);
-                     if(item->checkState(0) == Qt::Checked && item->filter.enableRegexSearchReplace) {
-                         apply_regex_string(visu_data, item->filter.regex_search, item->filter.regex_replace);
-                     }
-                 }
+                 visu_data.prepend(getFoldText(index.row(), foldCount, msg, false) + " ");
              }
 
+             /* search and replace rules of the active filters */
+             if(regexSearchReplace)
+                 regexSearchReplace->apply(visu_data, filterposindex);
+
              return visu_data;
          case FieldNames::MessageId:
              return QString().sprintf(project->settings->msgIdFormat.toLatin1() ,msg.getMessageId());
@@ -280,6 +286,18 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
          }
      }
 
+     if ( role == Qt::ToolTipRole && index.column() == FieldNames::Payload && false == loggingOnlyMode )
+     {
+         int foldCount = qfile->getFoldCount(index.row());
+         if(foldCount > 1)
+         {
+             QDltMsg firstmsg;
+             if(qfile->getMsg(filterposindex, firstmsg))
+                 return getFoldText(index.row(), foldCount, firstmsg, true);
+         }
+         return QVariant();
+     }
+
      if ( role == Qt::ForegroundRole )
      {
          /* get message at current row */
@@ -509,3 +527,22 @@ QColor TableModel::getMsgBackgroundColor(QDltMsg &msg,int index,long int filterp
     /* default return white background color */
     return QColor(255,255,255); // this is the default background clor
 }
+
+QString TableModel::getFoldText(int row, int foldCount, QDltMsg &msg, bool longText) const
+{
+    /* time span from the first to the last repetition */
+    QDltMsg lastmsg;
+    double span = 0.0;
+    QVector<qint64> fold = qfile->getFold(row);
+    if(!fold.isEmpty() && qfile->getMsg(fold.last(), lastmsg))
+    {
+        qint64 first = (qint64) msg.getTime() * 1000000 + msg.getMicroseconds();
+        qint64 last = (qint64) lastmsg.getTime() * 1000000 + lastmsg.getMicroseconds();
+        span = qAbs(last - first) / 1000000.0;
+    }
+
+    if(longText)
+        return QString("%L1 repetitions of this message within %2 s, use \"Expand folded messages\" to show all of them").arg(foldCount).arg(span, 0, 'f', 3);
+
+    return QString("[%1x, %2 s]").arg(foldCount).arg(span, 0, 'f', 3);
+}
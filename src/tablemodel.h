@@ -28,6 +28,7 @@
 
 #include "project.h"
 #include "qdlt.h"
+#include "regex_search_replace.h"
 
 #define DLT_VIEWER_LIST_BUFFER_SIZE 100024
 #define DLT_VIEWER_COLUMN_COUNT FieldNames::Arg0
@@ -54,6 +55,7 @@ public:
     QDltFile *qfile;
     Project *project;
     QDltPluginManager *pluginManager;
+    RegexSearchReplace *regexSearchReplace;
     void modelChanged();
     int setMarker(long int lineindex, QColor hlcolor); //used in search functionality
     int setManualMarker(QList<unsigned long int> selectedMarkerRows, QColor hlcolor); //used in mainwindow
@@ -67,11 +69,13 @@ private:
     bool loggingOnlyMode;
 
     long int searchhit;
+    mutable QDltTimeFormatter timeFormatter;
     QColor searchBackgroundColor() const;
     QColor searchhit_higlightColor;
     QColor manualMarkerColor;
     QList<unsigned long int> selectedMarkerRows;
     QColor getMsgBackgroundColor(QDltMsg &msg,int index,long int filterposindex) const;
+    QString getFoldText(int row, int foldCount, QDltMsg &msg, bool longText) const;
 };
 
 class HtmlDelegate : public QStyledItemDelegate